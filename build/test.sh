@@ -36,8 +36,13 @@ if [ "$1" == "" ] || [ "$1" == "--core" ] || [ "$2" == "--core" ] || [ "$3" == "
   run_test_suite_and_append "basic-sim-core-basic-simulation" "../test_results/test_results_core.txt"
   run_test_suite_and_append "basic-sim-core-exp-util" "../test_results/test_results_core.txt"
   run_test_suite_and_append "basic-sim-core-log-update-helper" "../test_results/test_results_core.txt"
+  run_test_suite_and_append "basic-sim-core-async-log-writer" "../test_results/test_results_core.txt"
+  run_test_suite_and_append "basic-sim-core-log-output-sink" "../test_results/test_results_core.txt"
   run_test_suite_and_append "basic-sim-core-ptop" "../test_results/test_results_core.txt"
   run_test_suite_and_append "basic-sim-core-arbiter" "../test_results/test_results_core.txt"
+  run_test_suite_and_append "basic-sim-core-graph-partitioner" "../test_results/test_results_core.txt"
+  run_test_suite_and_append "basic-sim-core-running-statistics" "../test_results/test_results_core.txt"
+  run_test_suite_and_append "basic-sim-core-latency-sketch" "../test_results/test_results_core.txt"
   run_test_suite_and_append "basic-sim-core-ptop-tracking"  "../test_results/test_results_core.txt"
   cat ../test_results/test_results_core.txt
 fi
@@ -81,6 +86,10 @@ if [ "$1" == "" ] || [ "$1" == "--distributed" ] || [ "$2" == "--distributed" ]
   bash run_assist.sh "test_run_folders/side_by_side_distributed_2_core_nullmsg" 2 || exit 1
   python3 test_distributed_exactly_equal.py "test_run_folders/side_by_side" "test_run_folders/side_by_side_distributed_2_core_nullmsg" 2 || exit 1
 
+  # Per-system statistics of a 2 core partition
+  bash run_assist.sh "test_run_folders/line_distributed_2_core_statistics" 2 || exit 1
+  python3 test_distributed_statistics.py "test_run_folders/line_distributed_2_core_statistics" || exit 1
+
 fi
 
 # Tests to see if outside calling checks and checks for distributed validity are being hit
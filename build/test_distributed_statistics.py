@@ -0,0 +1,78 @@
+import sys
+
+
+def read_statistics(run_folder, system_id):
+
+    # distributed_statistics.csv
+    csv_statistics = []
+    with open("%s/logs_ns3/system_%d_distributed_statistics.csv" % (run_folder, system_id)) as f_in:
+        for line in f_in:
+            spl = line.strip().split(",")
+            if len(spl) != 2:
+                raise ValueError("System %d: invalid statistics line: %s" % (system_id, line.strip()))
+            csv_statistics.append((spl[0], int(spl[1])))
+
+    # distributed_statistics.txt must have the same statistics
+    with open("%s/logs_ns3/system_%d_distributed_statistics.txt" % (run_folder, system_id)) as f_in:
+        txt_lines = [line.strip() for line in f_in]
+    if len(txt_lines) != len(csv_statistics):
+        raise ValueError("System %d: text and CSV statistics do not have the same number of lines" % system_id)
+    for i in range(len(txt_lines)):
+        spl = txt_lines[i].split(":")
+        if spl[0] != csv_statistics[i][0] or int(spl[1].strip()) != csv_statistics[i][1]:
+            raise ValueError("System %d: text statistic %s does not match %s" % (system_id, txt_lines[i], csv_statistics[i]))
+
+    return csv_statistics
+
+
+def test_distributed_statistics(run_folder):
+
+    # Line 0 -- 1 -- 2 -- 3 of which nodes 0 and 1 are of system 0, and 2 and 3 of system 1,
+    # such that only link 1-2 (20 microseconds) is between the systems
+    expected_labels = [
+        "Nodes of this system",
+        "Links between systems",
+        "Links between systems of this system",
+        "Remote channels created",
+        "Lookahead (ns)",
+        "Lookahead of this system (ns)",
+        "Run wallclock time (ns)",
+        "Events executed",
+        "Remote packets sent",
+        "Remote packets received",
+    ]
+    expected_setup_values = [2, 1, 1, 1, 20000, 20000]
+
+    statistics = []
+    for system_id in range(2):
+        system_statistics = read_statistics(run_folder, system_id)
+        if [s[0] for s in system_statistics] != expected_labels:
+            raise ValueError("System %d: statistic labels do not match: %s" % (system_id, system_statistics))
+        values = [s[1] for s in system_statistics]
+        if values[:6] != expected_setup_values:
+            raise ValueError("System %d: statistics of the partition do not match: %s" % (system_id, values[:6]))
+        if values[6] <= 0 or values[7] <= 0:
+            raise ValueError("System %d: run wallclock time and events executed must be positive" % system_id)
+        statistics.append(dict(system_statistics))
+
+    # The pings from node 0 to node 3 (and their replies) cross link 1-2, and all of them arrive before the end
+    if statistics[0]["Remote packets sent"] <= 0 or statistics[1]["Remote packets sent"] <= 0:
+        raise ValueError("Remote packets must have been sent by both systems")
+    if statistics[0]["Remote packets sent"] != statistics[1]["Remote packets received"]:
+        raise ValueError("Remote packets sent by system 0 are not those received by system 1")
+    if statistics[1]["Remote packets sent"] != statistics[0]["Remote packets received"]:
+        raise ValueError("Remote packets sent by system 1 are not those received by system 0")
+
+
+def main():
+    args = sys.argv[1:]
+    if len(args) != 1:
+        print("Must supply exactly one argument")
+        print("Usage: python3 test_distributed_statistics.py [run_folder]")
+        exit(1)
+    else:
+        test_distributed_statistics(args[0])
+
+
+if __name__ == "__main__":
+    main()
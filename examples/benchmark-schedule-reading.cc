@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-ptop.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/tcp-flow-schedule-reader.h"
+
+using namespace ns3;
+
+/**
+ * Reference: parsing of a string into an int64 as it was before in-place parsing (using stoll).
+ */
+int64_t baseline_parse_int64(const std::string& str) {
+
+    // Parse using stoll -- rethrow argument to be a bit easier debuggable
+    std::string str_no_whitespace = trim(str);
+    int64_t val;
+    size_t i;
+    try {
+        val = std::stoll(str_no_whitespace, &i);
+    } catch (const std::invalid_argument&) {
+        throw std::invalid_argument("Could not convert to int64: " + str);
+    }
+
+    // No remainder
+    if (i != str_no_whitespace.size()) {
+        throw std::invalid_argument("Could not convert to int64: " + str);
+    }
+
+    return val;
+}
+
+/**
+ * Reference: parsing of a string into a positive int64 as it was before in-place parsing.
+ */
+int64_t baseline_parse_positive_int64(const std::string& str) {
+    int64_t val = baseline_parse_int64(str);
+    if (val < 0) {
+        throw std::invalid_argument(format_string("Negative int64 value not permitted: %" PRId64, val));
+    }
+    return val;
+}
+
+/**
+ * Reference: the TCP flow schedule reading as it was before in-place parsing
+ * (getline, split_string into a vector of strings, parsing each string using stoll,
+ * and all checks of each entry).
+ */
+std::vector<TcpFlowScheduleEntry> baseline_read_tcp_flow_schedule(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
+
+    // Schedule to put in the data
+    std::vector<TcpFlowScheduleEntry> schedule;
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("TCP flow schedule file %s does not exist.", filename.c_str()));
+    }
+
+    // Open file
+    std::string line;
+    std::ifstream schedule_file(filename);
+    NS_ABORT_MSG_IF(!schedule_file, format_string("TCP flow schedule file %s could not be opened.", filename.c_str()));
+
+    // Go over each line
+    size_t line_counter = 0;
+    int64_t prev_start_time_ns = 0;
+    while (getline(schedule_file, line)) {
+
+        // Split on ,
+        std::vector<std::string> comma_split = split_string(line, ",", 7);
+
+        // Fill entry
+        int64_t tcp_flow_id = baseline_parse_positive_int64(comma_split.at(0));
+        if (tcp_flow_id != (int64_t) line_counter) {
+            throw std::invalid_argument(format_string("TCP flow ID is not ascending by one each line (violation: %" PRId64 ")\n", tcp_flow_id));
+        }
+        int64_t from_node_id = baseline_parse_positive_int64(comma_split.at(1));
+        int64_t to_node_id = baseline_parse_positive_int64(comma_split.at(2));
+        int64_t size_byte = baseline_parse_positive_int64(comma_split.at(3));
+        int64_t start_time_ns = baseline_parse_positive_int64(comma_split.at(4));
+        std::string additional_parameters = comma_split.at(5);
+        std::string metadata = comma_split.at(6);
+
+        // Must be weakly ascending start time
+        if (prev_start_time_ns > start_time_ns) {
+            throw std::invalid_argument(format_string("Start time is not weakly ascending (on line with TCP flow ID: %" PRId64 ", violation: %" PRId64 ")\n", tcp_flow_id, start_time_ns));
+        }
+        prev_start_time_ns = start_time_ns;
+
+        // Check node IDs
+        if (from_node_id == to_node_id) {
+            throw std::invalid_argument(format_string("TCP flow to itself at node ID: %" PRId64 ".", to_node_id));
+        }
+
+        // Check endpoint validity
+        if (!topology->IsValidEndpoint(from_node_id)) {
+            throw std::invalid_argument(format_string("Invalid from-endpoint for a schedule entry based on topology: %d", from_node_id));
+        }
+        if (!topology->IsValidEndpoint(to_node_id)) {
+            throw std::invalid_argument(format_string("Invalid to-endpoint for a schedule entry based on topology: %d", to_node_id));
+        }
+
+        // Check start time
+        if (start_time_ns >= simulation_end_time_ns) {
+            throw std::invalid_argument(format_string(
+                    "TCP flow %" PRId64 " has invalid start time %" PRId64 " >= %" PRId64 ".",
+                    tcp_flow_id, start_time_ns, simulation_end_time_ns
+            ));
+        }
+
+        // Put into schedule
+        schedule.push_back(TcpFlowScheduleEntry(tcp_flow_id, from_node_id, to_node_id, size_byte, start_time_ns, additional_parameters, metadata));
+
+        // Next line
+        line_counter++;
+
+    }
+
+    // Close file
+    schedule_file.close();
+
+    return schedule;
+
+}
+
+int main(int argc, char *argv[]) {
+
+    // Number of TCP flows in the schedule
+    int64_t num_tcp_flows = 1000000;
+    if (argc > 1) {
+        num_tcp_flows = parse_geq_one_int64(argv[1]);
+    }
+
+    // Prepare run directory
+    mkdir_if_not_exists("example_programmable");
+    const std::string run_dir = "example_programmable/basic-sim-example-benchmark-schedule-reading";
+    mkdir_if_not_exists(run_dir);
+    remove_file_if_exists(run_dir + "/config_ns3.properties");
+    remove_file_if_exists(run_dir + "/topology.properties");
+    remove_file_if_exists(run_dir + "/tcp_flow_schedule.csv");
+
+    // Write config file
+    std::ofstream config_file;
+    config_file.open (run_dir + "/config_ns3.properties");
+    config_file << "simulation_end_time_ns=1000000000000" << std::endl;
+    config_file << "simulation_seed=123456789" << std::endl;
+    config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+    config_file.close();
+
+    // Write topology file (0 - 1)
+    std::ofstream topology_file;
+    topology_file.open (run_dir + "/topology.properties");
+    topology_file << "num_nodes=2" << std::endl;
+    topology_file << "num_undirected_edges=1" << std::endl;
+    topology_file << "switches=set(0,1)" << std::endl;
+    topology_file << "switches_which_are_tors=set(0,1)" << std::endl;
+    topology_file << "servers=set()" << std::endl;
+    topology_file << "undirected_edges=set(0-1)" << std::endl;
+    topology_file << "link_channel_delay_ns=10000" << std::endl;
+    topology_file << "link_net_device_data_rate_megabit_per_s=10" << std::endl;
+    topology_file << "link_net_device_queue=drop_tail(20p)" << std::endl;
+    topology_file << "link_net_device_receive_error_model=none" << std::endl;
+    topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+    topology_file.close();
+
+    // Write TCP flow schedule file, alternating direction
+    std::ofstream schedule_file;
+    schedule_file.open (run_dir + "/tcp_flow_schedule.csv");
+    for (int64_t i = 0; i < num_tcp_flows; i++) {
+        schedule_file << i << "," << (i % 2) << "," << ((i + 1) % 2) << ",100000," << (i * 1000) << ",," << std::endl;
+    }
+    schedule_file.close();
+
+    // Load basic simulation environment and topology
+    Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(run_dir);
+    Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+    basicSimulation->RegisterTimestamp("Prepare schedule of " + std::to_string(num_tcp_flows) + " TCP flows");
+
+    // Reference: getline, split_string and stoll (including all checks and creating the entries)
+    std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+    std::vector<TcpFlowScheduleEntry> baseline_schedule = baseline_read_tcp_flow_schedule(run_dir + "/tcp_flow_schedule.csv", topology, basicSimulation->GetSimulationEndTimeNs());
+    std::chrono::steady_clock::time_point t_reference = std::chrono::steady_clock::now();
+    basicSimulation->RegisterTimestamp("Read schedule using getline, split_string and stoll (reference)");
+
+    // In-place parsing (including all checks and creating the entries)
+    std::vector<TcpFlowScheduleEntry> schedule = read_tcp_flow_schedule(run_dir + "/tcp_flow_schedule.csv", topology, basicSimulation->GetSimulationEndTimeNs());
+    std::chrono::steady_clock::time_point t_in_place = std::chrono::steady_clock::now();
+    basicSimulation->RegisterTimestamp("Read schedule using read_tcp_flow_schedule (in-place parsing)");
+
+    // Results
+    if ((int64_t) schedule.size() != num_tcp_flows || baseline_schedule.size() != schedule.size()) {
+        throw std::runtime_error("Schedule was not read correctly.");
+    }
+    for (size_t i = 0; i < schedule.size(); i++) {
+        if (baseline_schedule[i].GetTcpFlowId() != schedule[i].GetTcpFlowId()
+            || baseline_schedule[i].GetFromNodeId() != schedule[i].GetFromNodeId()
+            || baseline_schedule[i].GetToNodeId() != schedule[i].GetToNodeId()
+            || baseline_schedule[i].GetSizeByte() != schedule[i].GetSizeByte()
+            || baseline_schedule[i].GetStartTimeNs() != schedule[i].GetStartTimeNs()
+            || baseline_schedule[i].GetAdditionalParameters() != schedule[i].GetAdditionalParameters()
+            || baseline_schedule[i].GetMetadata() != schedule[i].GetMetadata()) {
+            throw std::runtime_error(format_string("Schedule entry %zu differs from the reference.", i));
+        }
+    }
+    std::cout << "BENCHMARK SCHEDULE READING" << std::endl;
+    std::cout << "  > TCP flows:                        " << num_tcp_flows << std::endl;
+    printf("  > getline, split_string and stoll:  %.3f s\n", std::chrono::duration_cast<std::chrono::nanoseconds>(t_reference - t_start).count() / 1e9);
+    printf("  > read_tcp_flow_schedule:           %.3f s\n", std::chrono::duration_cast<std::chrono::nanoseconds>(t_in_place - t_reference).count() / 1e9);
+    std::cout << std::endl;
+
+    // Finalize
+    basicSimulation->Finalize();
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "tcp-flow-result-store.h"
+
+namespace ns3 {
+
+/**
+ * Convert the finished state into its representation in the flow logs.
+ *
+ * @param finished_state    Finished state
+ *
+ * @return String as in tcp_flows.csv (e.g., YES, NO_ONGOING)
+ */
+std::string TcpFlowResultStore::FinishedStateToString(FinishedState finished_state) {
+    switch (finished_state) {
+        case ONGOING:
+            return "NO_ONGOING";
+        case COMPLETED:
+            return "YES";
+        case CONN_FAIL:
+            return "NO_CONN_FAIL";
+        case BAD_CLOSE:
+            return "NO_BAD_CLOSE";
+        case ERR_CLOSE:
+            return "NO_ERR_CLOSE";
+        default:
+            throw std::invalid_argument(format_string("Invalid finished state: %d", (int) finished_state));
+    }
+}
+
+/**
+ * Add a slot for a newly started flow.
+ *
+ * @return Index of the slot
+ */
+size_t TcpFlowResultStore::Add() {
+    m_finished_state.push_back(ONGOING);
+    m_sent_byte.push_back(0);
+    m_completion_time_ns.push_back(-1);
+    return m_finished_state.size() - 1;
+}
+
+/**
+ * Record the result of a flow.
+ *
+ * @param idx                   Index of the slot
+ * @param finished_state        Finished state
+ * @param sent_byte             Amount of bytes sent (acknowledged)
+ * @param completion_time_ns    Completion time (ns), -1 if it did not finish
+ */
+void TcpFlowResultStore::Record(size_t idx, FinishedState finished_state, int64_t sent_byte, int64_t completion_time_ns) {
+    CheckIndex(idx);
+    m_finished_state[idx] = finished_state;
+    m_sent_byte[idx] = sent_byte;
+    m_completion_time_ns[idx] = completion_time_ns;
+}
+
+size_t TcpFlowResultStore::GetSize() const {
+    return m_finished_state.size();
+}
+
+TcpFlowResultStore::FinishedState TcpFlowResultStore::GetFinishedState(size_t idx) const {
+    CheckIndex(idx);
+    return (FinishedState) m_finished_state[idx];
+}
+
+int64_t TcpFlowResultStore::GetSentByte(size_t idx) const {
+    CheckIndex(idx);
+    return m_sent_byte[idx];
+}
+
+int64_t TcpFlowResultStore::GetCompletionTimeNs(size_t idx) const {
+    CheckIndex(idx);
+    return m_completion_time_ns[idx];
+}
+
+void TcpFlowResultStore::CheckIndex(size_t idx) const {
+    if (idx >= m_finished_state.size()) {
+        throw std::out_of_range(format_string("TCP flow result index %lu is out of range (size: %lu)", idx, m_finished_state.size()));
+    }
+}
+
+}
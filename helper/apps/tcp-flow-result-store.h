@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef TCP_FLOW_RESULT_STORE_H
+#define TCP_FLOW_RESULT_STORE_H
+
+#include <vector>
+#include <string>
+#include <cinttypes>
+#include <stdexcept>
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Results of the TCP flows stored as a struct-of-arrays: one slot per started flow,
+ * in order of flow start. A slot is ongoing until its result is recorded (at
+ * flow completion or failure, or at the end of the run if it never finished).
+ */
+class TcpFlowResultStore
+{
+public:
+    enum FinishedState : uint8_t {
+        ONGOING = 0,
+        COMPLETED = 1,
+        CONN_FAIL = 2,
+        BAD_CLOSE = 3,
+        ERR_CLOSE = 4
+    };
+    static std::string FinishedStateToString(FinishedState finished_state);
+
+    size_t Add();
+    void Record(size_t idx, FinishedState finished_state, int64_t sent_byte, int64_t completion_time_ns);
+    size_t GetSize() const;
+    FinishedState GetFinishedState(size_t idx) const;
+    int64_t GetSentByte(size_t idx) const;
+    int64_t GetCompletionTimeNs(size_t idx) const;
+
+private:
+    void CheckIndex(size_t idx) const;
+    std::vector<uint8_t> m_finished_state;
+    std::vector<int64_t> m_sent_byte;
+    std::vector<int64_t> m_completion_time_ns;
+};
+
+}
+
+#endif /* TCP_FLOW_RESULT_STORE_H */
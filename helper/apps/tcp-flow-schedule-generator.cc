@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "tcp-flow-schedule-generator.h"
+
+namespace ns3 {
+
+/**
+ * Read in a flow size distribution as empirical CDF. Each line is of the form
+ * "[flow size (byte)],[cumulative probability]", with the flow size strictly ascending
+ * and the cumulative probability weakly ascending, with the last one being 1.
+ *
+ * @param filename  File name of the flow size CDF
+ *
+ * @return Flow size CDF as list of (flow size in byte, cumulative probability)
+ */
+std::vector<std::pair<int64_t, double>> read_flow_size_cdf(const std::string& filename) {
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("Flow size CDF file %s does not exist.", filename.c_str()));
+    }
+
+    // Go over each line
+    std::vector<std::pair<int64_t, double>> cdf;
+    MappedFileLineReader cdf_file(filename);
+    const char* line_begin;
+    const char* line_end;
+    std::vector<std::pair<const char*, const char*>> comma_split;
+    while (cdf_file.NextLine(line_begin, line_end)) {
+        split_string_in_place(line_begin, line_end, ',', 2, comma_split);
+        int64_t size_byte = parse_positive_int64(comma_split[0].first, comma_split[0].second);
+        double probability = parse_double_between_zero_and_one(std::string(comma_split[1].first, comma_split[1].second));
+        if (size_byte < 1) {
+            throw std::invalid_argument(format_string("Flow size in CDF must be at least 1 byte (violation: %" PRId64 ")", size_byte));
+        }
+        if (!cdf.empty() && size_byte <= cdf.back().first) {
+            throw std::invalid_argument(format_string("Flow size in CDF is not strictly ascending (violation: %" PRId64 ")", size_byte));
+        }
+        if (!cdf.empty() && probability < cdf.back().second) {
+            throw std::invalid_argument(format_string("Cumulative probability in CDF is not weakly ascending (violation: %f)", probability));
+        }
+        cdf.push_back(std::make_pair(size_byte, probability));
+    }
+
+    // The distribution must be complete
+    if (cdf.empty()) {
+        throw std::invalid_argument(format_string("Flow size CDF file %s is empty.", filename.c_str()));
+    }
+    if (cdf.back().second != 1.0) {
+        throw std::invalid_argument(format_string("Last cumulative probability in CDF must be 1 (is: %f)", cdf.back().second));
+    }
+
+    return cdf;
+
+}
+
+/**
+ * Generate the flow schedule on the fly. Flows arrive according to a Poisson process
+ * over all endpoints combined, with the flow size drawn from the empirical CDF
+ * (linearly interpolated between its points). With the same seed, exactly the same
+ * schedule is generated.
+ *
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : all flows start less than this value
+ * @param arrival_rate_per_s        Flow arrival rate (flows/s)
+ * @param flow_size_cdf             Flow size distribution (see read_flow_size_cdf())
+ * @param pairing                   How the endpoints are paired:
+ *                                  "uniform" (any endpoint to any other endpoint) or
+ *                                  "permutation" (each endpoint to its own fixed other endpoint)
+ * @param seed                      Seed of the random number generator
+ * @param dump_filename             If not empty, the generated schedule is written to this file
+ *                                  (in the TCP flow schedule format)
+ */
+TcpFlowScheduleGenerator::TcpFlowScheduleGenerator(
+        Ptr<Topology> topology,
+        const int64_t simulation_end_time_ns,
+        double arrival_rate_per_s,
+        const std::vector<std::pair<int64_t, double>>& flow_size_cdf,
+        const std::string& pairing,
+        uint64_t seed,
+        const std::string& dump_filename
+) : m_rng(seed) {
+
+    // Parameters
+    m_simulation_end_time_ns = simulation_end_time_ns;
+    if (arrival_rate_per_s <= 0) {
+        throw std::invalid_argument(format_string("Flow arrival rate must be positive (is: %f)", arrival_rate_per_s));
+    }
+    m_arrival_rate_per_s = arrival_rate_per_s;
+    if (flow_size_cdf.empty()) {
+        throw std::invalid_argument("Flow size CDF cannot be empty");
+    }
+    for (const std::pair<int64_t, double>& p : flow_size_cdf) {
+        m_cdf_size_byte.push_back(p.first);
+        m_cdf_probability.push_back(p.second);
+    }
+
+    // Endpoints
+    for (int64_t endpoint : topology->GetEndpoints()) {
+        m_endpoints.push_back(endpoint);
+    }
+    if (m_endpoints.size() < 2) {
+        throw std::invalid_argument("Flow generation requires at least two endpoints");
+    }
+
+    // Pairing
+    if (pairing == "permutation") {
+
+        // Random cyclic permutation (Sattolo's algorithm), such that no endpoint is paired with itself
+        for (size_t i = 0; i < m_endpoints.size(); i++) {
+            m_permutation.push_back(i);
+        }
+        for (size_t i = m_endpoints.size() - 1; i > 0; i--) {
+            std::swap(m_permutation[i], m_permutation[NextIndex(i)]);
+        }
+
+    } else if (pairing != "uniform") {
+        throw std::invalid_argument(format_string("Unknown flow generation pairing: %s", pairing.c_str()));
+    }
+
+    // Dump the generated schedule
+    if (!dump_filename.empty()) {
+        m_dump_file.open(dump_filename);
+        if (!m_dump_file) {
+            throw std::runtime_error(format_string("Could not open generated TCP flow schedule file %s.", dump_filename.c_str()));
+        }
+    }
+
+    m_num_generated = 0;
+    m_prev_start_time_ns = 0;
+    GenerateAhead();
+}
+
+TcpFlowScheduleGenerator::~TcpFlowScheduleGenerator() {
+    if (m_dump_file.is_open()) {
+        m_dump_file.close();
+    }
+}
+
+/**
+ * Draw a uniform random number in [0, 1) (53 bits of precision).
+ *
+ * @return Uniform random number
+ */
+double TcpFlowScheduleGenerator::NextUniform() {
+    return (m_rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Draw a uniform random index.
+ *
+ * @param n     Number of indices (at least 1)
+ *
+ * @return Index in [0, n)
+ */
+size_t TcpFlowScheduleGenerator::NextIndex(size_t n) {
+    return std::min((size_t) (NextUniform() * n), n - 1);
+}
+
+/**
+ * Draw a flow size from the empirical CDF.
+ *
+ * @return Flow size (byte), at least 1
+ */
+int64_t TcpFlowScheduleGenerator::NextFlowSizeByte() {
+    double u = NextUniform();
+    size_t i = std::upper_bound(m_cdf_probability.begin(), m_cdf_probability.end(), u) - m_cdf_probability.begin();
+    if (i == 0) {
+        return m_cdf_size_byte[0];
+    }
+    if (i == m_cdf_probability.size()) { // Only possible if it does not end at 1
+        return m_cdf_size_byte.back();
+    }
+    double fraction = (u - m_cdf_probability[i - 1]) / (m_cdf_probability[i] - m_cdf_probability[i - 1]);
+    return std::max((int64_t) 1, (int64_t) std::llround(m_cdf_size_byte[i - 1] + fraction * (m_cdf_size_byte[i] - m_cdf_size_byte[i - 1])));
+}
+
+/**
+ * Generate the next entry (if it still starts before the simulation end) into the look-ahead entry.
+ */
+void TcpFlowScheduleGenerator::GenerateAhead() {
+    m_next.clear();
+
+    // Exponential inter-arrival time
+    double inter_arrival_s = -std::log(1.0 - NextUniform()) / m_arrival_rate_per_s;
+    double start_time_ns = m_prev_start_time_ns + inter_arrival_s * 1e9;
+    if (start_time_ns >= m_simulation_end_time_ns) {
+        return;
+    }
+
+    // Pair of endpoints
+    size_t from_idx = NextIndex(m_endpoints.size());
+    size_t to_idx;
+    if (m_permutation.empty()) {
+        to_idx = (from_idx + 1 + NextIndex(m_endpoints.size() - 1)) % m_endpoints.size();
+    } else {
+        to_idx = m_permutation[from_idx];
+    }
+
+    // Entry
+    m_next.push_back(TcpFlowScheduleEntry(
+            m_num_generated,
+            m_endpoints[from_idx],
+            m_endpoints[to_idx],
+            NextFlowSizeByte(),
+            std::min((int64_t) std::llround(start_time_ns), m_simulation_end_time_ns - 1),
+            "",
+            ""
+    ));
+    m_prev_start_time_ns = m_next.back().GetStartTimeNs();
+    m_num_generated++;
+
+    // Dump
+    if (m_dump_file.is_open()) {
+        TcpFlowScheduleEntry& entry = m_next.back();
+        m_dump_file << entry.GetTcpFlowId() << "," << entry.GetFromNodeId() << "," << entry.GetToNodeId() << ","
+                    << entry.GetSizeByte() << "," << entry.GetStartTimeNs() << ",,\n";
+    }
+
+}
+
+/**
+ * Check whether there are entries left to generate.
+ *
+ * @return True iff there is at least one entry left
+ */
+bool TcpFlowScheduleGenerator::HasNext() {
+    return !m_next.empty();
+}
+
+/**
+ * Start time of the next entry to be generated.
+ *
+ * @return Start time (ns) of the next entry
+ */
+int64_t TcpFlowScheduleGenerator::GetNextStartTimeNs() {
+    if (m_next.empty()) {
+        throw std::runtime_error("There is no next TCP flow schedule entry.");
+    }
+    return m_next.front().GetStartTimeNs();
+}
+
+/**
+ * Generate all the entries which start before the given time, and append them to the window.
+ *
+ * @param end_time_ns   Entries with a start time strictly less than this are generated
+ * @param window        Window to append the entries to
+ */
+void TcpFlowScheduleGenerator::ReadUntil(int64_t end_time_ns, std::vector<TcpFlowScheduleEntry>& window) {
+    while (!m_next.empty() && m_next.front().GetStartTimeNs() < end_time_ns) {
+        window.push_back(m_next.front());
+        GenerateAhead();
+    }
+}
+
+/**
+ * Number of entries that have been generated (including the look-ahead).
+ * Once HasNext() is false, this is the number of entries in the schedule.
+ *
+ * @return Number of entries generated
+ */
+int64_t TcpFlowScheduleGenerator::GetNumRead() {
+    return m_num_generated;
+}
+
+}
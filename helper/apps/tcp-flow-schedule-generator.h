@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef TCP_FLOW_SCHEDULE_GENERATOR_H
+#define TCP_FLOW_SCHEDULE_GENERATOR_H
+
+#include <fstream>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <cinttypes>
+#include "ns3/exp-util.h"
+#include "ns3/topology.h"
+#include "ns3/tcp-flow-schedule-reader.h"
+
+namespace ns3 {
+
+std::vector<std::pair<int64_t, double>> read_flow_size_cdf(const std::string& filename);
+
+class TcpFlowScheduleGenerator : public TcpFlowScheduleStream
+{
+public:
+    TcpFlowScheduleGenerator(
+            Ptr<Topology> topology,
+            const int64_t simulation_end_time_ns,
+            double arrival_rate_per_s,
+            const std::vector<std::pair<int64_t, double>>& flow_size_cdf,
+            const std::string& pairing,
+            uint64_t seed,
+            const std::string& dump_filename
+    );
+    ~TcpFlowScheduleGenerator();
+    bool HasNext();
+    int64_t GetNextStartTimeNs();
+    void ReadUntil(int64_t end_time_ns, std::vector<TcpFlowScheduleEntry>& window);
+    int64_t GetNumRead();
+private:
+    double NextUniform();
+    size_t NextIndex(size_t n);
+    int64_t NextFlowSizeByte();
+    void GenerateAhead();
+    int64_t m_simulation_end_time_ns;
+    double m_arrival_rate_per_s;
+    std::vector<int64_t> m_cdf_size_byte;
+    std::vector<double> m_cdf_probability;
+    std::vector<int64_t> m_endpoints;
+    std::vector<size_t> m_permutation; // Partner endpoint index (only used for permutation pairing)
+    std::mt19937_64 m_rng;
+    std::ofstream m_dump_file; // Only open if the generated schedule is dumped
+    int64_t m_num_generated;
+    int64_t m_prev_start_time_ns;
+    std::vector<TcpFlowScheduleEntry> m_next; // Look-ahead entry (empty if there is none)
+};
+
+}
+
+#endif //TCP_FLOW_SCHEDULE_GENERATOR_H
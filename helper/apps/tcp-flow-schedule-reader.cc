@@ -67,6 +67,73 @@ std::string TcpFlowScheduleEntry::GetMetadata() {
     return m_metadata;
 }
 
+/**
+ * Parse and validate one line of the TCP flow schedule.
+ *
+ * @param line_begin                Start of the line
+ * @param line_end                  End of the line (exclusive)
+ * @param comma_split               Re-used storage for the split of the line
+ * @param expected_tcp_flow_id      TCP flow ID this line must have (ascending by one each line)
+ * @param prev_start_time_ns        Start time of the previous line (start time must be weakly ascending)
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : all flows must start less than this value
+ *
+ * @return Schedule entry
+ */
+TcpFlowScheduleEntry parse_tcp_flow_schedule_line(
+        const char* line_begin,
+        const char* line_end,
+        std::vector<std::pair<const char*, const char*>>& comma_split,
+        int64_t expected_tcp_flow_id,
+        int64_t prev_start_time_ns,
+        Ptr<Topology> topology,
+        const int64_t simulation_end_time_ns
+) {
+
+    // Split on ,
+    split_string_in_place(line_begin, line_end, ',', 7, comma_split);
+
+    // Fill entry
+    int64_t tcp_flow_id = parse_positive_int64(comma_split[0].first, comma_split[0].second);
+    if (tcp_flow_id != expected_tcp_flow_id) {
+        throw std::invalid_argument(format_string("TCP flow ID is not ascending by one each line (violation: %" PRId64 ")\n", tcp_flow_id));
+    }
+    int64_t from_node_id = parse_positive_int64(comma_split[1].first, comma_split[1].second);
+    int64_t to_node_id = parse_positive_int64(comma_split[2].first, comma_split[2].second);
+    int64_t size_byte = parse_positive_int64(comma_split[3].first, comma_split[3].second);
+    int64_t start_time_ns = parse_positive_int64(comma_split[4].first, comma_split[4].second);
+    std::string additional_parameters(comma_split[5].first, comma_split[5].second);
+    std::string metadata(comma_split[6].first, comma_split[6].second);
+
+    // Must be weakly ascending start time
+    if (prev_start_time_ns > start_time_ns) {
+        throw std::invalid_argument(format_string("Start time is not weakly ascending (on line with TCP flow ID: %" PRId64 ", violation: %" PRId64 ")\n", tcp_flow_id, start_time_ns));
+    }
+
+    // Check node IDs
+    if (from_node_id == to_node_id) {
+        throw std::invalid_argument(format_string("TCP flow to itself at node ID: %" PRId64 ".", to_node_id));
+    }
+
+    // Check endpoint validity
+    if (!topology->IsValidEndpoint(from_node_id)) {
+        throw std::invalid_argument(format_string("Invalid from-endpoint for a schedule entry based on topology: %d", from_node_id));
+    }
+    if (!topology->IsValidEndpoint(to_node_id)) {
+        throw std::invalid_argument(format_string("Invalid to-endpoint for a schedule entry based on topology: %d", to_node_id));
+    }
+
+    // Check start time
+    if (start_time_ns >= simulation_end_time_ns) {
+        throw std::invalid_argument(format_string(
+                "TCP flow %" PRId64 " has invalid start time %" PRId64 " >= %" PRId64 ".",
+                tcp_flow_id, start_time_ns, simulation_end_time_ns
+        ));
+    }
+
+    return TcpFlowScheduleEntry(tcp_flow_id, from_node_id, to_node_id, size_byte, start_time_ns, additional_parameters, metadata);
+}
+
 /**
  * Read in the flow schedule.
  *
@@ -84,71 +151,145 @@ std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(const std::string& file
         throw std::runtime_error(format_string("TCP flow schedule file %s does not exist.", filename.c_str()));
     }
 
-    // Open file
-    std::string line;
-    std::ifstream schedule_file(filename);
-    NS_ABORT_MSG_IF(!schedule_file, format_string("TCP flow schedule file %s could not be opened.", filename.c_str()));
+    // Open file (mapped into memory, lines and fields are scanned in place)
+    MappedFileLineReader schedule_file(filename);
+    const char* line_begin;
+    const char* line_end;
+    std::vector<std::pair<const char*, const char*>> comma_split;
 
     // Go over each line
-    size_t line_counter = 0;
     int64_t prev_start_time_ns = 0;
-    while (getline(schedule_file, line)) {
-
-        // Split on ,
-        std::vector<std::string> comma_split = split_string(line, ",", 7);
-
-        // Fill entry
-        int64_t tcp_flow_id = parse_positive_int64(comma_split.at(0));
-        if (tcp_flow_id != (int64_t) line_counter) {
-            throw std::invalid_argument(format_string("TCP flow ID is not ascending by one each line (violation: %" PRId64 ")\n", tcp_flow_id));
-        }
-        int64_t from_node_id = parse_positive_int64(comma_split.at(1));
-        int64_t to_node_id = parse_positive_int64(comma_split.at(2));
-        int64_t size_byte = parse_positive_int64(comma_split.at(3));
-        int64_t start_time_ns = parse_positive_int64(comma_split.at(4));
-        std::string additional_parameters = comma_split.at(5);
-        std::string metadata = comma_split.at(6);
-
-        // Must be weakly ascending start time
-        if (prev_start_time_ns > start_time_ns) {
-            throw std::invalid_argument(format_string("Start time is not weakly ascending (on line with TCP flow ID: %" PRId64 ", violation: %" PRId64 ")\n", tcp_flow_id, start_time_ns));
-        }
-        prev_start_time_ns = start_time_ns;
-
-        // Check node IDs
-        if (from_node_id == to_node_id) {
-            throw std::invalid_argument(format_string("TCP flow to itself at node ID: %" PRId64 ".", to_node_id));
-        }
-
-        // Check endpoint validity
-        if (!topology->IsValidEndpoint(from_node_id)) {
-            throw std::invalid_argument(format_string("Invalid from-endpoint for a schedule entry based on topology: %d", from_node_id));
-        }
-        if (!topology->IsValidEndpoint(to_node_id)) {
-            throw std::invalid_argument(format_string("Invalid to-endpoint for a schedule entry based on topology: %d", to_node_id));
-        }
-
-        // Check start time
-        if (start_time_ns >= simulation_end_time_ns) {
-            throw std::invalid_argument(format_string(
-                    "TCP flow %" PRId64 " has invalid start time %" PRId64 " >= %" PRId64 ".",
-                    tcp_flow_id, start_time_ns, simulation_end_time_ns
-            ));
-        }
-
-        // Put into schedule
-        schedule.push_back(TcpFlowScheduleEntry(tcp_flow_id, from_node_id, to_node_id, size_byte, start_time_ns, additional_parameters, metadata));
-
-        // Next line
-        line_counter++;
+    while (schedule_file.NextLine(line_begin, line_end)) {
+        schedule.push_back(parse_tcp_flow_schedule_line(
+                line_begin, line_end, comma_split, schedule.size(), prev_start_time_ns, topology, simulation_end_time_ns
+        ));
+        prev_start_time_ns = schedule.back().GetStartTimeNs();
+    }
+
+    return schedule;
+
+}
 
+/**
+ * Validate each line of the flow schedule without keeping the entries in memory.
+ * This allows a streamed schedule to be rejected at setup rather than once the
+ * window of an invalid line is read.
+ *
+ * @param filename                  File name of the schedule.csv
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : all flows must start less than this value
+ *
+ * @return Number of TCP flows in the schedule
+ */
+int64_t validate_tcp_flow_schedule(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("TCP flow schedule file %s does not exist.", filename.c_str()));
     }
 
-    // Close file
-    schedule_file.close();
+    // Open file (mapped into memory, lines and fields are scanned in place)
+    MappedFileLineReader schedule_file(filename);
+    const char* line_begin;
+    const char* line_end;
+    std::vector<std::pair<const char*, const char*>> comma_split;
 
-    return schedule;
+    // Go over each line
+    int64_t num_tcp_flows = 0;
+    int64_t prev_start_time_ns = 0;
+    while (schedule_file.NextLine(line_begin, line_end)) {
+        prev_start_time_ns = parse_tcp_flow_schedule_line(
+                line_begin, line_end, comma_split, num_tcp_flows, prev_start_time_ns, topology, simulation_end_time_ns
+        ).GetStartTimeNs();
+        num_tcp_flows++;
+    }
 
+    return num_tcp_flows;
+
+}
+
+/**
+ * Stream the flow schedule from the file. The same validation is performed on each line
+ * as read_tcp_flow_schedule(), but only when it is read (use validate_tcp_flow_schedule()
+ * beforehand to detect invalid lines at once).
+ *
+ * @param filename                  File name of the schedule.csv
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : all flows must start less than this value
+ */
+TcpFlowScheduleStreamReader::TcpFlowScheduleStreamReader(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("TCP flow schedule file %s does not exist.", filename.c_str()));
+    }
+
+    m_schedule_file = std::unique_ptr<MappedFileLineReader>(new MappedFileLineReader(filename));
+    m_topology = topology;
+    m_simulation_end_time_ns = simulation_end_time_ns;
+    m_num_read = 0;
+    m_prev_start_time_ns = 0;
+    ReadAhead();
+}
+
+/**
+ * Parse the next line (if there is one) into the look-ahead entry.
+ */
+void TcpFlowScheduleStreamReader::ReadAhead() {
+    m_next.clear();
+    const char* line_begin;
+    const char* line_end;
+    if (m_schedule_file->NextLine(line_begin, line_end)) {
+        m_next.push_back(parse_tcp_flow_schedule_line(
+                line_begin, line_end, m_comma_split, m_num_read, m_prev_start_time_ns, m_topology, m_simulation_end_time_ns
+        ));
+        m_prev_start_time_ns = m_next.back().GetStartTimeNs();
+        m_num_read++;
+    }
+}
+
+/**
+ * Check whether there are entries left to read.
+ *
+ * @return True iff there is at least one entry left
+ */
+bool TcpFlowScheduleStreamReader::HasNext() {
+    return !m_next.empty();
+}
+
+/**
+ * Start time of the next entry to be read.
+ *
+ * @return Start time (ns) of the next entry
+ */
+int64_t TcpFlowScheduleStreamReader::GetNextStartTimeNs() {
+    if (m_next.empty()) {
+        throw std::runtime_error("There is no next TCP flow schedule entry.");
+    }
+    return m_next.front().GetStartTimeNs();
+}
+
+/**
+ * Read all the entries which start before the given time, and append them to the window.
+ *
+ * @param end_time_ns   Entries with a start time strictly less than this are read
+ * @param window        Window to append the entries to
+ */
+void TcpFlowScheduleStreamReader::ReadUntil(int64_t end_time_ns, std::vector<TcpFlowScheduleEntry>& window) {
+    while (!m_next.empty() && m_next.front().GetStartTimeNs() < end_time_ns) {
+        window.push_back(m_next.front());
+        ReadAhead();
+    }
+}
+
+/**
+ * Number of lines that have been read (including the look-ahead).
+ * Once HasNext() is false, this is the number of entries in the schedule.
+ *
+ * @return Number of lines read
+ */
+int64_t TcpFlowScheduleStreamReader::GetNumRead() {
+    return m_num_read;
 }
 
 }
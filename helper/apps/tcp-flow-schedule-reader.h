@@ -62,6 +62,41 @@ std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(
         const int64_t simulation_end_time_ns
 );
 
+int64_t validate_tcp_flow_schedule(
+        const std::string& filename,
+        Ptr<Topology> topology,
+        const int64_t simulation_end_time_ns
+);
+
+class TcpFlowScheduleStream : public SimpleRefCount<TcpFlowScheduleStream>
+{
+public:
+    virtual ~TcpFlowScheduleStream() {};
+    virtual bool HasNext() = 0;
+    virtual int64_t GetNextStartTimeNs() = 0;
+    virtual void ReadUntil(int64_t end_time_ns, std::vector<TcpFlowScheduleEntry>& window) = 0;
+    virtual int64_t GetNumRead() = 0;
+};
+
+class TcpFlowScheduleStreamReader : public TcpFlowScheduleStream
+{
+public:
+    TcpFlowScheduleStreamReader(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns);
+    bool HasNext();
+    int64_t GetNextStartTimeNs();
+    void ReadUntil(int64_t end_time_ns, std::vector<TcpFlowScheduleEntry>& window);
+    int64_t GetNumRead();
+private:
+    void ReadAhead();
+    std::unique_ptr<MappedFileLineReader> m_schedule_file;
+    Ptr<Topology> m_topology;
+    int64_t m_simulation_end_time_ns;
+    int64_t m_num_read;
+    int64_t m_prev_start_time_ns;
+    std::vector<std::pair<const char*, const char*>> m_comma_split;
+    std::vector<TcpFlowScheduleEntry> m_next; // Look-ahead entry (empty if there is none)
+};
+
 }
 
 #endif //TCP_FLOW_SCHEDULE_READER_H
@@ -24,42 +24,224 @@
 namespace ns3 {
 
 const uint16_t TcpFlowScheduler::DEFAULT_SERVER_PORT = 1024;
+const int64_t TcpFlowScheduler::DEFAULT_GENERATOR_STREAMING_WINDOW_NS = 1000000; // 1 ms
 
-void TcpFlowScheduler::StartNextFlow(int i) {
+/**
+ * Start all flows of the schedule from index i onward which start right now,
+ * and keep the start events ahead in the event queue.
+ *
+ * @param i     Index of the first flow which starts now
+ */
+void TcpFlowScheduler::StartNextFlows(int i) {
+    int64_t now_ns = Simulator::Now().GetNanoSeconds();
+    NS_ASSERT(now_ns == m_schedule.at(i).GetStartTimeNs());
+
+    // Start all flows with this start time in a single pass
+    size_t j = i;
+    while (j < m_schedule.size() && m_schedule.at(j).GetStartTimeNs() == now_ns) {
+        StartFlow(m_schedule.at(j));
+        j++;
+    }
+    m_num_pending_start_events -= 1;
+
+    // If streaming and the window is exhausted (then no start events are pending), pull in the next one
+    if (j == m_schedule.size() && m_schedule_stream != 0) {
+        LoadNextScheduleWindow(m_schedule_stream);
+        m_next_start_event_idx = 0;
+        if (m_schedule.size() == 0) {
+            CheckLoggingTcpFlowIds(m_schedule_stream->GetNumRead());
+        }
+    }
+
+    // Keep the start events ahead
+    ScheduleStartEvents();
 
-    // Fetch the flow to start
-    TcpFlowScheduleEntry& entry = m_schedule.at(i);
+}
+
+/**
+ * Schedule the start events of the upcoming start times, such that (at most) the look-ahead
+ * number of start events is pending. Each start event starts all flows with that start time.
+ */
+void TcpFlowScheduler::ScheduleStartEvents() {
     int64_t now_ns = Simulator::Now().GetNanoSeconds();
-    NS_ASSERT(now_ns == entry.GetStartTimeNs());
-
-    // Helper to install the source application
-    TcpFlowClientHelper source(
-            InetSocketAddress(m_nodes.Get(entry.GetFromNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 0), // Port 0 means an ephemeral port will be assigned
-            InetSocketAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), DEFAULT_SERVER_PORT), // Port will be overwritten later by the SetRemotePort call
-            entry.GetTcpFlowId(),
-            entry.GetSizeByte(),
-            entry.GetAdditionalParameters(),
-            m_enable_logging_for_tcp_flow_ids.find(entry.GetTcpFlowId()) != m_enable_logging_for_tcp_flow_ids.end(),
-            m_basicSimulation->GetLogsDir()
-    );
-
-    // Install it on the node and start it right now
-    ApplicationContainer app = source.Install(m_nodes.Get(entry.GetFromNodeId()));
-    app.Start(NanoSeconds(0));
-    Ptr<TcpFlowClient> tcpFlowClient = app.Get(0)->GetObject<TcpFlowClient>();
-    tcpFlowClient->SetTcpSocketGenerator(m_tcpSocketGenerator);
+    while (m_num_pending_start_events < m_start_lookahead_events && m_next_start_event_idx < m_schedule.size()) {
+        int64_t start_time_ns = m_schedule.at(m_next_start_event_idx).GetStartTimeNs();
+        Simulator::Schedule(NanoSeconds(start_time_ns - now_ns), &TcpFlowScheduler::StartNextFlows, this, (int) m_next_start_event_idx);
+        m_num_pending_start_events += 1;
+        while (m_next_start_event_idx < m_schedule.size() && m_schedule.at(m_next_start_event_idx).GetStartTimeNs() == start_time_ns) {
+            m_next_start_event_idx += 1;
+        }
+    }
+}
+
+/**
+ * Start a flow right now.
+ *
+ * @param entry     Schedule entry of the flow
+ */
+void TcpFlowScheduler::StartFlow(TcpFlowScheduleEntry& entry) {
+
+    // A client without detailed logging can be recycled from the idle clients of the node
+    bool enable_detailed_logging = IsDetailedLoggingEnabled(entry.GetTcpFlowId());
+    bool recycle = m_enable_client_recycling && !enable_detailed_logging;
+    InetSocketAddress remoteAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), DEFAULT_SERVER_PORT); // Port will be overwritten later by the SetRemotePort call
+    Ptr<TcpFlowClient> tcpFlowClient;
+    if (recycle && !m_idle_clients.at(entry.GetFromNodeId()).empty()) {
+        tcpFlowClient = m_idle_clients.at(entry.GetFromNodeId()).back();
+        m_idle_clients.at(entry.GetFromNodeId()).pop_back();
+        tcpFlowClient->Recycle(remoteAddress, entry.GetTcpFlowId(), entry.GetSizeByte(), entry.GetAdditionalParameters());
+
+    } else {
+
+        // Helper to install the source application
+        TcpFlowClientHelper source(
+                InetSocketAddress(m_nodes.Get(entry.GetFromNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 0), // Port 0 means an ephemeral port will be assigned
+                remoteAddress,
+                entry.GetTcpFlowId(),
+                entry.GetSizeByte(),
+                entry.GetAdditionalParameters(),
+                enable_detailed_logging,
+                m_basicSimulation->GetLogsDir()
+        );
+
+        // Install it on the node and start it right now
+        ApplicationContainer app = source.Install(m_nodes.Get(entry.GetFromNodeId()));
+        app.Start(NanoSeconds(0));
+        tcpFlowClient = app.Get(0)->GetObject<TcpFlowClient>();
+        tcpFlowClient->SetTcpSocketGenerator(m_tcpSocketGenerator);
+        tcpFlowClient->SetAttribute("LogOutputFormat", StringValue(m_log_output_format));
+        tcpFlowClient->SetDetailedLogWriter(m_detailed_log_writer);
+        tcpFlowClient->SetFlowFinishedCallback(MakeCallback(&TcpFlowScheduler::FlowFinished, this));
+        if (enable_detailed_logging) {
+            m_detailed_logging_clients.push_back(tcpFlowClient);
+        }
+
+    }
     uint16_t remotePort = m_clientRemotePortSelector->SelectRemotePort(TcpFlowClient::GetTypeId(), tcpFlowClient);
     NS_ABORT_MSG_IF(m_serverPorts.find(remotePort) == m_serverPorts.end(), "Selected remote port " + std::to_string(remotePort) + " is not among the server ports");
     tcpFlowClient->SetRemotePort(remotePort);
     tcpFlowClient->SetIpTos(m_ipTosGenerator->GenerateIpTos(TcpFlowClient::GetTypeId(), tcpFlowClient));
-    m_apps.push_back(app);
 
-    // If there is a next flow to start, schedule its start
-    if (i + 1 != (int) m_schedule.size()) {
-        int64_t next_flow_ns = m_schedule.at(i + 1).GetStartTimeNs();
-        Simulator::Schedule(NanoSeconds(next_flow_ns - now_ns), &TcpFlowScheduler::StartNextFlow, this, i + 1);
+    // The client is only referenced until its result is recorded
+    m_active_flows[entry.GetTcpFlowId()] = std::make_pair(m_flow_results.Add(), tcpFlowClient);
+
+}
+
+/**
+ * Replace the schedule by the next window of flows from the stream: all flows starting within
+ * the streaming window duration of the first next flow (which start at a node of this system).
+ * The schedule is empty afterwards only if the stream is exhausted.
+ *
+ * @param reader    Schedule stream (reader or generator)
+ */
+void TcpFlowScheduler::LoadNextScheduleWindow(Ptr<TcpFlowScheduleStream> reader) {
+    m_schedule.clear();
+    while (m_schedule.size() == 0 && reader->HasNext()) {
+        reader->ReadUntil(reader->GetNextStartTimeNs() + m_streaming_window_ns, m_schedule);
+        if (m_enable_distributed) {
+            std::vector<TcpFlowScheduleEntry> filtered_schedule;
+            for (TcpFlowScheduleEntry &entry : m_schedule) {
+                if (m_basicSimulation->IsNodeAssignedToThisSystem(entry.GetFromNodeId())) {
+                    filtered_schedule.push_back(entry);
+                }
+            }
+            m_schedule.swap(filtered_schedule);
+        }
+    }
+}
+
+/**
+ * Create a stream of the schedule from the start: either read from the schedule file,
+ * or generated (with the same seed, so it is the same schedule each time).
+ *
+ * @param first     True iff this is the first stream of the run (only then the generated schedule is dumped)
+ *
+ * @return Schedule stream
+ */
+Ptr<TcpFlowScheduleStream> TcpFlowScheduler::CreateScheduleStream(bool first) {
+    if (m_schedule_generator == "none") {
+        return Create<TcpFlowScheduleStreamReader>(m_schedule_filename, m_topology, m_simulation_end_time_ns);
+    } else {
+
+        // Each system generates the same schedule, as such only the first dumps it
+        std::string dump_filename = "";
+        if (first && m_generator_dump_schedule && (!m_enable_distributed || m_basicSimulation->GetSystemId() == 0)) {
+            dump_filename = m_basicSimulation->GetLogsDir() + "/tcp_flow_schedule_generated.csv";
+        }
+
+        return Create<TcpFlowScheduleGenerator>(
+                m_topology,
+                m_simulation_end_time_ns,
+                m_generator_arrival_rate_per_s,
+                m_generator_flow_size_cdf,
+                m_generator_pairing,
+                (uint64_t) m_generator_seed,
+                dump_filename
+        );
+
+    }
+}
+
+/**
+ * Check that the TCP flow IDs for which logging is enabled exist.
+ *
+ * @param num_tcp_flows     Number of TCP flows in the schedule
+ */
+void TcpFlowScheduler::CheckLoggingTcpFlowIds(int64_t num_tcp_flows) {
+    for (int64_t tcp_flow_id : m_enable_logging_for_tcp_flow_ids) {
+        if (tcp_flow_id >= num_tcp_flows) {
+            throw std::invalid_argument("Invalid TCP flow ID in tcp_flow_enable_logging_for_tcp_flow_ids: " + std::to_string(tcp_flow_id));
+        }
+    }
+}
+
+/**
+ * Check whether detailed logging is enabled for a TCP flow.
+ *
+ * @param tcp_flow_id   TCP flow ID
+ *
+ * @return True iff detailed logging is enabled
+ */
+bool TcpFlowScheduler::IsDetailedLoggingEnabled(int64_t tcp_flow_id) {
+    return m_enable_logging_for_all_tcp_flow_ids || m_enable_logging_for_tcp_flow_ids.find(tcp_flow_id) != m_enable_logging_for_tcp_flow_ids.end();
+}
+
+/**
+ * Called when the flow of a client has finished (completed or failed): its result is
+ * recorded, and if recycling, the client is put back into the idle clients of its node.
+ *
+ * @param client    TCP flow client
+ */
+void TcpFlowScheduler::FlowFinished(Ptr<TcpFlowClient> client) {
+    std::map<int64_t, std::pair<size_t, Ptr<TcpFlowClient>>>::iterator it = m_active_flows.find(client->GetTcpFlowId());
+    NS_ABORT_MSG_IF(it == m_active_flows.end(), "Finished TCP flow is not active");
+    RecordFlowResult(it->second.first, client);
+    m_active_flows.erase(it);
+    if (m_enable_client_recycling && !IsDetailedLoggingEnabled(client->GetTcpFlowId())) {
+        m_idle_clients.at(client->GetNode()->GetId()).push_back(client);
     }
+}
 
+/**
+ * Record the statistics of the client into the result store.
+ *
+ * @param result_idx    Index in the result store
+ * @param client        TCP flow client
+ */
+void TcpFlowScheduler::RecordFlowResult(size_t result_idx, Ptr<TcpFlowClient> client) {
+    TcpFlowResultStore::FinishedState finished_state;
+    if (client->IsCompleted()) {
+        finished_state = TcpFlowResultStore::COMPLETED;
+    } else if (client->IsConnFailed()) {
+        finished_state = TcpFlowResultStore::CONN_FAIL;
+    } else if (client->IsClosedNormally()) {
+        finished_state = TcpFlowResultStore::BAD_CLOSE;
+    } else if (client->IsClosedByError()) {
+        finished_state = TcpFlowResultStore::ERR_CLOSE;
+    } else {
+        finished_state = TcpFlowResultStore::ONGOING;
+    }
+    m_flow_results.Record(result_idx, finished_state, client->GetAckedBytes(), client->GetCompletionTimeNs());
 }
 
 TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) : TcpFlowScheduler(
@@ -96,45 +278,102 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
         m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
 
-        // Read schedule
-        std::vector<TcpFlowScheduleEntry> complete_schedule = read_tcp_flow_schedule(
-                m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("tcp_flow_schedule_filename"),
-                m_topology,
-                m_simulation_end_time_ns
-        );
+        // Streaming: instead of reading in the complete schedule, only a window of upcoming flow starts is read at a time
+        m_streaming_window_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_schedule_streaming_window_ns", "0"));
 
-        // Enable logging for TCP flow IDs
-        std::string enable_for_tcp_flows_ids_str = basicSimulation->GetConfigParamOrDefault("tcp_flow_enable_logging_for_tcp_flow_ids", "set()");
-        if (enable_for_tcp_flows_ids_str == "all") {
-            for (size_t tcp_flow_id = 0; tcp_flow_id < complete_schedule.size(); tcp_flow_id++) {
-                m_enable_logging_for_tcp_flow_ids.insert(tcp_flow_id);
+        // The schedule is either read from file, or generated on the fly
+        m_schedule_generator = m_basicSimulation->GetConfigParamOrDefault("tcp_flow_schedule_generator", "none");
+        if (m_schedule_generator == "none") {
+
+            // Schedule filename
+            m_schedule_filename = m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("tcp_flow_schedule_filename");
+
+        } else if (m_schedule_generator == "poisson") {
+
+            // Poisson arrivals with flow sizes from an empirical CDF
+            m_generator_arrival_rate_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("tcp_flow_generator_arrival_rate_per_s"));
+            m_generator_flow_size_cdf = read_flow_size_cdf(m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("tcp_flow_generator_flow_size_cdf_filename"));
+            m_generator_pairing = m_basicSimulation->GetConfigParamOrDefault("tcp_flow_generator_pairing", "uniform");
+            m_generator_seed = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_generator_seed", m_basicSimulation->GetConfigParamOrFail("simulation_seed")));
+            m_generator_dump_schedule = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_generator_dump_schedule", "false"));
+            std::cout << "  > Schedule is generated (Poisson arrivals at " << m_generator_arrival_rate_per_s << " flows/s, " << m_generator_pairing << " pairing)" << std::endl;
+
+            // A generated schedule is always streamed
+            if (m_streaming_window_ns == 0) {
+                m_streaming_window_ns = DEFAULT_GENERATOR_STREAMING_WINDOW_NS;
             }
+
         } else {
+            throw std::invalid_argument("Unknown TCP flow schedule generator: " + m_schedule_generator);
+        }
+
+        // Number of start events (each starting all flows with the same start time) which are scheduled ahead
+        m_start_lookahead_events = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_start_lookahead_events", "1"));
+
+        // Recycling: clients of finished flows are re-used for new flows starting at the same node
+        m_enable_client_recycling = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_enable_client_recycling", "false"));
+        if (m_enable_client_recycling) {
+            m_idle_clients.resize(m_nodes.GetN());
+            std::cout << "  > Clients of finished flows are recycled" << std::endl;
+        }
+
+        // Enable logging for TCP flow IDs
+        std::string enable_for_tcp_flows_ids_str = basicSimulation->GetConfigParamOrDefault("tcp_flow_enable_logging_for_tcp_flow_ids", "set()");
+        m_enable_logging_for_all_tcp_flow_ids = enable_for_tcp_flows_ids_str == "all";
+        if (!m_enable_logging_for_all_tcp_flow_ids) {
             m_enable_logging_for_tcp_flow_ids = parse_set_positive_int64(enable_for_tcp_flows_ids_str);
         }
 
-        // Check that the TCP flow IDs exist in the logging
-        for (int64_t tcp_flow_id : m_enable_logging_for_tcp_flow_ids) {
-            if ((size_t) tcp_flow_id >= complete_schedule.size()) {
-                throw std::invalid_argument("Invalid TCP flow ID in tcp_flow_enable_logging_for_tcp_flow_ids: " + std::to_string(tcp_flow_id));
+        // Format of the detailed logs, which are all written by one asynchronous writer (which bounds the number of open files)
+        m_log_output_format = m_basicSimulation->GetConfigParamOrDefault("log_output_format", "csv");
+        parse_log_output_format(m_log_output_format); // Validate early
+        m_detailed_log_writer = CreateObject<AsyncLogWriter>(65536);
+
+        if (m_streaming_window_ns > 0) {
+
+            // A schedule file is validated completely up front (only parsed, the entries are not kept),
+            // such that an invalid line deep in it fails the setup instead of the run once its window is read
+            if (m_schedule_generator == "none") {
+                CheckLoggingTcpFlowIds(validate_tcp_flow_schedule(m_schedule_filename, m_topology, m_simulation_end_time_ns));
             }
-        }
 
-        // Filter the schedule to only have applications starting at nodes which are part of this system
-        if (m_enable_distributed) {
-            std::vector<TcpFlowScheduleEntry> filtered_schedule;
-            for (TcpFlowScheduleEntry &entry : complete_schedule) {
-                if (m_basicSimulation->IsNodeAssignedToThisSystem(entry.GetFromNodeId())) {
-                    filtered_schedule.push_back(entry);
-                }
+            // Read the first window (for a generated schedule, the logging TCP flow IDs are checked once the stream is exhausted)
+            m_schedule_stream = CreateScheduleStream(true);
+            LoadNextScheduleWindow(m_schedule_stream);
+            if (!m_schedule_stream->HasNext()) {
+                CheckLoggingTcpFlowIds(m_schedule_stream->GetNumRead());
             }
-            m_schedule = filtered_schedule;
+            printf("  > Streaming schedule in windows of %" PRId64 " ns (first window flow start events: %lu)\n", m_streaming_window_ns, m_schedule.size());
+
         } else {
-            m_schedule = complete_schedule;
+
+            // Read schedule
+            std::vector<TcpFlowScheduleEntry> complete_schedule = read_tcp_flow_schedule(
+                    m_schedule_filename,
+                    m_topology,
+                    m_simulation_end_time_ns
+            );
+
+            // Check that the TCP flow IDs exist in the logging
+            CheckLoggingTcpFlowIds(complete_schedule.size());
+
+            // Filter the schedule to only have applications starting at nodes which are part of this system
+            if (m_enable_distributed) {
+                std::vector<TcpFlowScheduleEntry> filtered_schedule;
+                for (TcpFlowScheduleEntry &entry : complete_schedule) {
+                    if (m_basicSimulation->IsNodeAssignedToThisSystem(entry.GetFromNodeId())) {
+                        filtered_schedule.push_back(entry);
+                    }
+                }
+                m_schedule.swap(filtered_schedule);
+            } else {
+                m_schedule.swap(complete_schedule);
+            }
+            printf("  > Read schedule (total flow start events: %lu)\n", m_schedule.size());
+
         }
 
         // Schedule read
-        printf("  > Read schedule (total flow start events: %lu)\n", m_schedule.size());
         m_basicSimulation->RegisterTimestamp("Read flow schedule");
 
         // Determine filenames
@@ -143,14 +382,18 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
                     m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_tcp_flows.csv";
             m_flows_txt_filename =
                     m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_tcp_flows.txt";
+            m_servers_csv_filename =
+                    m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_tcp_flow_servers.csv";
         } else {
             m_flows_csv_filename = m_basicSimulation->GetLogsDir() + "/tcp_flows.csv";
             m_flows_txt_filename = m_basicSimulation->GetLogsDir() + "/tcp_flows.txt";
+            m_servers_csv_filename = m_basicSimulation->GetLogsDir() + "/tcp_flow_servers.csv";
         }
 
         // Remove files if they are there
         remove_file_if_exists(m_flows_csv_filename);
         remove_file_if_exists(m_flows_txt_filename);
+        remove_file_if_exists(m_servers_csv_filename);
         printf("  > Removed previous flow log files if present\n");
         m_basicSimulation->RegisterTimestamp("Remove previous flow log files");
 
@@ -167,6 +410,7 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
                     tcpFlowServer->SetTcpSocketGenerator(m_tcpSocketGenerator);
                     tcpFlowServer->SetIpTos(m_ipTosGenerator->GenerateIpTos(TcpFlowServer::GetTypeId(), tcpFlowServer));
                     app.Start(Seconds(0.0));
+                    m_servers.push_back(std::make_tuple(endpoint, server_port, tcpFlowServer));
                 }
             }
         }
@@ -174,9 +418,9 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
 
         // Setup start of first source application
         std::cout << "  > Setting up traffic TCP flow starter" << std::endl;
-        if (m_schedule.size() > 0) {
-            Simulator::Schedule(NanoSeconds(m_schedule.at(0).GetStartTimeNs()), &TcpFlowScheduler::StartNextFlow, this, 0);
-        }
+        m_next_start_event_idx = 0;
+        m_num_pending_start_events = 0;
+        ScheduleStartEvents();
         m_basicSimulation->RegisterTimestamp("Setup traffic TCP flow starter");
 
     }
@@ -208,70 +452,83 @@ void TcpFlowScheduler::WriteResults() {
                 "End time (ns)", "Duration", "Sent", "Progress", "Avg. rate", "Finished?", "Metadata"
         );
 
+        // Finalize the detailed logs (if they are enabled)
+        for (Ptr<TcpFlowClient> client : m_detailed_logging_clients) {
+            client->FinalizeDetailedLogs();
+        }
+        m_detailed_logging_clients.clear();
+        m_detailed_log_writer->Close();
+
+        // Record the results of the flows which have not finished
+        for (std::pair<const int64_t, std::pair<size_t, Ptr<TcpFlowClient>>>& active_flow : m_active_flows) {
+            RecordFlowResult(active_flow.second.first, active_flow.second.second);
+        }
+        m_active_flows.clear();
+
         // Go over the schedule, write each flow's result
         std::cout << "  > Writing log files line-by-line" << std::endl;
-        std::cout << "  > Total TCP flow log entries to write... " << m_apps.size() << std::endl;
-        uint32_t app_idx = 0;
-        for (TcpFlowScheduleEntry& entry : m_schedule) {
-
-            // Retrieve application
-            Ptr<TcpFlowClient> flowSendApp = m_apps.at(app_idx).Get(0)->GetObject<TcpFlowClient>();
-
-            // Finalize the detailed logs (if they are enabled)
-            flowSendApp->FinalizeDetailedLogs();
-
-            // Retrieve statistics
-            bool is_completed = flowSendApp->IsCompleted();
-            bool is_conn_failed = flowSendApp->IsConnFailed();
-            bool is_closed_err = flowSendApp->IsClosedByError();
-            bool is_closed_normal = flowSendApp->IsClosedNormally();
-            int64_t sent_byte = flowSendApp->GetAckedBytes();
-            int64_t fct_ns;
-            if (is_completed) {
-                fct_ns = flowSendApp->GetCompletionTimeNs() - entry.GetStartTimeNs();
-            } else {
-                fct_ns = m_simulation_end_time_ns - entry.GetStartTimeNs();
-            }
-            std::string finished_state;
-            if (is_completed) {
-                finished_state = "YES";
-            } else if (is_conn_failed) {
-                finished_state = "NO_CONN_FAIL";
-            } else if (is_closed_normal) {
-                finished_state = "NO_BAD_CLOSE";
-            } else if (is_closed_err) {
-                finished_state = "NO_ERR_CLOSE";
-            } else {
-                finished_state = "NO_ONGOING";
-            }
+        std::cout << "  > Total TCP flow log entries to write... " << m_flow_results.GetSize() << std::endl;
 
-            // Write plain to the csv
-            fprintf(
-                    file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s,%s\n",
-                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), entry.GetSizeByte(), entry.GetStartTimeNs(),
-                    entry.GetStartTimeNs() + fct_ns, fct_ns, sent_byte, finished_state.c_str(), entry.GetMetadata().c_str()
-            );
+        // If streaming, the schedule is streamed once more from the start (window-by-window)
+        Ptr<TcpFlowScheduleStream> reader = 0;
+        if (m_schedule_stream != 0) {
+            reader = CreateScheduleStream(false);
+            LoadNextScheduleWindow(reader);
+        }
+        size_t result_idx = 0;
+        while (true) {
+            for (TcpFlowScheduleEntry& entry : m_schedule) {
+
+                // Retrieve the result
+                TcpFlowResultStore::FinishedState finished_state = m_flow_results.GetFinishedState(result_idx);
+                int64_t sent_byte = m_flow_results.GetSentByte(result_idx);
+                int64_t fct_ns;
+                if (finished_state == TcpFlowResultStore::COMPLETED) {
+                    fct_ns = m_flow_results.GetCompletionTimeNs(result_idx) - entry.GetStartTimeNs();
+                } else {
+                    fct_ns = m_simulation_end_time_ns - entry.GetStartTimeNs();
+                }
+                const std::string finished_state_str = TcpFlowResultStore::FinishedStateToString(finished_state);
+
+                // Write plain to the csv
+                fprintf(
+                        file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s,%s\n",
+                        entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), entry.GetSizeByte(), entry.GetStartTimeNs(),
+                        entry.GetStartTimeNs() + fct_ns, fct_ns, sent_byte, finished_state_str.c_str(), entry.GetMetadata().c_str()
+                );
+
+                // Write nicely formatted to the text
+                char str_size_megabit[100];
+                sprintf(str_size_megabit, "%.2f Mbit", byte_to_megabit(entry.GetSizeByte()));
+                char str_duration_ms[100];
+                sprintf(str_duration_ms, "%.2f ms", nanosec_to_millisec(fct_ns));
+                char str_sent_megabit[100];
+                sprintf(str_sent_megabit, "%.2f Mbit", byte_to_megabit(sent_byte));
+                char str_progress_perc[100];
+                sprintf(str_progress_perc, "%.1f%%", ((double) sent_byte) / ((double) entry.GetSizeByte()) * 100.0);
+                char str_avg_rate_megabit_per_s[100];
+                sprintf(str_avg_rate_megabit_per_s, "%.1f Mbit/s", byte_to_megabit(sent_byte) / nanosec_to_sec(fct_ns));
+                fprintf(
+                        file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-16s%-18" PRId64 "%-18" PRId64 "%-16s%-16s%-13s%-16s%-14s%s\n",
+                        entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), str_size_megabit, entry.GetStartTimeNs(),
+                        entry.GetStartTimeNs() + fct_ns, str_duration_ms, str_sent_megabit, str_progress_perc, str_avg_rate_megabit_per_s,
+                        finished_state_str.c_str(), entry.GetMetadata().c_str()
+                );
+
+                // Move on result index
+                result_idx += 1;
 
-            // Write nicely formatted to the text
-            char str_size_megabit[100];
-            sprintf(str_size_megabit, "%.2f Mbit", byte_to_megabit(entry.GetSizeByte()));
-            char str_duration_ms[100];
-            sprintf(str_duration_ms, "%.2f ms", nanosec_to_millisec(fct_ns));
-            char str_sent_megabit[100];
-            sprintf(str_sent_megabit, "%.2f Mbit", byte_to_megabit(sent_byte));
-            char str_progress_perc[100];
-            sprintf(str_progress_perc, "%.1f%%", ((double) sent_byte) / ((double) entry.GetSizeByte()) * 100.0);
-            char str_avg_rate_megabit_per_s[100];
-            sprintf(str_avg_rate_megabit_per_s, "%.1f Mbit/s", byte_to_megabit(sent_byte) / nanosec_to_sec(fct_ns));
-            fprintf(
-                    file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-16s%-18" PRId64 "%-18" PRId64 "%-16s%-16s%-13s%-16s%-14s%s\n",
-                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), str_size_megabit, entry.GetStartTimeNs(),
-                    entry.GetStartTimeNs() + fct_ns, str_duration_ms, str_sent_megabit, str_progress_perc, str_avg_rate_megabit_per_s,
-                    finished_state.c_str(), entry.GetMetadata().c_str()
-            );
+            }
 
-            // Move on application index
-            app_idx += 1;
+            // Next window if streaming
+            if (reader == 0) {
+                break;
+            }
+            LoadNextScheduleWindow(reader);
+            if (m_schedule.size() == 0) {
+                CheckLoggingTcpFlowIds(reader->GetNumRead());
+                break;
+            }
 
         }
 
@@ -286,6 +543,23 @@ void TcpFlowScheduler::WriteResults() {
         std::cout << "  > TCP flow log files have been written" << std::endl;
         m_basicSimulation->RegisterTimestamp("Write TCP flow log files");
 
+        // Connection counters of each server (line format: node_id,port,accepted,peak_open,open_at_end)
+        FILE* file_servers_csv = fopen(m_servers_csv_filename.c_str(), "w+");
+        uint64_t peak_open = 0;
+        for (std::tuple<int64_t, uint16_t, Ptr<TcpFlowServer>>& server : m_servers) {
+            Ptr<TcpFlowServer> tcpFlowServer = std::get<2>(server);
+            fprintf(
+                    file_servers_csv, "%" PRId64 ",%u,%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                    std::get<0>(server), (unsigned int) std::get<1>(server), tcpFlowServer->GetNumAcceptedConnections(),
+                    tcpFlowServer->GetPeakOpenConnections(), tcpFlowServer->GetNumOpenConnections()
+            );
+            peak_open = std::max(peak_open, tcpFlowServer->GetPeakOpenConnections());
+        }
+        fclose(file_servers_csv);
+        std::cout << "  > Written server connection counters to: " << m_servers_csv_filename << std::endl;
+        std::cout << "    >> Highest peak of open connections of a server... " << peak_open << std::endl;
+        m_basicSimulation->RegisterTimestamp("Write TCP flow server log file");
+
     }
 
     std::cout << std::endl;
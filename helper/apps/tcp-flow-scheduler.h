@@ -34,6 +34,8 @@
 #include "ns3/socket-generator.h"
 #include "ns3/ip-tos-generator.h"
 #include "ns3/tcp-flow-schedule-reader.h"
+#include "ns3/tcp-flow-schedule-generator.h"
+#include "ns3/tcp-flow-result-store.h"
 #include "ns3/tcp-flow-helper.h"
 #include "ns3/tcp-flow-client.h"
 #include "ns3/tcp-flow-server.h"
@@ -45,12 +47,21 @@ class TcpFlowScheduler
 
 public:
     static const uint16_t DEFAULT_SERVER_PORT;
+    static const int64_t DEFAULT_GENERATOR_STREAMING_WINDOW_NS;
     TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology);
     TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology, std::set<uint16_t> serverPorts, Ptr<ClientRemotePortSelector> clientRemotePortSelector, Ptr<TcpSocketGenerator> tcpSocketGenerator, Ptr<IpTosGenerator> ipTosGenerator);
     void WriteResults();
 
 protected:
-    void StartNextFlow(int i);
+    void StartNextFlows(int i);
+    void ScheduleStartEvents();
+    void StartFlow(TcpFlowScheduleEntry& entry);
+    Ptr<TcpFlowScheduleStream> CreateScheduleStream(bool first);
+    void LoadNextScheduleWindow(Ptr<TcpFlowScheduleStream> reader);
+    void CheckLoggingTcpFlowIds(int64_t num_tcp_flows);
+    bool IsDetailedLoggingEnabled(int64_t tcp_flow_id);
+    void FlowFinished(Ptr<TcpFlowClient> client);
+    void RecordFlowResult(size_t result_idx, Ptr<TcpFlowClient> client);
     Ptr<BasicSimulation> m_basicSimulation;
     int64_t m_simulation_end_time_ns;
     Ptr<Topology> m_topology = nullptr;
@@ -60,13 +71,34 @@ protected:
     Ptr<IpTosGenerator> m_ipTosGenerator;
     bool m_enabled;
 
-    std::vector<TcpFlowScheduleEntry> m_schedule;
+    std::string m_schedule_generator; // "none" if read from the schedule file
+    std::string m_schedule_filename;
+    double m_generator_arrival_rate_per_s;
+    std::vector<std::pair<int64_t, double>> m_generator_flow_size_cdf;
+    std::string m_generator_pairing;
+    int64_t m_generator_seed;
+    bool m_generator_dump_schedule;
+    std::vector<TcpFlowScheduleEntry> m_schedule; // If streaming, only the current window
+    int64_t m_streaming_window_ns;
+    Ptr<TcpFlowScheduleStream> m_schedule_stream; // Only set if streaming (else: 0)
+    int64_t m_start_lookahead_events;
+    size_t m_next_start_event_idx; // Index in the schedule of the first flow whose start event is not yet scheduled
+    int64_t m_num_pending_start_events;
     NodeContainer m_nodes;
-    std::vector<ApplicationContainer> m_apps;
+    TcpFlowResultStore m_flow_results; // In order of flow start
+    std::map<int64_t, std::pair<size_t, Ptr<TcpFlowClient>>> m_active_flows; // TCP flow ID -> (result index, client)
+    std::vector<Ptr<TcpFlowClient>> m_detailed_logging_clients; // Kept until the logs are finalized
+    Ptr<AsyncLogWriter> m_detailed_log_writer; // Shared by the detailed logs of all flows
+    bool m_enable_client_recycling;
+    std::vector<std::vector<Ptr<TcpFlowClient>>> m_idle_clients; // Per node, only used if recycling
+    bool m_enable_logging_for_all_tcp_flow_ids;
     std::set<int64_t> m_enable_logging_for_tcp_flow_ids;
+    std::string m_log_output_format;
     bool m_enable_distributed;
     std::string m_flows_csv_filename;
     std::string m_flows_txt_filename;
+    std::string m_servers_csv_filename;
+    std::vector<std::tuple<int64_t, uint16_t, Ptr<TcpFlowServer>>> m_servers; // (node id, port, server)
 };
 
 }
@@ -90,31 +90,32 @@ std::vector<UdpBurstInfo> read_udp_burst_schedule(const std::string& filename, P
         throw std::runtime_error(format_string("UDP burst schedule file %s does not exist.", filename.c_str()));
     }
 
-    // Open file
-    std::string line;
-    std::ifstream schedule_file(filename);
-    NS_ABORT_MSG_IF(!schedule_file, format_string("UDP burst schedule file %s could not be opened.", filename.c_str()));
+    // Open file (mapped into memory, lines and fields are scanned in place)
+    MappedFileLineReader schedule_file(filename);
+    const char* line_begin;
+    const char* line_end;
+    std::vector<std::pair<const char*, const char*>> comma_split;
 
     // Go over each line
     size_t line_counter = 0;
     int64_t prev_start_time_ns = 0;
-    while (getline(schedule_file, line)) {
+    while (schedule_file.NextLine(line_begin, line_end)) {
 
         // Split on ,
-        std::vector<std::string> comma_split = split_string(line, ",", 8);
+        split_string_in_place(line_begin, line_end, ',', 8, comma_split);
 
         // Fill entry
-        int64_t udp_burst_id = parse_positive_int64(comma_split.at(0));
+        int64_t udp_burst_id = parse_positive_int64(comma_split[0].first, comma_split[0].second);
         if (udp_burst_id != (int64_t) line_counter) {
             throw std::invalid_argument(format_string("UDP burst ID is not ascending by one each line (violation: %" PRId64 ")\n", udp_burst_id));
         }
-        int64_t from_node_id = parse_positive_int64(comma_split.at(1));
-        int64_t to_node_id = parse_positive_int64(comma_split.at(2));
-        double target_rate_megabit_per_s = parse_positive_double(comma_split.at(3));
-        int64_t start_time_ns = parse_positive_int64(comma_split.at(4));
-        int64_t duration_ns = parse_positive_int64(comma_split.at(5));
-        std::string additional_parameters = comma_split.at(6);
-        std::string metadata = comma_split.at(7);
+        int64_t from_node_id = parse_positive_int64(comma_split[1].first, comma_split[1].second);
+        int64_t to_node_id = parse_positive_int64(comma_split[2].first, comma_split[2].second);
+        double target_rate_megabit_per_s = parse_positive_double(comma_split[3].first, comma_split[3].second);
+        int64_t start_time_ns = parse_positive_int64(comma_split[4].first, comma_split[4].second);
+        int64_t duration_ns = parse_positive_int64(comma_split[5].first, comma_split[5].second);
+        std::string additional_parameters(comma_split[6].first, comma_split[6].second);
+        std::string metadata(comma_split[7].first, comma_split[7].second);
 
         // Zero target rate
         if (target_rate_megabit_per_s == 0.0) {
@@ -156,9 +157,6 @@ std::vector<UdpBurstInfo> read_udp_burst_schedule(const std::string& filename, P
 
     }
 
-    // Close file
-    schedule_file.close();
-
     return schedule;
 
 }
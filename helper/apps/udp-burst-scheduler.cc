@@ -23,12 +23,55 @@
 
 namespace ns3 {
 
+/**
+ * Start all UDP bursts of the schedule from index i onward which start right now,
+ * and keep the start events ahead in the event queue.
+ *
+ * @param i     Index of the first UDP burst which starts now
+ */
 void UdpBurstScheduler::StartNextUdpBurst(int i) {
+    int64_t now_ns = Simulator::Now().GetNanoSeconds();
+    NS_ABORT_UNLESS(now_ns == m_schedule.at(i).GetStartTimeNs());
+
+    // Start all UDP bursts with this start time in a single pass
+    size_t j = i;
+    while (j < m_schedule.size() && m_schedule.at(j).GetStartTimeNs() == now_ns) {
+        StartUdpBurst(m_schedule.at(j));
+        j++;
+    }
+    m_num_pending_start_events -= 1;
 
-    // Fetch the flow to start
-    UdpBurstInfo& entry = m_schedule.at(i);
+    // Keep the start events ahead
+    ScheduleStartEvents();
+
+}
+
+/**
+ * Schedule the start events of the upcoming start times, such that (at most) the look-ahead
+ * number of start events is pending. Each start event starts all UDP bursts with that start time.
+ */
+void UdpBurstScheduler::ScheduleStartEvents() {
     int64_t now_ns = Simulator::Now().GetNanoSeconds();
-    NS_ABORT_UNLESS(now_ns == entry.GetStartTimeNs());
+    while (m_num_pending_start_events < m_start_lookahead_events && m_next_start_event_idx < m_schedule.size()) {
+        int64_t start_time_ns = m_schedule.at(m_next_start_event_idx).GetStartTimeNs();
+        Simulator::Schedule(
+                NanoSeconds(start_time_ns - now_ns),
+                &UdpBurstScheduler::StartNextUdpBurst, this,
+                (int) m_next_start_event_idx
+        );
+        m_num_pending_start_events += 1;
+        while (m_next_start_event_idx < m_schedule.size() && m_schedule.at(m_next_start_event_idx).GetStartTimeNs() == start_time_ns) {
+            m_next_start_event_idx += 1;
+        }
+    }
+}
+
+/**
+ * Start a UDP burst right now.
+ *
+ * @param entry     Schedule entry of the UDP burst
+ */
+void UdpBurstScheduler::StartUdpBurst(UdpBurstInfo& entry) {
 
     // Helper to install the source application
     UdpBurstClientHelper client(
@@ -43,25 +86,18 @@ void UdpBurstScheduler::StartNextUdpBurst(int i) {
     );
 
     // Install it on the node and start it right now
+    client.SetAttribute("LogOutputFormat", StringValue(m_log_output_format));
+    client.SetAttribute("ServerSlot", UintegerValue(m_udp_burst_server_slot.at(entry.GetUdpBurstId())));
     ApplicationContainer app = client.Install(m_nodes.Get(entry.GetFromNodeId()));
     Ptr<UdpBurstClient> udpBurstClient = app.Get(0)->GetObject<UdpBurstClient>();
     udpBurstClient->SetUdpSocketGenerator(m_udpSocketGenerator);
     udpBurstClient->SetIpTos(m_ipTosGenerator->GenerateIpTos(UdpBurstClient::GetTypeId(), udpBurstClient));
+    udpBurstClient->SetPreciseLogWriter(m_precise_log_writer);
     app.Start(NanoSeconds(0));
 
     // Match the entry to the application for logging later
     m_responsible_for_outgoing_bursts.push_back(std::make_pair(entry, app.Get(0)->GetObject<UdpBurstClient>()));
 
-    // If there is a next flow to start, schedule its start
-    if (i + 1 != (int) m_schedule.size()) {
-        int64_t next_burst_ns = m_schedule.at(i + 1).GetStartTimeNs();
-        Simulator::Schedule(
-                NanoSeconds(next_burst_ns - now_ns),
-                &UdpBurstScheduler::StartNextUdpBurst, this,
-                i + 1
-        );
-    }
-
 }
 
 UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) : UdpBurstScheduler(
@@ -96,6 +132,9 @@ UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
         // Distributed run information
         m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
 
+        // Number of start events (each starting all UDP bursts with the same start time) which are scheduled ahead
+        m_start_lookahead_events = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("udp_burst_start_lookahead_events", "1"));
+
         // Read schedule
         std::vector<UdpBurstInfo> complete_schedule = read_udp_burst_schedule(
                 m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("udp_burst_schedule_filename"),
@@ -130,11 +169,13 @@ UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
             m_udp_bursts_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_bursts_outgoing.txt";
             m_udp_bursts_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_bursts_incoming.csv";
             m_udp_bursts_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_bursts_incoming.txt";
+            m_udp_bursts_one_way_latency_sketch_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_bursts_one_way_latency_sketch.csv";
         } else {
             m_udp_bursts_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_outgoing.csv";
             m_udp_bursts_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_outgoing.txt";
             m_udp_bursts_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_incoming.csv";
             m_udp_bursts_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_incoming.txt";
+            m_udp_bursts_one_way_latency_sketch_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_one_way_latency_sketch.csv";
         }
 
         // Remove files if they are there
@@ -142,9 +183,24 @@ UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
         remove_file_if_exists(m_udp_bursts_outgoing_txt_filename);
         remove_file_if_exists(m_udp_bursts_incoming_csv_filename);
         remove_file_if_exists(m_udp_bursts_incoming_txt_filename);
+        remove_file_if_exists(m_udp_bursts_one_way_latency_sketch_csv_filename);
         printf("  > Removed previous UDP burst log files if present\n");
         m_basicSimulation->RegisterTimestamp("Remove previous UDP burst log files");
 
+        // All precise logs are written by one asynchronous writer (which bounds the number of open files)
+        m_precise_log_writer = CreateObject<AsyncLogWriter>();
+        m_log_output_format = m_basicSimulation->GetConfigParamOrDefault("log_output_format", "csv");
+        parse_log_output_format(m_log_output_format); // Validate early
+        std::cout << "  > Precise logs are written in format: " << m_log_output_format << std::endl;
+
+        // Each burst gets a slot at its destination server in order of the complete schedule,
+        // such that every system knows the slot without the server being installed on it
+        std::map<int64_t, uint32_t> next_server_slot;
+        m_udp_burst_server_slot.clear();
+        for (UdpBurstInfo& entry : complete_schedule) {
+            m_udp_burst_server_slot.push_back(next_server_slot[entry.GetToNodeId()]++);
+        }
+
         // Endpoints
         std::set<int64_t> endpoints = m_topology->GetEndpoints();
 
@@ -158,19 +214,24 @@ UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
                         InetSocketAddress(m_nodes.Get(endpoint)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1025),
                         m_basicSimulation->GetLogsDir()
                 );
+                burstServerHelper.SetAttribute("LogOutputFormat", StringValue(m_log_output_format));
                 ApplicationContainer app = burstServerHelper.Install(m_nodes.Get(endpoint));
                 Ptr<UdpBurstServer> udpBurstServer = app.Get(0)->GetObject<UdpBurstServer>();
                 udpBurstServer->SetUdpSocketGenerator(m_udpSocketGenerator);
                 udpBurstServer->SetIpTos(m_ipTosGenerator->GenerateIpTos(UdpBurstServer::GetTypeId(), udpBurstServer));
+                udpBurstServer->SetPreciseLogWriter(m_precise_log_writer);
                 app.Start(Seconds(0.0));
 
                 // Register all incoming bursts of the server
                 for (UdpBurstInfo entry : complete_schedule) {
                     if (entry.GetToNodeId() == endpoint) {
-                        udpBurstServer->RegisterIncomingBurst(
+                        uint32_t slot = udpBurstServer->RegisterIncomingBurst(
                                 entry.GetUdpBurstId(),
-                                m_enable_logging_for_udp_burst_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_udp_burst_ids.end()
+                                m_enable_logging_for_udp_burst_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_udp_burst_ids.end(),
+                                entry.GetStartTimeNs(),
+                                UdpBurstClient::CalculatePacketGapNs(udpBurstServer->GetMaxSegmentSizeByte(), entry.GetTargetRateMegabitPerSec())
                         );
+                        NS_ABORT_MSG_UNLESS(slot == m_udp_burst_server_slot.at(entry.GetUdpBurstId()), "Server slot does not match the schedule");
                         m_responsible_for_incoming_bursts.push_back(std::make_pair(entry, udpBurstServer));
                     }
                 }
@@ -198,13 +259,9 @@ UdpBurstScheduler::UdpBurstScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
         
         // Setup start of first UDP burst client
         std::cout << "  > Schedule start of first UDP burst client" << std::endl;
-        if (m_schedule.size() > 0) {
-            Simulator::Schedule(
-                    NanoSeconds(m_schedule.at(0).GetStartTimeNs()),
-                    &UdpBurstScheduler::StartNextUdpBurst, this,
-                    0 // First index
-            );
-        }
+        m_next_start_event_idx = 0;
+        m_num_pending_start_events = 0;
+        ScheduleStartEvents();
         m_basicSimulation->RegisterTimestamp("Schedule start of first UDP burst client");
 
     }
@@ -221,6 +278,16 @@ void UdpBurstScheduler::WriteResults() {
 
     } else {
 
+        // Precise logs
+        std::cout << "  > Flushing precise UDP burst logs" << std::endl;
+        for (std::pair<UdpBurstInfo, Ptr<UdpBurstClient>>& p : m_responsible_for_outgoing_bursts) {
+            p.second->ClosePreciseLog();
+        }
+        for (std::pair<UdpBurstInfo, Ptr<UdpBurstServer>>& p : m_responsible_for_incoming_bursts) {
+            p.second->ClosePreciseLogs();
+        }
+        m_precise_log_writer->Flush();
+
         // Open files
         std::cout << "  > Opening UDP burst log files:" << std::endl;
         FILE* file_outgoing_csv = fopen(m_udp_bursts_outgoing_csv_filename.c_str(), "w+");
@@ -324,6 +391,7 @@ void UdpBurstScheduler::WriteResults() {
 
         // Incoming bursts
         std::cout << "  > Writing incoming log files" << std::endl;
+        LatencySketch all_one_way_latency_sketch;
         for (std::pair<UdpBurstInfo, Ptr<UdpBurstServer>> p : m_responsible_for_incoming_bursts) {
             UdpBurstInfo info = p.first;
             Ptr<UdpBurstServer> udpBurstServerIncoming = p.second;
@@ -332,6 +400,8 @@ void UdpBurstScheduler::WriteResults() {
             uint32_t complete_packet_size = udpBurstServerIncoming->GetMaxSegmentSizeByte();
             uint32_t max_udp_payload_size_byte = udpBurstServerIncoming->GetMaxUdpPayloadSizeByte();
             uint64_t received_counter = udpBurstServerIncoming->GetReceivedCounterOf(info.GetUdpBurstId());
+            const LatencySketch& one_way_latency_sketch = udpBurstServerIncoming->GetOneWayLatencySketchOf(info.GetUdpBurstId());
+            all_one_way_latency_sketch.Merge(one_way_latency_sketch);
 
             // Calculate incoming rate
             int64_t effective_duration_ns = info.GetStartTimeNs() + info.GetDurationNs() >= m_simulation_end_time_ns ? m_simulation_end_time_ns - info.GetStartTimeNs() : info.GetDurationNs();
@@ -340,10 +410,14 @@ void UdpBurstScheduler::WriteResults() {
 
             // Write plain to the CSV
             fprintf(
-                    file_incoming_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%f,%" PRId64 ",%" PRId64 ",%f,%f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%s\n",
+                    file_incoming_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%f,%" PRId64 ",%" PRId64 ",%f,%f,%" PRIu64 ",%" PRIu64 ",%" PRIu64
+                    ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s\n",
                     info.GetUdpBurstId(), info.GetFromNodeId(), info.GetToNodeId(), info.GetTargetRateMegabitPerSec(), info.GetStartTimeNs(),
                     info.GetDurationNs(), rate_incl_headers_megabit_per_s, rate_payload_only_megabit_per_s, received_counter,
-                    received_counter * complete_packet_size, received_counter * max_udp_payload_size_byte, info.GetMetadata().c_str()
+                    received_counter * complete_packet_size, received_counter * max_udp_payload_size_byte,
+                    one_way_latency_sketch.GetQuantile(0.5), one_way_latency_sketch.GetQuantile(0.9),
+                    one_way_latency_sketch.GetQuantile(0.99), one_way_latency_sketch.GetQuantile(0.999),
+                    info.GetMetadata().c_str()
             );
 
             // Write nicely formatted to the text
@@ -391,6 +465,10 @@ void UdpBurstScheduler::WriteResults() {
         fclose(file_incoming_txt);
         std::cout << "    >> Closed: " << m_udp_bursts_incoming_txt_filename << std::endl;
 
+        // One-way latency sketch of all incoming bursts of this system together
+        all_one_way_latency_sketch.WriteToFile(m_udp_bursts_one_way_latency_sketch_csv_filename);
+        std::cout << "    >> Written: " << m_udp_bursts_one_way_latency_sketch_csv_filename << std::endl;
+
         // Register completion
         std::cout << "  > UDP burst log files have been written" << std::endl;
         m_basicSimulation->RegisterTimestamp("Write UDP burst log files");
@@ -48,6 +48,8 @@ namespace ns3 {
         void WriteResults();
 
     protected:
+        void ScheduleStartEvents();
+        void StartUdpBurst(UdpBurstInfo& entry);
         Ptr<BasicSimulation> m_basicSimulation;
         int64_t m_simulation_end_time_ns;
         Ptr<Topology> m_topology = nullptr;
@@ -58,14 +60,21 @@ namespace ns3 {
         bool m_enable_distributed;
 
         std::vector<UdpBurstInfo> m_schedule;
+        std::vector<uint32_t> m_udp_burst_server_slot; // UDP burst ID -> slot at its destination server
+        int64_t m_start_lookahead_events;
+        size_t m_next_start_event_idx; // Index in the schedule of the first UDP burst whose start event is not yet scheduled
+        int64_t m_num_pending_start_events;
         NodeContainer m_nodes;
         std::vector<ApplicationContainer> m_apps;
         std::set<int64_t> m_enable_logging_for_udp_burst_ids;
+        Ptr<AsyncLogWriter> m_precise_log_writer;
+        std::string m_log_output_format;
 
         std::string m_udp_bursts_outgoing_csv_filename;
         std::string m_udp_bursts_outgoing_txt_filename;
         std::string m_udp_bursts_incoming_csv_filename;
         std::string m_udp_bursts_incoming_txt_filename;
+        std::string m_udp_bursts_one_way_latency_sketch_csv_filename;
 
         std::vector<std::pair<UdpBurstInfo, Ptr<UdpBurstClient>>> m_responsible_for_outgoing_bursts;
         std::vector<std::pair<UdpBurstInfo, Ptr<UdpBurstServer>>> m_responsible_for_incoming_bursts;
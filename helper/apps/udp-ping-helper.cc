@@ -87,4 +87,32 @@ UdpPingClientHelper::InstallPriv (Ptr<Node> node) const
   return app;
 }
 
+UdpPingAgentHelper::UdpPingAgentHelper (Address localAddress)
+{
+  m_factory.SetTypeId (UdpPingAgent::GetTypeId ());
+  SetAttribute ("LocalAddress", AddressValue (localAddress));
+}
+
+void 
+UdpPingAgentHelper::SetAttribute (
+  std::string name, 
+  const AttributeValue &value)
+{
+  m_factory.Set (name, value);
+}
+
+ApplicationContainer
+UdpPingAgentHelper::Install (Ptr<Node> node) const
+{
+  return ApplicationContainer (InstallPriv (node));
+}
+
+Ptr<Application>
+UdpPingAgentHelper::InstallPriv (Ptr<Node> node) const
+{
+  Ptr<Application> app = m_factory.Create<UdpPingAgent> ();
+  node->AddApplication (app);
+  return app;
+}
+
 } // namespace ns3
@@ -31,6 +31,7 @@
 #include "ns3/ipv6-address.h"
 #include "ns3/udp-ping-server.h"
 #include "ns3/udp-ping-client.h"
+#include "ns3/udp-ping-agent.h"
 #include "ns3/uinteger.h"
 #include "ns3/names.h"
 
@@ -60,6 +61,18 @@ private:
   ObjectFactory m_factory;
 };
 
+class UdpPingAgentHelper
+{
+public:
+  UdpPingAgentHelper (Address localAddress);
+  void SetAttribute (std::string name, const AttributeValue &value);
+  ApplicationContainer Install (Ptr<Node> node) const;
+
+private:
+  Ptr<Application> InstallPriv (Ptr<Node> node) const;
+  ObjectFactory m_factory;
+};
+
 } // namespace ns3
 
 #endif /* UDP_PING_HELPER_H */
@@ -21,12 +21,55 @@
 
 namespace ns3 {
 
+/**
+ * Start all UDP pings of the schedule from index i onward which start right now,
+ * and keep the start events ahead in the event queue.
+ *
+ * @param i     Index of the first UDP ping which starts now
+ */
 void UdpPingScheduler::StartNextUdpPing(int i) {
+    int64_t now_ns = Simulator::Now().GetNanoSeconds();
+    NS_ABORT_UNLESS(now_ns == m_schedule.at(i).GetStartTimeNs());
 
-    // Fetch the flow to start
-    UdpPingInfo& entry = m_schedule.at(i);
+    // Start all UDP pings with this start time in a single pass
+    size_t j = i;
+    while (j < m_schedule.size() && m_schedule.at(j).GetStartTimeNs() == now_ns) {
+        StartUdpPing(m_schedule.at(j));
+        j++;
+    }
+    m_num_pending_start_events -= 1;
+
+    // Keep the start events ahead
+    ScheduleStartEvents();
+
+}
+
+/**
+ * Schedule the start events of the upcoming start times, such that (at most) the look-ahead
+ * number of start events is pending. Each start event starts all UDP pings with that start time.
+ */
+void UdpPingScheduler::ScheduleStartEvents() {
     int64_t now_ns = Simulator::Now().GetNanoSeconds();
-    NS_ABORT_UNLESS(now_ns == entry.GetStartTimeNs());
+    while (m_num_pending_start_events < m_start_lookahead_events && m_next_start_event_idx < m_schedule.size()) {
+        int64_t start_time_ns = m_schedule.at(m_next_start_event_idx).GetStartTimeNs();
+        Simulator::Schedule(
+                NanoSeconds(start_time_ns - now_ns),
+                &UdpPingScheduler::StartNextUdpPing, this,
+                (int) m_next_start_event_idx
+        );
+        m_num_pending_start_events += 1;
+        while (m_next_start_event_idx < m_schedule.size() && m_schedule.at(m_next_start_event_idx).GetStartTimeNs() == start_time_ns) {
+            m_next_start_event_idx += 1;
+        }
+    }
+}
+
+/**
+ * Start a UDP ping right now.
+ *
+ * @param entry     Schedule entry of the UDP ping
+ */
+void UdpPingScheduler::StartUdpPing(UdpPingInfo& entry) {
 
     // Helper to install the source application
     UdpPingClientHelper client(
@@ -40,6 +83,7 @@ void UdpPingScheduler::StartNextUdpPing(int i) {
     );
 
     // Install it on the node and start it right now
+    client.SetAttribute("EnablePerPingLogging", BooleanValue(m_enable_per_ping_logging));
     ApplicationContainer app = client.Install(m_nodes.Get(entry.GetFromNodeId()));
     Ptr<UdpPingClient> udpPingClient = app.Get(0)->GetObject<UdpPingClient>();
     udpPingClient->SetUdpSocketGenerator(m_udpSocketGenerator);
@@ -47,16 +91,44 @@ void UdpPingScheduler::StartNextUdpPing(int i) {
     app.Start(NanoSeconds(0));
     m_apps.push_back(app);
 
-    // If there is a next flow to start, schedule its start
-    if (i + 1 != (int) m_schedule.size()) {
-        int64_t next_ping_ns = m_schedule.at(i + 1).GetStartTimeNs();
-        Simulator::Schedule(
-                NanoSeconds(next_ping_ns - now_ns),
-                &UdpPingScheduler::StartNextUdpPing, this,
-                i + 1
-        );
-    }
+}
 
+/**
+ * Set up a UDP ping agent at each node from which UDP pings are sent, which sends all of them
+ * over a single socket. All UDP pings of the schedule are added to it upfront, as the agent
+ * itself keeps track of when each has to send next.
+ */
+void UdpPingScheduler::SetupUdpPingAgents() {
+    m_agents = std::vector<Ptr<UdpPingAgent>>(m_nodes.GetN());
+    m_agent_slots.reserve(m_schedule.size());
+    for (UdpPingInfo& entry : m_schedule) {
+
+        // Install the agent on the node if it does not yet have one
+        Ptr<UdpPingAgent> agent = m_agents.at(entry.GetFromNodeId());
+        if (agent == 0) {
+            UdpPingAgentHelper agentHelper(
+                    InetSocketAddress(m_nodes.Get(entry.GetFromNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 0) // Port 0 means an ephemeral port will be assigned
+            );
+            agentHelper.SetAttribute("EnablePerPingLogging", BooleanValue(m_enable_per_ping_logging));
+            ApplicationContainer app = agentHelper.Install(m_nodes.Get(entry.GetFromNodeId()));
+            agent = app.Get(0)->GetObject<UdpPingAgent>();
+            agent->SetUdpSocketGenerator(m_udpSocketGenerator);
+            agent->SetIpTos(m_ipTosGenerator->GenerateIpTos(UdpPingAgent::GetTypeId(), agent));
+            app.Start(NanoSeconds(0));
+            m_agents.at(entry.GetFromNodeId()) = agent;
+        }
+
+        // Add the UDP ping to it
+        m_agent_slots.push_back(agent->AddPing(
+                entry.GetUdpPingId(),
+                InetSocketAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1026),
+                entry.GetStartTimeNs(),
+                entry.GetIntervalNs(),
+                entry.GetDurationNs(),
+                entry.GetWaitAfterwardsNs()
+        ));
+
+    }
 }
 
 UdpPingScheduler::UdpPingScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) : UdpPingScheduler(
@@ -91,6 +163,17 @@ UdpPingScheduler::UdpPingScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         // Distributed run information
         m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
 
+        // Number of start events (each starting all UDP pings with the same start time) which are scheduled ahead
+        m_start_lookahead_events = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("udp_ping_start_lookahead_events", "1"));
+
+        // Whether the timestamps of each ping are kept and written to udp_pings.csv (else only the statistics of each UDP ping)
+        m_enable_per_ping_logging = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("udp_ping_enable_per_ping_logging", "true"));
+        std::cout << "  > Per-ping logging: " << (m_enable_per_ping_logging ? "enabled" : "disabled") << std::endl;
+
+        // Whether all UDP pings from a node are sent by a single agent (else each by its own client)
+        m_enable_per_node_agent = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("udp_ping_enable_per_node_agent", "false"));
+        std::cout << "  > Per-node agent: " << (m_enable_per_node_agent ? "enabled" : "disabled") << std::endl;
+
         // Read schedule
         std::vector<UdpPingInfo> complete_schedule = read_udp_ping_schedule(
                 m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("udp_ping_schedule_filename"),
@@ -119,14 +202,20 @@ UdpPingScheduler::UdpPingScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         if (m_enable_distributed) {
             m_udp_pings_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_pings.csv";
             m_udp_pings_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_pings.txt";
+            m_udp_pings_summary_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_pings_summary.csv";
+            m_udp_pings_rtt_sketch_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_udp_pings_rtt_sketch.csv";
         } else {
             m_udp_pings_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_pings.csv";
             m_udp_pings_txt_filename = m_basicSimulation->GetLogsDir() + "/udp_pings.txt";
+            m_udp_pings_summary_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_pings_summary.csv";
+            m_udp_pings_rtt_sketch_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_pings_rtt_sketch.csv";
         }
 
         // Remove files if they are there
         remove_file_if_exists(m_udp_pings_csv_filename);
         remove_file_if_exists(m_udp_pings_txt_filename);
+        remove_file_if_exists(m_udp_pings_summary_csv_filename);
+        remove_file_if_exists(m_udp_pings_rtt_sketch_csv_filename);
         printf("  > Removed previous UDP ping log files if present\n");
         m_basicSimulation->RegisterTimestamp("Remove previous UDP ping log files");
         
@@ -149,16 +238,22 @@ UdpPingScheduler::UdpPingScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         }
         m_basicSimulation->RegisterTimestamp("Setup UDP ping servers");
 
-        // Setup start of first client application
-        std::cout << "  > Schedule start of first UDP ping client" << std::endl;
-        if (m_schedule.size() > 0) {
-            Simulator::Schedule(
-                    NanoSeconds(m_schedule.at(0).GetStartTimeNs()),
-                    &UdpPingScheduler::StartNextUdpPing, this,
-                    0 // First index
-            );
+        // Either an agent at each node which sends all its UDP pings, or a client for each UDP ping
+        if (m_enable_per_node_agent) {
+            std::cout << "  > Setting up UDP ping agents" << std::endl;
+            SetupUdpPingAgents();
+            m_basicSimulation->RegisterTimestamp("Setup UDP ping agents");
+
+        } else {
+
+            // Setup start of first client application
+            std::cout << "  > Schedule start of first UDP ping client" << std::endl;
+            m_next_start_event_idx = 0;
+            m_num_pending_start_events = 0;
+            ScheduleStartEvents();
+            m_basicSimulation->RegisterTimestamp("Schedule start of first UDP ping client");
+
         }
-        m_basicSimulation->RegisterTimestamp("Schedule start of first UDP ping client");
 
     }
 
@@ -176,10 +271,15 @@ void UdpPingScheduler::WriteResults() {
 
         // Open files
         std::cout << "  > Opening UDP ping log files:" << std::endl;
-        FILE* file_csv = fopen(m_udp_pings_csv_filename.c_str(), "w+");
-        std::cout << "    >> Opened: " << m_udp_pings_csv_filename << std::endl;
+        FILE* file_csv = nullptr;
+        if (m_enable_per_ping_logging) {
+            file_csv = fopen(m_udp_pings_csv_filename.c_str(), "w+");
+            std::cout << "    >> Opened: " << m_udp_pings_csv_filename << std::endl;
+        }
         FILE* file_txt = fopen(m_udp_pings_txt_filename.c_str(), "w+");
         std::cout << "    >> Opened: " << m_udp_pings_txt_filename << std::endl;
+        FILE* file_summary_csv = fopen(m_udp_pings_summary_csv_filename.c_str(), "w+");
+        std::cout << "    >> Opened: " << m_udp_pings_summary_csv_filename << std::endl;
 
         // Header
         std::cout << "  > Writing udp_pings.txt header" << std::endl;
@@ -187,78 +287,82 @@ void UdpPingScheduler::WriteResults() {
                 "UDP ping ID", "Source", "Target", "Start time (ns)", "End time (ns)", "Interval (ns)",
                 "Mean latency there", "Mean latency back", "Min. RTT", "Mean RTT", "Max. RTT", "Smp.std. RTT", "Reply arrival");
 
-        // Go over the applications, write each ping's result
-        for (uint32_t i = 0; i < m_apps.size(); i++) {
+        // Go over the UDP pings which have started, write each ping's result
+        // (the agents have all of them, but only those which started before the end are written, as with clients)
+        LatencySketch all_rtt_sketch;
+        size_t num_candidates = m_enable_per_node_agent ? m_schedule.size() : m_apps.size();
+        for (uint32_t i = 0; i < num_candidates; i++) {
             UdpPingInfo info = m_schedule.at(i);
-            Ptr<UdpPingClient> client = m_apps.at(i).Get(0)->GetObject<UdpPingClient>();
+            if (m_enable_per_node_agent && info.GetStartTimeNs() >= m_simulation_end_time_ns) {
+                continue;
+            }
 
             // Data about this pair
             int64_t from_node_id = info.GetFromNodeId();
             int64_t to_node_id = info.GetToNodeId();
-            uint32_t sent = client->GetSent();
-            std::vector<int64_t> sendRequestTimestamps = client->GetSendRequestTimestamps();
-            std::vector<int64_t> replyTimestamps = client->GetReplyTimestamps();
-            std::vector<int64_t> receiveReplyTimestamps = client->GetReceiveReplyTimestamps();
-
-            int total = 0;
-            double sum_latency_to_there_ns = 0.0;
-            double sum_latency_from_there_ns = 0.0;
-            std::vector<int64_t> rtts_ns;
-            for (uint32_t j = 0; j < sent; j++) {
-
-                // Outcome
-                bool reply_arrived = replyTimestamps.at(j) != -1;
-                std::string reply_arrived_str = reply_arrived ? "YES" : "LOST";
-
-                // Latencies
-                int64_t latency_to_there_ns = reply_arrived ? replyTimestamps.at(j) - sendRequestTimestamps.at(j) : -1;
-                int64_t latency_from_there_ns = reply_arrived ? receiveReplyTimestamps.at(j) - replyTimestamps.at(j) : -1;
-                int64_t rtt_ns = reply_arrived ? latency_to_there_ns + latency_from_there_ns : -1;
-
-                // Write plain to the csv
-                fprintf(
-                        file_csv,
-                        "%" PRId64 ",%u,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s\n",
-                        info.GetUdpPingId(), j, sendRequestTimestamps.at(j), replyTimestamps.at(j), receiveReplyTimestamps.at(j),
-                        latency_to_there_ns, latency_from_there_ns, rtt_ns, reply_arrived_str.c_str()
-                );
-
-                // Add to statistics
-                if (reply_arrived) {
-                    total++;
-                    sum_latency_to_there_ns += latency_to_there_ns;
-                    sum_latency_from_there_ns += latency_from_there_ns;
-                    rtts_ns.push_back(rtt_ns);
-                }
 
+            // Results are either at the agent of the node (in the slot of this ping), or at its own client
+            Ptr<UdpPingAgent> agent = 0;
+            Ptr<UdpPingClient> client = 0;
+            uint32_t slot = 0;
+            if (m_enable_per_node_agent) {
+                agent = m_agents.at(from_node_id);
+                slot = m_agent_slots.at(i);
+            } else {
+                client = m_apps.at(i).Get(0)->GetObject<UdpPingClient>();
             }
+            uint32_t sent = agent != 0 ? agent->GetSentOf(slot) : client->GetSent();
+
+            // Each ping to the CSV
+            if (m_enable_per_ping_logging) {
+                const std::vector<int64_t>& sendRequestTimestamps = agent != 0 ? agent->GetSendRequestTimestampsOf(slot) : client->GetSendRequestTimestamps();
+                const std::vector<int64_t>& replyTimestamps = agent != 0 ? agent->GetReplyTimestampsOf(slot) : client->GetReplyTimestamps();
+                const std::vector<int64_t>& receiveReplyTimestamps = agent != 0 ? agent->GetReceiveReplyTimestampsOf(slot) : client->GetReceiveReplyTimestamps();
+                for (uint32_t j = 0; j < sent; j++) {
+
+                    // Outcome
+                    bool reply_arrived = replyTimestamps.at(j) != -1;
+                    std::string reply_arrived_str = reply_arrived ? "YES" : "LOST";
+
+                    // Latencies
+                    int64_t latency_to_there_ns = reply_arrived ? replyTimestamps.at(j) - sendRequestTimestamps.at(j) : -1;
+                    int64_t latency_from_there_ns = reply_arrived ? receiveReplyTimestamps.at(j) - replyTimestamps.at(j) : -1;
+                    int64_t rtt_ns = reply_arrived ? latency_to_there_ns + latency_from_there_ns : -1;
+
+                    // Write plain to the csv
+                    fprintf(
+                            file_csv,
+                            "%" PRId64 ",%u,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s\n",
+                            info.GetUdpPingId(), j, sendRequestTimestamps.at(j), replyTimestamps.at(j), receiveReplyTimestamps.at(j),
+                            latency_to_there_ns, latency_from_there_ns, rtt_ns, reply_arrived_str.c_str()
+                    );
 
-            // Finalize the statistics
-            int64_t min_rtt_ns = 10000000000000; // 10000s should be sufficiently high
-            int64_t max_rtt_ns = -1;
-            double mean_rtt_ns = (sum_latency_to_there_ns + sum_latency_from_there_ns) / total;
-            double sum_sq = 0.0;
-            for (uint32_t j = 0; j < rtts_ns.size(); j++) {
-                min_rtt_ns = std::min(min_rtt_ns, rtts_ns.at(j));
-                max_rtt_ns = std::max(max_rtt_ns, rtts_ns.at(j));
-                sum_sq += std::pow(rtts_ns.at(j) - mean_rtt_ns, 2);
-            }
-            double sample_std_rtt_ns;
-            double mean_latency_to_there_ns;
-            double mean_latency_from_there_ns;
-            if (rtts_ns.size() == 0) { // If no measurements came through, it should all be -1
-                mean_latency_to_there_ns = -1;
-                mean_latency_from_there_ns = -1;
-                min_rtt_ns = -1;
-                max_rtt_ns = -1;
-                mean_rtt_ns = -1;
-                sample_std_rtt_ns = -1;
-            } else {
-                mean_latency_to_there_ns = sum_latency_to_there_ns / total;
-                mean_latency_from_there_ns = sum_latency_from_there_ns / total;
-                sample_std_rtt_ns = rtts_ns.size() > 1 ? std::sqrt((1.0 / (rtts_ns.size() - 1)) * sum_sq) : 0.0;
+                }
             }
 
+            // Statistics were kept by the agent or client while the replies arrived
+            const RunningStatistics& rtt_statistics = agent != 0 ? agent->GetRttStatisticsOf(slot) : client->GetRttStatistics();
+            int64_t total = rtt_statistics.GetCount();
+            double mean_latency_to_there_ns = (agent != 0 ? agent->GetLatencyThereStatisticsOf(slot) : client->GetLatencyThereStatistics()).GetMean();
+            double mean_latency_from_there_ns = (agent != 0 ? agent->GetLatencyBackStatisticsOf(slot) : client->GetLatencyBackStatistics()).GetMean();
+            int64_t min_rtt_ns = rtt_statistics.GetMin();
+            double mean_rtt_ns = rtt_statistics.GetMean();
+            int64_t max_rtt_ns = rtt_statistics.GetMax();
+            double sample_std_rtt_ns = rtt_statistics.GetSampleStd();
+            const LatencySketch& rtt_sketch = agent != 0 ? agent->GetRttSketchOf(slot) : client->GetRttSketch();
+            all_rtt_sketch.Merge(rtt_sketch);
+
+            // Write plain to the summary CSV
+            fprintf(
+                    file_summary_csv,
+                    "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%f,%f,%" PRId64 ",%f,%" PRId64 ",%f,%"
+                    PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%u,%s\n",
+                    info.GetUdpPingId(), from_node_id, to_node_id, info.GetStartTimeNs(), info.GetDurationNs(), info.GetIntervalNs(),
+                    mean_latency_to_there_ns, mean_latency_from_there_ns, min_rtt_ns, mean_rtt_ns, max_rtt_ns, sample_std_rtt_ns,
+                    rtt_sketch.GetQuantile(0.5), rtt_sketch.GetQuantile(0.9), rtt_sketch.GetQuantile(0.99), rtt_sketch.GetQuantile(0.999),
+                    total, sent, info.GetMetadata().c_str()
+            );
+
             // Write nicely formatted to the text
             char str_latency_to_there_ms[100];
             sprintf(str_latency_to_there_ms, "%.2f ms", mean_latency_to_there_ns == -1 ? -1 : nanosec_to_millisec(mean_latency_to_there_ns));
@@ -276,17 +380,25 @@ void UdpPingScheduler::WriteResults() {
                     file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-18" PRId64 "%-18" PRId64 "%-18" PRId64 "%-22s%-22s%-16s%-16s%-16s%-16s%d/%d (%d%%)\n",
                     info.GetUdpPingId(), from_node_id, to_node_id, info.GetStartTimeNs(), info.GetStartTimeNs() + info.GetDurationNs(),
                     info.GetIntervalNs(), str_latency_to_there_ms, str_latency_from_there_ms, str_min_rtt_ms, str_mean_rtt_ms, str_max_rtt_ms,
-                    str_sample_std_rtt_ms, total, sent, (int) std::round(((double) total / (double) sent) * 100.0)
+                    str_sample_std_rtt_ms, (int) total, sent, (int) std::round(((double) total / (double) sent) * 100.0)
             );
 
         }
 
         // Close files
         std::cout << "  > Closing UDP ping log files:" << std::endl;
-        fclose(file_csv);
-        std::cout << "    >> Closed: " << m_udp_pings_csv_filename << std::endl;
+        if (m_enable_per_ping_logging) {
+            fclose(file_csv);
+            std::cout << "    >> Closed: " << m_udp_pings_csv_filename << std::endl;
+        }
         fclose(file_txt);
         std::cout << "    >> Closed: " << m_udp_pings_txt_filename << std::endl;
+        fclose(file_summary_csv);
+        std::cout << "    >> Closed: " << m_udp_pings_summary_csv_filename << std::endl;
+
+        // RTT sketch of all pings of this system together
+        all_rtt_sketch.WriteToFile(m_udp_pings_rtt_sketch_csv_filename);
+        std::cout << "    >> Written: " << m_udp_pings_rtt_sketch_csv_filename << std::endl;
 
         // Register completion
         std::cout << "  > UDP ping log files have been written" << std::endl;
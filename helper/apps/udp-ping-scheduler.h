@@ -44,6 +44,9 @@ public:
     void WriteResults();
 
 protected:
+    void ScheduleStartEvents();
+    void StartUdpPing(UdpPingInfo& entry);
+    void SetupUdpPingAgents();
     Ptr<BasicSimulation> m_basicSimulation;
     int64_t m_simulation_end_time_ns;
     Ptr<Topology> m_topology = nullptr;
@@ -53,10 +56,19 @@ protected:
 
     NodeContainer m_nodes;
     std::vector<UdpPingInfo> m_schedule;
+    int64_t m_start_lookahead_events;
+    size_t m_next_start_event_idx; // Index in the schedule of the first UDP ping whose start event is not yet scheduled
+    int64_t m_num_pending_start_events;
     std::vector<ApplicationContainer> m_apps;
+    bool m_enable_per_node_agent;
+    std::vector<Ptr<UdpPingAgent>> m_agents; // Per node (0 if it does not send any UDP ping), only used if per-node agent
+    std::vector<uint32_t> m_agent_slots; // Per UDP ping in the schedule its slot at the agent of its node, only used if per-node agent
     bool m_enable_distributed;
+    bool m_enable_per_ping_logging;
     std::string m_udp_pings_csv_filename;
     std::string m_udp_pings_txt_filename;
+    std::string m_udp_pings_summary_csv_filename;
+    std::string m_udp_pings_rtt_sketch_csv_filename;
 };
 
 }
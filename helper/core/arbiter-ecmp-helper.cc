@@ -26,14 +26,73 @@ void ArbiterEcmpHelper::InstallArbiters (Ptr<BasicSimulation> basicSimulation, P
 
     NodeContainer nodes = topology->GetNodes();
 
+    // Number of threads used to calculate the routing state (default: all available hardware threads)
+    int64_t default_num_threads = std::max((int64_t) 1, (int64_t) std::thread::hardware_concurrency());
+    int64_t num_threads = parse_geq_one_int64(basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_num_threads", std::to_string(default_num_threads)));
+
+    // Which routing state to calculate
+    std::string mode = basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_mode", "forwarding_table");
+    if (mode != "forwarding_table" && mode != "distance_labels") {
+        throw std::invalid_argument("Unknown ECMP arbiter mode: " + mode);
+    }
+
+    // Directory of the forwarding table cache ("none" to disable, relative paths are relative to the run directory)
+    std::string cache_dir = basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_forwarding_table_cache_dir", "none");
+    if (cache_dir != "none" && cache_dir.size() > 0 && cache_dir[0] != '/') {
+        cache_dir = basicSimulation->GetRunDir() + "/" + cache_dir;
+    }
+
     // Calculate and instantiate the routing
-    std::cout << "  > Calculating ECMP routing" << std::endl;
-    std::vector<std::vector<std::vector<uint32_t>>> global_ecmp_state = CalculateGlobalState(topology);
-    basicSimulation->RegisterTimestamp("Calculate ECMP routing state");
+    std::cout << "  > Calculating ECMP routing " << mode << " (using " << num_threads << " thread(s))" << std::endl;
+    Ptr<ArbiterEcmpForwardingTable> forwarding_table;
+    Ptr<ArbiterEcmpDistanceLabels> distance_labels;
+    if (mode == "forwarding_table") {
+        forwarding_table = CalculateGlobalState(basicSimulation, topology, num_threads, cache_dir);
+        printf(
+                "    >> Forwarding table has %" PRIu64 " candidate next hops (%s-bit entries) of %" PRId64 " node(s)\n",
+                forwarding_table->GetTotalNumCandidates(),
+                forwarding_table->IsUsingCompactNextHops() ? "16" : "32",
+                forwarding_table->GetNumStoredNodes()
+        );
+    } else {
+        distance_labels = CalculateDistanceLabels(basicSimulation, topology, num_threads);
+        printf(
+                "    >> Distance labels towards %" PRIu64 " destinations use %" PRId64 " labels\n",
+                topology->GetEndpoints().size(),
+                distance_labels->GetNumLabels()
+        );
+    }
+
+    // Optional per-flow next-hop decision cache in each arbiter (0 = disabled)
+    int64_t flow_cache_size = parse_positive_int64(basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_flow_cache_size", "0"));
+    if (flow_cache_size > 0) {
+        std::cout << "  > Flow cache size per arbiter... " << flow_cache_size << " entries" << std::endl;
+    } else {
+        std::cout << "  > Flow cache is disabled" << std::endl;
+    }
 
-    std::cout << "  > Setting the routing arbiter on each node" << std::endl;
+    // Optionally attach the ports in a tag on the sender, such that the next hops do not need to read the header
+    bool flow_tag_enabled = parse_boolean(basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_enable_flow_tag", "false"));
+    std::cout << "  > Flow tag is " << (flow_tag_enabled ? "enabled" : "disabled") << std::endl;
+
+    // If distributed, the nodes of the other systems never make a forwarding decision in this system
+    std::cout << "  > Setting the routing arbiter on each node" << (basicSimulation->IsDistributedEnabled() ? " of this system" : "") << std::endl;
     for (int i = 0; i < topology->GetNumNodes(); i++) {
-        Ptr<ArbiterEcmp> arbiterEcmp = CreateObject<ArbiterEcmp>(nodes.Get(i), nodes, topology, global_ecmp_state[i]);
+        if (basicSimulation->IsDistributedEnabled() && !basicSimulation->IsNodeAssignedToThisSystem(i)) {
+            continue;
+        }
+        Ptr<ArbiterEcmp> arbiterEcmp;
+        if (forwarding_table) {
+            arbiterEcmp = CreateObject<ArbiterEcmp>(nodes.Get(i), nodes, topology, forwarding_table);
+        } else {
+            arbiterEcmp = CreateObject<ArbiterEcmp>(nodes.Get(i), nodes, topology, distance_labels);
+        }
+        if (flow_cache_size > 0) {
+            arbiterEcmp->EnableFlowCache(flow_cache_size);
+        }
+        if (flow_tag_enabled) {
+            arbiterEcmp->EnableFlowTag();
+        }
         nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiterEcmp);
     }
     basicSimulation->RegisterTimestamp("Setup routing arbiter on each node");
@@ -41,87 +100,331 @@ void ArbiterEcmpHelper::InstallArbiters (Ptr<BasicSimulation> basicSimulation, P
     std::cout << std::endl;
 }
 
-// This is static
-std::vector<std::vector<std::vector<uint32_t>>> ArbiterEcmpHelper::CalculateGlobalState(Ptr<TopologyPtop> topology) {
+/**
+ * Write the hit and miss counters of the flow cache of each ECMP arbiter
+ * (of the nodes assigned to this system) to arbiter_ecmp_flow_cache.csv,
+ * with each line being: node_id,cache_size,hits,misses
+ *
+ * @param basicSimulation           Basic simulation
+ * @param topology                  Point-to-point topology on which the ECMP arbiters were installed
+ */
+void ArbiterEcmpHelper::WriteFlowCacheResults (Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology) {
+    std::cout << "ECMP FLOW CACHE RESULTS" << std::endl;
 
-    // Final result
-    std::vector<std::vector<std::vector<uint32_t>>> global_candidate_list;
+    // Exit if not enabled
+    if (parse_positive_int64(basicSimulation->GetConfigParamOrDefault("arbiter_ecmp_flow_cache_size", "0")) == 0) {
+        std::cout << "  > Not enabled, so no results are written" << std::endl;
+        std::cout << std::endl;
+        return;
+    }
 
-    ///////////////////////////
-    // Floyd-Warshall
+    // Filename
+    std::string filename_flow_cache_csv;
+    if (basicSimulation->IsDistributedEnabled()) {
+        filename_flow_cache_csv = basicSimulation->GetLogsDir() + "/system_" + std::to_string(basicSimulation->GetSystemId()) + "_arbiter_ecmp_flow_cache.csv";
+    } else {
+        filename_flow_cache_csv = basicSimulation->GetLogsDir() + "/arbiter_ecmp_flow_cache.csv";
+    }
 
-    int64_t n = topology->GetNumNodes();
+    // Write the counters of each arbiter
+    FILE* file_flow_cache_csv = fopen(filename_flow_cache_csv.c_str(), "w+");
+    std::cout << "  > Opened: " << filename_flow_cache_csv << std::endl;
+    int64_t total_hits = 0;
+    int64_t total_misses = 0;
+    for (int64_t i = 0; i < topology->GetNumNodes(); i++) {
+        if (basicSimulation->IsDistributedEnabled() && !basicSimulation->IsNodeAssignedToThisSystem(i)) {
+            continue;
+        }
+        Ptr<ArbiterEcmp> arbiterEcmp = topology->GetNodes().Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->GetObject<ArbiterEcmp>();
+        if (!arbiterEcmp) {
+            continue; // Arbiter was replaced by one which is not ECMP
+        }
+        fprintf(
+                file_flow_cache_csv,
+                "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
+                i, arbiterEcmp->GetFlowCacheSize(), arbiterEcmp->GetFlowCacheHits(), arbiterEcmp->GetFlowCacheMisses()
+        );
+        total_hits += arbiterEcmp->GetFlowCacheHits();
+        total_misses += arbiterEcmp->GetFlowCacheMisses();
+    }
+    fclose(file_flow_cache_csv);
 
-    // Enforce that more than 40000 nodes is not permitted (sqrt(2^31) ~= 46340, so let's call it an even 40000)
-    if (n > 40000) {
-        throw std::runtime_error("Cannot handle more than 40000 nodes");
+    // Overall hit rate
+    std::cout << "  > Total hits... " << total_hits << std::endl;
+    std::cout << "  > Total misses... " << total_misses << std::endl;
+    if (total_hits + total_misses > 0) {
+        printf("  > Hit rate... %.2f%%\n", 100.0 * total_hits / (total_hits + total_misses));
     }
+    basicSimulation->RegisterTimestamp("Write ECMP flow cache results");
+
+    std::cout << std::endl;
+}
 
-    // Initialize with 0 distance to itself, and infinite distance to all others
-    int32_t n2 = n * n;
-    int32_t* dist = new int32_t[n2];
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j) {
-                dist[n * i + j] = 0;
-            } else {
-                dist[n * i + j] = 100000000;
+/**
+ * Flatten the adjacency lists of the topology into two contiguous arrays,
+ * such that the neighbors of node i are at [offsets[i], offsets[i + 1])
+ * in the neighbors array (in ascending order of node identifier).
+ *
+ * @param topology                  Point-to-point topology
+ * @param adjacency_offsets         Offset of each node's neighbors in the neighbors array (output, size: n + 1)
+ * @param adjacency_neighbors       All neighbors of all nodes (output)
+ */
+void ArbiterEcmpHelper::FlattenAdjacencyLists(Ptr<TopologyPtop> topology, std::vector<int64_t>& adjacency_offsets, std::vector<uint32_t>& adjacency_neighbors) {
+    adjacency_offsets.clear();
+    adjacency_neighbors.clear();
+    adjacency_offsets.reserve(topology->GetNumNodes() + 1);
+    adjacency_neighbors.reserve(topology->GetNumUndirectedEdges() * 2);
+    adjacency_offsets.push_back(0);
+    for (const std::set<int64_t>& adjacency_list : topology->GetAllAdjacencyLists()) {
+        for (int64_t neighbor_id : adjacency_list) {
+            adjacency_neighbors.push_back((uint32_t) neighbor_id);
+        }
+        adjacency_offsets.push_back(adjacency_neighbors.size());
+    }
+}
+
+/**
+ * Unweighted breadth-first search from a source node.
+ *
+ * @param adjacency_offsets         Offset of each node's neighbors in the neighbors array (size: n + 1)
+ * @param adjacency_neighbors       All neighbors of all nodes
+ * @param source_node_id            Node from which to start
+ * @param dist                      Hop distance of each node to the source, -1 if unreachable (output, size: n)
+ * @param queue                     Scratch space (size: n)
+ */
+void ArbiterEcmpHelper::BreadthFirstSearch(
+        const std::vector<int64_t>& adjacency_offsets,
+        const std::vector<uint32_t>& adjacency_neighbors,
+        int64_t source_node_id,
+        std::vector<int64_t>& dist,
+        std::vector<uint32_t>& queue
+) {
+    std::fill(dist.begin(), dist.end(), -1);
+    dist[source_node_id] = 0;
+    queue[0] = (uint32_t) source_node_id;
+    int64_t queue_head = 0;
+    int64_t queue_tail = 1;
+    while (queue_head < queue_tail) {
+        uint32_t a = queue[queue_head++];
+        for (int64_t k = adjacency_offsets[a]; k < adjacency_offsets[a + 1]; k++) {
+            uint32_t b = adjacency_neighbors[k];
+            if (dist[b] == -1) {
+                dist[b] = dist[a] + 1;
+                queue[queue_tail++] = b;
             }
         }
     }
+}
 
-    // If there is an edge, the distance is 1
-    for (std::pair<int64_t, int64_t> edge : topology->GetUndirectedEdges()) {
-        dist[n * edge.first + edge.second] = 1;
-        dist[n * edge.second + edge.first] = 1;
+/**
+ * Run a pool of worker threads, and wait for them to finish. Each worker repeatedly claims
+ * the next task which has not yet been processed from the shared counter, until the counter
+ * exceeds the number of tasks.
+ *
+ * @param num_threads       Number of worker threads
+ * @param num_tasks         Number of tasks
+ * @param worker            Worker function (argument: shared counter of the next task)
+ */
+void ArbiterEcmpHelper::RunWorkers(int64_t num_threads, int64_t num_tasks, const std::function<void(std::atomic<int64_t>&)>& worker) {
+    std::atomic<int64_t> next_task(0);
+    std::vector<std::thread> workers;
+    int64_t num_workers = std::min(num_threads, std::max((int64_t) 1, num_tasks));
+    for (int64_t i = 0; i < num_workers; i++) {
+        workers.push_back(std::thread(worker, std::ref(next_task)));
+    }
+    for (std::thread& w : workers) {
+        w.join();
     }
+}
 
-    // Floyd-Warshall core
-    for (int k = 0; k < n; k++) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                if (dist[n * i + j] > dist[n * i + k] + dist[n * k + j]) {
-                    dist[n * i + j] = dist[n * i + k] + dist[n * k + j];
-                }
-            }
+/**
+ * Calculate the key of the inputs of the forwarding table, which identifies its cache file.
+ * It is the 64-bit FNV-1a hash of the format version, the (flattened) adjacency lists and the stored nodes.
+ *
+ * @param adjacency_offsets         Offset of each node's neighbors in the neighbors array (size: n + 1)
+ * @param adjacency_neighbors       All neighbors of all nodes
+ * @param stored_nodes              For each node, whether its row is stored
+ *
+ * @return Cache key
+ */
+uint64_t ArbiterEcmpHelper::CalculateCacheKey(
+        const std::vector<int64_t>& adjacency_offsets,
+        const std::vector<uint32_t>& adjacency_neighbors,
+        const std::vector<bool>& stored_nodes
+) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto hash_bytes = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*) data;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
         }
+    };
+    hash_bytes("BSFT1", 5);
+    hash_bytes(adjacency_offsets.data(), adjacency_offsets.size() * sizeof(int64_t));
+    hash_bytes(adjacency_neighbors.data(), adjacency_neighbors.size() * sizeof(uint32_t));
+    for (bool stored : stored_nodes) {
+        unsigned char b = stored ? 1 : 0;
+        hash_bytes(&b, 1);
     }
+    return hash;
+}
 
-    ///////////////////////////
-    // Determine from the shortest path distances
-    // the possible next hops
+// This is static
+Ptr<ArbiterEcmpForwardingTable> ArbiterEcmpHelper::CalculateGlobalState(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, int64_t num_threads, std::string cache_dir) {
+    int64_t n = topology->GetNumNodes();
 
-    // ECMP candidate list: candidate_list[current][destination] = [ list of next hops ]
-    global_candidate_list.reserve(topology->GetNumNodes());
-    for (int i = 0; i < topology->GetNumNodes(); i++) {
-        std::vector<std::vector<uint32_t>> v;
-        v.reserve(topology->GetNumNodes());
-        for (int j = 0; j < topology->GetNumNodes(); j++) {
-            v.push_back(std::vector<uint32_t>());
-        }
-        global_candidate_list.push_back(v);
+    // Node identifiers are stored as uint32_t in the forwarding table
+    if (n > (int64_t) UINT32_MAX) {
+        throw std::runtime_error("Cannot handle more nodes than fit in an unsigned 32-bit integer");
     }
 
+    // Flatten adjacency lists
+    std::vector<int64_t> adjacency_offsets;
+    std::vector<uint32_t> adjacency_neighbors;
+    FlattenAdjacencyLists(topology, adjacency_offsets, adjacency_neighbors);
+    basicSimulation->RegisterTimestamp("Calculate ECMP routing state: flatten adjacency lists");
+
+    ///////////////////////////
+    // The forwarding table is built in two passes of breadth-first search from each destination:
+    // the first counts the candidate next hops, after which the exact amount of memory is allocated,
+    // and the second fills them in. This avoids any intermediate per-(node, destination) list.
+    //
     // Candidate next hops are determined in the following way:
     // For each edge a -> b, for a destination t:
     // If the shortest_path_distance(b, t) == shortest_path_distance(a, t) - 1
     // then a -> b must be part of a shortest path from a towards t.
-    for (std::pair<int64_t, int64_t> edge : topology->GetUndirectedEdges()) {
-        for (int j = 0; j < n; j++) {
-            if (dist[edge.first * n + j] - 1 == dist[edge.second * n + j]) {
-                global_candidate_list.at(edge.first).at(j).push_back(edge.second);
+    //
+    // Each destination is a distinct column of the forwarding table,
+    // as such workers never write to the same entries.
+    //
+    // If distributed, only the rows of the nodes of this system are calculated and stored.
+
+    std::vector<bool> stored_nodes(n, true);
+    if (basicSimulation->IsDistributedEnabled()) {
+        for (int64_t a = 0; a < n; a++) {
+            stored_nodes[a] = basicSimulation->IsNodeAssignedToThisSystem(a);
+        }
+    }
+
+    // Use the cached forwarding table if it was calculated before from the same inputs
+    // (if it cannot be used, e.g., because it is truncated or corrupt, it is calculated and written again)
+    std::string cache_filename;
+    uint64_t cache_key = 0;
+    if (cache_dir != "none") {
+        cache_key = CalculateCacheKey(adjacency_offsets, adjacency_neighbors, stored_nodes);
+        cache_filename = cache_dir + "/ecmp_forwarding_table_" + format_string("%016" PRIx64, cache_key) + ".bin";
+        if (file_exists(cache_filename)) {
+            try {
+                Ptr<ArbiterEcmpForwardingTable> cached_forwarding_table = CreateObject<ArbiterEcmpForwardingTable>(cache_filename, cache_key);
+                std::cout << "    >> Loaded from cache: " << cache_filename << std::endl;
+                basicSimulation->RegisterTimestamp("Calculate ECMP routing state: load forwarding table from cache");
+                return cached_forwarding_table;
+            } catch (std::runtime_error& e) {
+                std::cout << "    >> Not loaded from cache, calculating it instead: " << e.what() << std::endl;
             }
-            if (dist[edge.second * n + j] - 1 == dist[edge.first * n + j]) {
-                global_candidate_list.at(edge.second).at(j).push_back(edge.first);
+        }
+    }
+
+    Ptr<ArbiterEcmpForwardingTable> forwarding_table = CreateObject<ArbiterEcmpForwardingTable>(n, stored_nodes);
+    ArbiterEcmpForwardingTable* table = PeekPointer(forwarding_table); // Reference counting is not thread-safe
+    for (int pass = 0; pass < 2; pass++) {
+        bool fill_candidates = pass == 1;
+        if (fill_candidates) {
+            forwarding_table->Allocate();
+            basicSimulation->RegisterTimestamp("Calculate ECMP routing state: allocate forwarding table");
+        }
+        RunWorkers(num_threads, n, [&](std::atomic<int64_t>& next_destination) {
+            std::vector<int64_t> dist(n, -1);
+            std::vector<uint32_t> queue(n, 0);
+            int64_t t;
+            while ((t = next_destination.fetch_add(1)) < n) {
+                BreadthFirstSearch(adjacency_offsets, adjacency_neighbors, t, dist, queue);
+                for (int64_t a = 0; a < n; a++) {
+                    if (dist[a] > 0 && stored_nodes[a]) {
+                        uint32_t num_candidates = 0;
+                        for (int64_t k = adjacency_offsets[a]; k < adjacency_offsets[a + 1]; k++) {
+                            uint32_t b = adjacency_neighbors[k];
+                            if (dist[b] == dist[a] - 1) {
+                                if (fill_candidates) {
+                                    table->SetCandidate(a, t, num_candidates, b);
+                                }
+                                num_candidates++;
+                            }
+                        }
+                        if (!fill_candidates) {
+                            table->SetNumCandidates(a, t, num_candidates);
+                        }
+                    }
+                }
             }
+        });
+        basicSimulation->RegisterTimestamp(
+                fill_candidates ?
+                "Calculate ECMP routing state: breadth-first search per destination to fill candidates" :
+                "Calculate ECMP routing state: breadth-first search per destination to count candidates"
+        );
+    }
+
+    // Save it for later runs (a cache which cannot be written does not stop this run)
+    if (cache_dir != "none") {
+        try {
+            mkdir_if_not_exists(cache_dir);
+            forwarding_table->SaveToFile(cache_filename, cache_key);
+            std::cout << "    >> Saved to cache: " << cache_filename << std::endl;
+        } catch (std::runtime_error& e) {
+            std::cout << "    >> Not saved to cache: " << e.what() << std::endl;
         }
+        basicSimulation->RegisterTimestamp("Calculate ECMP routing state: save forwarding table to cache");
     }
 
-    // Free up the distance matrix
-    delete[] dist;
+    // Return the final global forwarding table
+    return forwarding_table;
+
+}
+
+// This is static
+Ptr<ArbiterEcmpDistanceLabels> ArbiterEcmpHelper::CalculateDistanceLabels(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, int64_t num_threads) {
+    int64_t n = topology->GetNumNodes();
+
+    // Flatten adjacency lists
+    std::vector<int64_t> adjacency_offsets;
+    std::vector<uint32_t> adjacency_neighbors;
+    FlattenAdjacencyLists(topology, adjacency_offsets, adjacency_neighbors);
+    basicSimulation->RegisterTimestamp("Calculate ECMP routing state: flatten adjacency lists");
+
+    // Labels towards the endpoints
+    Ptr<ArbiterEcmpDistanceLabels> distance_labels = CreateObject<ArbiterEcmpDistanceLabels>(
+            n, adjacency_offsets, adjacency_neighbors, topology->GetEndpoints(), topology->GetServers()
+    );
+    basicSimulation->RegisterTimestamp("Calculate ECMP routing state: allocate distance labels");
+
+    // Breadth-first search from each label node (each label is written by exactly one worker)
+    ArbiterEcmpDistanceLabels* labels = PeekPointer(distance_labels); // Reference counting is not thread-safe
+    int64_t num_labels = distance_labels->GetNumLabels();
+    std::atomic<bool> distance_too_large(false);
+    RunWorkers(num_threads, num_labels, [&](std::atomic<int64_t>& next_label) {
+        std::vector<int64_t> dist(n, -1);
+        std::vector<uint32_t> queue(n, 0);
+        int64_t l;
+        while ((l = next_label.fetch_add(1)) < num_labels) {
+            BreadthFirstSearch(adjacency_offsets, adjacency_neighbors, labels->GetLabelNodeId(l), dist, queue);
+            for (int64_t x = 0; x < n; x++) {
+                if (dist[x] >= ArbiterEcmpDistanceLabels::UNREACHABLE) {
+                    distance_too_large = true;
+                } else if (dist[x] != -1) {
+                    labels->SetDistance(l, x, dist[x]);
+                }
+            }
+        }
+    });
+    if (distance_too_large) {
+        throw std::runtime_error(format_string(
+                "ECMP distance labels can only store shortest path distances up to %d hops", ArbiterEcmpDistanceLabels::UNREACHABLE - 1
+        ));
+    }
+    basicSimulation->RegisterTimestamp("Calculate ECMP routing state: breadth-first search per label");
 
-    // Return the final global candidate list
-    return global_candidate_list;
+    return distance_labels;
 
 }
 
@@ -20,6 +20,9 @@
 #ifndef ARBITER_ECMP_HELPER_H
 #define ARBITER_ECMP_HELPER_H
 
+#include <thread>
+#include <atomic>
+#include <functional>
 #include "ns3/ipv4-routing-helper.h"
 #include "ns3/basic-simulation.h"
 #include "ns3/topology-ptop.h"
@@ -32,8 +35,24 @@ namespace ns3 {
     {
     public:
         static void InstallArbiters (Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology);
+        static void WriteFlowCacheResults (Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology);
     private:
-        static std::vector<std::vector<std::vector<uint32_t>>> CalculateGlobalState(Ptr<TopologyPtop> topology);
+        static void FlattenAdjacencyLists(Ptr<TopologyPtop> topology, std::vector<int64_t>& adjacency_offsets, std::vector<uint32_t>& adjacency_neighbors);
+        static void BreadthFirstSearch(
+                const std::vector<int64_t>& adjacency_offsets,
+                const std::vector<uint32_t>& adjacency_neighbors,
+                int64_t source_node_id,
+                std::vector<int64_t>& dist,
+                std::vector<uint32_t>& queue
+        );
+        static void RunWorkers(int64_t num_threads, int64_t num_tasks, const std::function<void(std::atomic<int64_t>&)>& worker);
+        static uint64_t CalculateCacheKey(
+                const std::vector<int64_t>& adjacency_offsets,
+                const std::vector<uint32_t>& adjacency_neighbors,
+                const std::vector<bool>& stored_nodes
+        );
+        static Ptr<ArbiterEcmpForwardingTable> CalculateGlobalState(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, int64_t num_threads, std::string cache_dir);
+        static Ptr<ArbiterEcmpDistanceLabels> CalculateDistanceLabels(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, int64_t num_threads);
     };
 
 } // namespace ns3
@@ -52,6 +52,7 @@ namespace ns3 {
         m_queueFactoryB.SetTypeId("ns3::DropTailQueue<Packet>");
         m_deviceFactoryB.SetTypeId("ns3::PointToPointNetDevice");
         m_channelFactory.SetTypeId("ns3::PointToPointChannel");
+        m_numRemoteChannelsInstalled = 0;
     }
 
     void
@@ -137,6 +138,7 @@ namespace ns3 {
             mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devB));
             devA->AggregateObject (mpiRecA);
             devB->AggregateObject (mpiRecB);
+            m_numRemoteChannelsInstalled++;
           }
 #else
         channel = m_channelFactory.Create<PointToPointChannel>();
@@ -150,4 +152,14 @@ namespace ns3 {
         return container;
     }
 
+    /**
+     * Number of remote channels (links which are not entirely within this system) created by Install so far.
+     *
+     * @return Number of remote channels installed
+     */
+    uint32_t
+    PointToPointAbHelper::GetNumRemoteChannelsInstalled() {
+        return m_numRemoteChannelsInstalled;
+    }
+
 } // namespace ns3
@@ -50,12 +50,15 @@ namespace ns3 {
 
         NetDeviceContainer Install(Ptr <Node> a, Ptr <Node> b);
 
+        uint32_t GetNumRemoteChannelsInstalled();
+
     private:
         ObjectFactory m_queueFactoryA;         //!< Queue Factory A
         ObjectFactory m_deviceFactoryA;        //!< Device Factory A
         ObjectFactory m_queueFactoryB;         //!< Queue Factory B
         ObjectFactory m_deviceFactoryB;        //!< Device Factory B
         ObjectFactory m_channelFactory;        //!< Channel Factory
+        uint32_t m_numRemoteChannelsInstalled; //!< Number of remote channels created by Install
     };
 
 } // namespace ns3
@@ -25,6 +25,8 @@
 #include "ns3/topology-ptop.h"
 #include "ns3/qdisc-queue-tracker.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/log-output-sink.h"
+#include "ns3/interval-log-spill.h"
 
 namespace ns3 {
 
@@ -40,7 +42,9 @@ namespace ns3 {
         Ptr<BasicSimulation> m_basicSimulation;
         Ptr<TopologyPtop> m_topology;
         bool m_enabled;
+        Ptr<IntervalLogSpill> m_spill; // Only set if streaming (else: 0)
 
+        LogOutputFormat m_log_output_format;
         std::string m_filename_link_interface_tc_qdisc_queue_pkt_csv;
         std::string m_filename_link_interface_tc_qdisc_queue_byte_csv;
 
@@ -51,16 +51,32 @@ namespace ns3 {
             enable_for_links_set = parse_set_directed_pair_positive_int64(enable_for_links_str);
         }
 
+        // Streaming: bound the number of finalized intervals each tracker keeps in memory (0: keep all)
+        int64_t max_intervals_in_memory = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("link_net_device_queue_tracking_max_intervals_in_memory", "0"));
+        if (max_intervals_in_memory > 0) {
+            std::string spill_filename = m_basicSimulation->GetLogsDir() + "/" + (m_enable_distributed ? "system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_" : "") + "link_net_device_queue_spill.bin";
+            m_spill = CreateObject<IntervalLogSpill>(spill_filename);
+            std::cout << "  > Streaming: at most " << max_intervals_in_memory << " intervals in memory per log, spilling to " << spill_filename << std::endl;
+        }
+
         // Enable it for links in the set
         for (std::pair<int64_t, int64_t> p : enable_for_links_set) {
             if (!m_enable_distributed || m_basicSimulation->IsNodeAssignedToThisSystem(p.first)) {
-                Ptr<QueueTracker> tracker_a_b = CreateObject<QueueTracker>(m_topology->GetSendingNetDeviceForLink(p)->GetQueue());
+                Ptr<QueueTracker> tracker_a_b;
+                if (m_spill == 0) {
+                    tracker_a_b = CreateObject<QueueTracker>(m_topology->GetSendingNetDeviceForLink(p)->GetQueue());
+                } else {
+                    tracker_a_b = CreateObject<QueueTracker>(m_topology->GetSendingNetDeviceForLink(p)->GetQueue(), m_spill, max_intervals_in_memory);
+                }
                 m_queue_trackers.push_back(std::make_pair(p, tracker_a_b));
             }
         }
         std::cout << "  > Tracking queue on " << m_queue_trackers.size() << " point-to-point network devices" << std::endl;
         m_basicSimulation->RegisterTimestamp("Install link (net-device) queue trackers");
 
+        // Output format
+        m_log_output_format = parse_log_output_format(m_basicSimulation->GetConfigParamOrDefault("log_output_format", "csv"));
+
         // Determine filenames
         if (m_enable_distributed) {
             m_filename_link_net_device_queue_pkt_csv = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_link_net_device_queue_pkt.csv";
@@ -69,6 +85,8 @@ namespace ns3 {
             m_filename_link_net_device_queue_pkt_csv = m_basicSimulation->GetLogsDir() + "/link_net_device_queue_pkt.csv";
             m_filename_link_net_device_queue_byte_csv = m_basicSimulation->GetLogsDir() + "/link_net_device_queue_byte.csv";
         }
+        m_filename_link_net_device_queue_pkt_csv = get_log_output_filename(m_filename_link_net_device_queue_pkt_csv, m_log_output_format);
+        m_filename_link_net_device_queue_byte_csv = get_log_output_filename(m_filename_link_net_device_queue_byte_csv, m_log_output_format);
 
         // Remove files if they are there
         remove_file_if_exists(m_filename_link_net_device_queue_pkt_csv);
@@ -90,11 +108,18 @@ namespace ns3 {
             return;
         }
 
-        // Open CSV files
+        // Open log files
         std::cout << "  > Opening link (net-device) queue log files:" << std::endl;
-        FILE* file_link_net_device_queue_pkt_csv = fopen(m_filename_link_net_device_queue_pkt_csv.c_str(), "w+");
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>();
+        Ptr<LogOutputSink> sink_link_net_device_queue_pkt = CreateLogOutputSink(
+                m_log_output_format, writer, m_filename_link_net_device_queue_pkt_csv,
+                {"from_node_id", "to_node_id", "interval_start_ns", "interval_end_ns", "num_packets"}
+        );
         std::cout << "    >> Opened: " << m_filename_link_net_device_queue_pkt_csv << std::endl;
-        FILE* file_link_net_device_queue_byte_csv = fopen(m_filename_link_net_device_queue_byte_csv.c_str(), "w+");
+        Ptr<LogOutputSink> sink_link_net_device_queue_byte = CreateLogOutputSink(
+                m_log_output_format, writer, m_filename_link_net_device_queue_byte_csv,
+                {"from_node_id", "to_node_id", "interval_start_ns", "interval_end_ns", "num_bytes"}
+        );
         std::cout << "    >> Opened: " << m_filename_link_net_device_queue_byte_csv << std::endl;
 
         // Sort
@@ -117,46 +142,25 @@ namespace ns3 {
             // Tracker
             Ptr<QueueTracker> tracker = m_queue_trackers.at(i).second;
 
-            // Queue size in packets
-            const std::vector<std::tuple<int64_t, int64_t, int64_t>> log_entries_pkt = tracker->GetIntervalsNumPackets();
-            for (size_t j = 0; j < log_entries_pkt.size(); j++) {
-
-                // Write plain to the CSV file:
-                // <from>,<to>,<interval start (ns)>,<interval end (ns)>,<number of packets>
-                fprintf(file_link_net_device_queue_pkt_csv,
-                        "%d,%d,%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
-                        (int) directed_edge.first,
-                        (int) directed_edge.second,
-                        std::get<0>(log_entries_pkt.at(j)),
-                        std::get<1>(log_entries_pkt.at(j)),
-                        std::get<2>(log_entries_pkt.at(j))
-                );
-            }
-
-            // Queue size in byte
-            const std::vector<std::tuple<int64_t, int64_t, int64_t>> log_entries_byte = tracker->GetIntervalsNumBytes();
-            for (size_t j = 0; j < log_entries_byte.size(); j++) {
-
-                // Write plain to the CSV file:
-                // <from>,<to>,<interval start (ns)>,<interval end (ns)>,<number of bytes>
-                fprintf(file_link_net_device_queue_byte_csv,
-                        "%d,%d,%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
-                        (int) directed_edge.first,
-                        (int) directed_edge.second,
-                        std::get<0>(log_entries_byte.at(j)),
-                        std::get<1>(log_entries_byte.at(j)),
-                        std::get<2>(log_entries_byte.at(j))
-                );
-            }
+            // Queue size in packets:
+            // <from>,<to>,<interval start (ns)>,<interval end (ns)>,<number of packets>
+            tracker->WriteIntervalsNumPackets(sink_link_net_device_queue_pkt, {directed_edge.first, directed_edge.second});
 
+            // Queue size in byte:
+            // <from>,<to>,<interval start (ns)>,<interval end (ns)>,<number of bytes>
+            tracker->WriteIntervalsNumBytes(sink_link_net_device_queue_byte, {directed_edge.first, directed_edge.second});
 
         }
 
         // Close log files
         std::cout << "  > Closing link (net-device) queue log files:" << std::endl;
-        fclose(file_link_net_device_queue_pkt_csv);
+        sink_link_net_device_queue_pkt->Close();
+        sink_link_net_device_queue_byte->Close();
+        writer->Close();
+        if (m_spill != 0) {
+            m_spill->Remove();
+        }
         std::cout << "    >> Closed: " << m_filename_link_net_device_queue_pkt_csv << std::endl;
-        fclose(file_link_net_device_queue_byte_csv);
         std::cout << "    >> Closed: " << m_filename_link_net_device_queue_byte_csv << std::endl;
 
         // Register completion
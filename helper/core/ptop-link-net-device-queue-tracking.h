@@ -24,6 +24,8 @@
 #include "ns3/basic-simulation.h"
 #include "ns3/topology-ptop.h"
 #include "ns3/queue-tracker.h"
+#include "ns3/log-output-sink.h"
+#include "ns3/interval-log-spill.h"
 
 namespace ns3 {
 
@@ -39,7 +41,9 @@ namespace ns3 {
         Ptr<BasicSimulation> m_basicSimulation;
         Ptr<TopologyPtop> m_topology;
         bool m_enabled;
+        Ptr<IntervalLogSpill> m_spill; // Only set if streaming (else: 0)
 
+        LogOutputFormat m_log_output_format;
         std::string m_filename_link_net_device_queue_pkt_csv;
         std::string m_filename_link_net_device_queue_byte_csv;
 
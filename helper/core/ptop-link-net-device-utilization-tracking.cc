@@ -65,6 +65,9 @@ namespace ns3 {
         std::cout << "  > Tracking utilization on " << m_utilization_trackers.size() << " point-to-point network devices" << std::endl;
         m_basicSimulation->RegisterTimestamp("Install utilization trackers");
 
+        // Output format (the TXT files are always plain text)
+        m_log_output_format = parse_log_output_format(m_basicSimulation->GetConfigParamOrDefault("log_output_format", "csv"));
+
         // Determine filenames
         if (m_enable_distributed) {
             m_filename_net_device_utilization_csv = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_link_net_device_utilization.csv";
@@ -77,6 +80,8 @@ namespace ns3 {
             m_filename_net_device_utilization_compressed_txt = m_basicSimulation->GetLogsDir() + "/link_net_device_utilization_compressed.txt";
             m_filename_net_device_utilization_summary_txt = m_basicSimulation->GetLogsDir() + "/link_net_device_utilization_summary.txt";
         }
+        m_filename_net_device_utilization_csv = get_log_output_filename(m_filename_net_device_utilization_csv, m_log_output_format);
+        m_filename_net_device_utilization_compressed_csv = get_log_output_filename(m_filename_net_device_utilization_compressed_csv, m_log_output_format);
 
         // Remove files if they are there
         remove_file_if_exists(m_filename_net_device_utilization_csv);
@@ -100,11 +105,18 @@ namespace ns3 {
             return;
         }
 
-        // Open CSV file
+        // Open log files
         std::cout << "  > Opening utilization log files:" << std::endl;
-        FILE* file_net_device_utilization_csv = fopen(m_filename_net_device_utilization_csv.c_str(), "w+");
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>();
+        Ptr<LogOutputSink> sink_net_device_utilization = CreateLogOutputSink(
+                m_log_output_format, writer, m_filename_net_device_utilization_csv,
+                {"from_node_id", "to_node_id", "interval_start_ns", "interval_end_ns", "busy_ns"}
+        );
         std::cout << "    >> Opened: " << m_filename_net_device_utilization_csv << std::endl;
-        FILE* file_net_device_utilization_compressed_csv = fopen(m_filename_net_device_utilization_compressed_csv.c_str(), "w+");
+        Ptr<LogOutputSink> sink_net_device_utilization_compressed = CreateLogOutputSink(
+                m_log_output_format, writer, m_filename_net_device_utilization_compressed_csv,
+                {"from_node_id", "to_node_id", "interval_start_ns", "interval_end_ns", "busy_ns"}
+        );
         std::cout << "    >> Opened: " << m_filename_net_device_utilization_compressed_csv << std::endl;
         FILE* file_net_device_utilization_compressed_txt = fopen(m_filename_net_device_utilization_compressed_txt.c_str(), "w+");
         std::cout << "    >> Opened: " << m_filename_net_device_utilization_compressed_txt << std::endl;
@@ -146,16 +158,16 @@ namespace ns3 {
                 utilization_busy_sum_ns += std::get<2>(intervals.at(j));
                 running_busy_sum_ns += std::get<2>(intervals.at(j));
 
-                // Write plain to the uncompressed CSV file:
+                // Write plain to the uncompressed log file:
                 // <from>,<to>,<interval start (ns)>,<interval end (ns)>,<amount of busy in this interval (ns)>
-                fprintf(file_net_device_utilization_csv,
-                        "%d,%d,%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
-                        (int) directed_edge.first,
-                        (int) directed_edge.second,
+                int64_t record[5] = {
+                        directed_edge.first,
+                        directed_edge.second,
                         std::get<0>(intervals.at(j)),
                         std::get<1>(intervals.at(j)),
                         std::get<2>(intervals.at(j))
-                );
+                };
+                sink_net_device_utilization->WriteRecord(record);
 
                 // Compressed version:
                 // Only write if it is the last one, or if the utilization is sufficiently different from the next
@@ -169,16 +181,16 @@ namespace ns3 {
                 }
                 if (print_compressed_line) {
 
-                    // Write plain to the compressed CSV file:
+                    // Write plain to the compressed log file:
                     // <from>,<to>,<interval start (ns)>,<interval end (ns)>pkt,<amount of busy in this interval (ns)>
-                    fprintf(file_net_device_utilization_compressed_csv,
-                            "%d,%d,%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
-                            (int) directed_edge.first,
-                            (int) directed_edge.second,
+                    int64_t compressed_record[5] = {
+                            directed_edge.first,
+                            directed_edge.second,
                             interval_left_side_ns,
                             std::get<1>(intervals.at(j)),
                             running_busy_sum_ns
-                    );
+                    };
+                    sink_net_device_utilization_compressed->WriteRecord(compressed_record);
 
                     // Write nicely formatted to the TXT file
                     fprintf(file_net_device_utilization_compressed_txt,
@@ -208,9 +220,10 @@ namespace ns3 {
 
         // Close log files
         std::cout << "  > Closing utilization log files:" << std::endl;
-        fclose(file_net_device_utilization_csv);
+        sink_net_device_utilization->Close();
+        sink_net_device_utilization_compressed->Close();
+        writer->Close();
         std::cout << "    >> Closed: " << m_filename_net_device_utilization_csv << std::endl;
-        fclose(file_net_device_utilization_compressed_csv);
         std::cout << "    >> Closed: " << m_filename_net_device_utilization_compressed_csv << std::endl;
         fclose(file_net_device_utilization_compressed_txt);
         std::cout << "    >> Closed: " << m_filename_net_device_utilization_compressed_txt << std::endl;
@@ -26,6 +26,7 @@
 #include "ns3/basic-simulation.h"
 #include "ns3/topology-ptop.h"
 #include "ns3/net-device-utilization-tracker.h"
+#include "ns3/log-output-sink.h"
 
 namespace ns3 {
 
@@ -43,6 +44,7 @@ namespace ns3 {
         int64_t m_utilization_interval_ns;
         bool m_enabled;
 
+        LogOutputFormat m_log_output_format;
         std::string m_filename_net_device_utilization_csv;
         std::string m_filename_net_device_utilization_compressed_csv;
         std::string m_filename_net_device_utilization_compressed_txt;
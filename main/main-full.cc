@@ -98,6 +98,9 @@ int main(int argc, char *argv[]) {
     // Write link interface traffic-control qdisc queue results
     tcQdiscQueueTracking.WriteResults();
 
+    // Write ECMP flow cache results
+    ArbiterEcmpHelper::WriteFlowCacheResults(basicSimulation, topology); // Requires arbiter_ecmp_flow_cache_size > 0
+
     // Finalize the simulation
     basicSimulation->Finalize();
 
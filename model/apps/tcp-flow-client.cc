@@ -89,6 +89,12 @@ TcpFlowClient::GetTypeId(void) {
                            StringValue (""),
                            MakeStringAccessor (&TcpFlowClient::m_baseLogsDir),
                            MakeStringChecker ())
+            .AddAttribute ("LogOutputFormat",
+                           "Format of the detailed logs with integer values (csv, binary or columnar; the file "
+                           "extension follows the format). The state and congestion state logs are always CSV.",
+                           StringValue ("csv"),
+                           MakeStringAccessor (&TcpFlowClient::m_logOutputFormat),
+                           MakeStringChecker ())
             .AddAttribute("SendStepSize", "The amount of data to send at each iteration step in the send loop.",
                           UintegerValue(100000),
                           MakeUintegerAccessor(&TcpFlowClient::m_sendStepSize),
@@ -115,6 +121,7 @@ TcpFlowClient::~TcpFlowClient() {
     NS_LOG_FUNCTION(this);
     m_tcpSocketGenerator = 0;
     m_socket = 0;
+    m_detailedLogWriter = 0;
 }
 
 void
@@ -131,6 +138,11 @@ TcpFlowClient::SetTcpSocketGenerator(Ptr<TcpSocketGenerator> tcpSocketGenerator)
     m_tcpSocketGenerator = tcpSocketGenerator;
 }
 
+void
+TcpFlowClient::SetDetailedLogWriter(Ptr<AsyncLogWriter> detailedLogWriter) {
+    m_detailedLogWriter = detailedLogWriter;
+}
+
 void
 TcpFlowClient::SetRemotePort(uint16_t remotePort) {
     NS_ABORT_MSG_UNLESS(InetSocketAddress::IsMatchingType(m_remoteAddress), "Only IPv4 is supported.");
@@ -151,6 +163,49 @@ TcpFlowClient::SetIpTos(uint8_t ipTos) {
     m_remoteAddress = newRemoteAddress;
 }
 
+void
+TcpFlowClient::SetFlowFinishedCallback(Callback<void, Ptr<TcpFlowClient>> flowFinishedCallback) {
+    m_flowFinishedCallback = flowFinishedCallback;
+}
+
+/**
+ * Re-use this client for a new TCP flow to a (possibly different) remote.
+ * Only a client whose previous flow has finished and which does not write detailed logs
+ * can be recycled. The new flow starts right now (the remote port and IP TOS can still
+ * be set before, as the start is scheduled).
+ *
+ * @param remoteAddress         Remote (server) address
+ * @param tcpFlowId             TCP flow identifier
+ * @param flowSizeByte          Total number of bytes to send
+ * @param additionalParameters  Additional parameters
+ */
+void
+TcpFlowClient::Recycle(Address remoteAddress, uint64_t tcpFlowId, uint64_t flowSizeByte, std::string additionalParameters) {
+    NS_LOG_FUNCTION(this << tcpFlowId);
+    NS_ABORT_MSG_IF(m_socket != 0 || !(m_connFailed || m_closedNormally || m_closedByError), "Only a TCP flow client whose flow has finished can be recycled");
+    NS_ABORT_MSG_IF(m_enableDetailedLoggingToFile, "A TCP flow client with detailed logging cannot be recycled");
+    NS_ABORT_MSG_IF(flowSizeByte < 1, "Flow size must be at least 1 byte");
+
+    // New parameters
+    m_remoteAddress = remoteAddress;
+    m_tcpFlowId = tcpFlowId;
+    m_flowSizeByte = flowSizeByte;
+    m_additionalParameters = additionalParameters;
+
+    // Fresh state
+    m_connected = false;
+    m_totBytes = 0;
+    m_completionTimeNs = -1;
+    m_connFailed = false;
+    m_closedNormally = false;
+    m_closedByError = false;
+    m_ackedBytes = 0;
+    m_isCompleted = false;
+
+    // Start the new flow right now (after the caller is done setting it up)
+    Simulator::ScheduleWithContext(GetNode()->GetId(), NanoSeconds(0), &TcpFlowClient::StartApplication, this);
+}
+
 void TcpFlowClient::StartApplication(void) { // Called at time specified by Start
     NS_LOG_FUNCTION(this);
 
@@ -178,36 +233,36 @@ void TcpFlowClient::StartApplication(void) { // Called at time specified by Star
         if (m_enableDetailedLoggingToFile) {
 
             // Progress
-            m_log_update_helper_progress_byte = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_progress.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_progress_byte = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("progress", "progress_byte"), {(int64_t) m_tcpFlowId});
             m_log_update_helper_progress_byte.Update(Simulator::Now().GetNanoSeconds(), GetAckedBytes());
             m_socket->GetObject<TcpSocketBase>()->GetTxBuffer()->TraceConnectWithoutContext("UnackSequence", MakeCallback(&TcpFlowClient::TxBufferUnackSequenceChange, this));
 
             // Measured RTT (ns)
-            m_log_update_helper_rtt_ns = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_rtt.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_rtt_ns = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("rtt", "rtt_ns"), {(int64_t) m_tcpFlowId});
             // At the socket creation, there is no RTT measurement, so retrieving it early will just yield 0
             // As such there "is" basically no RTT measurement till then, so we are not going to write 0
             m_socket->TraceConnectWithoutContext("RTT", MakeCallback(&TcpFlowClient::RttChange, this));
 
             // Retransmission timeout (ns)
-            m_log_update_helper_rto_ns = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_rto.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_rto_ns = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("rto", "rto_ns"), {(int64_t) m_tcpFlowId});
             m_socket->TraceConnectWithoutContext("RTO", MakeCallback(&TcpFlowClient::RtoChange, this));
 
             // Congestion window
-            m_log_update_helper_cwnd_byte = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_cwnd.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_cwnd_byte = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("cwnd", "cwnd_byte"), {(int64_t) m_tcpFlowId});
             // Congestion window is only set upon SYN reception, so retrieving it early will just yield 0
             // As such there "is" basically no congestion window till then, so we are not going to write 0
             m_socket->TraceConnectWithoutContext("CongestionWindow", MakeCallback(&TcpFlowClient::CwndChange, this));
 
             // Congestion window inflated
-            m_log_update_helper_cwnd_inflated_byte = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_cwnd_inflated.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_cwnd_inflated_byte = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("cwnd_inflated", "cwnd_inflated_byte"), {(int64_t) m_tcpFlowId});
             m_socket->TraceConnectWithoutContext("CongestionWindowInflated", MakeCallback(&TcpFlowClient::CwndInflatedChange, this));
 
             // Slow-start threshold
-            m_log_update_helper_ssthresh_byte = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_ssthresh.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_ssthresh_byte = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("ssthresh", "ssthresh_byte"), {(int64_t) m_tcpFlowId});
             m_socket->TraceConnectWithoutContext("SlowStartThreshold", MakeCallback(&TcpFlowClient::SsthreshChange, this));
 
             // In-flight
-            m_log_update_helper_inflight_byte = LogUpdateHelper<int64_t>(false, true, m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_inflight.csv", m_tcpFlowId), std::to_string(m_tcpFlowId) + ",");
+            m_log_update_helper_inflight_byte = LogUpdateHelper<int64_t>(false, CreateDetailedLogSink("inflight", "inflight_byte"), {(int64_t) m_tcpFlowId});
             m_socket->TraceConnectWithoutContext("BytesInFlight", MakeCallback(&TcpFlowClient::InflightChange, this));
 
             // State
@@ -293,7 +348,7 @@ void TcpFlowClient::ConnectionFailed(Ptr <Socket> socket) {
     m_closedNormally = false;
     m_ackedBytes = 0;
     m_isCompleted = false;
-    m_socket = 0;
+    ReleaseSocket();
 }
 
 void TcpFlowClient::DataSend(Ptr <Socket>, uint32_t) {
@@ -311,7 +366,7 @@ void TcpFlowClient::SocketClosedNormal(Ptr <Socket> socket) {
     NS_ABORT_MSG_IF(m_socket->GetObject<TcpSocketBase>()->GetTxBuffer()->Size() != 0, "Socket closed normally but send buffer is not empty");
     m_ackedBytes = m_totBytes - m_socket->GetObject<TcpSocketBase>()->GetTxBuffer()->Size();
     m_isCompleted = m_ackedBytes == m_flowSizeByte;
-    m_socket = 0;
+    ReleaseSocket();
 }
 
 void TcpFlowClient::SocketClosedError(Ptr <Socket> socket) {
@@ -321,9 +376,28 @@ void TcpFlowClient::SocketClosedError(Ptr <Socket> socket) {
     m_closedNormally = false;
     m_ackedBytes = m_totBytes - m_socket->GetObject<TcpSocketBase>()->GetTxBuffer()->Size();
     m_isCompleted = false;
+    ReleaseSocket();
+}
+
+void TcpFlowClient::ReleaseSocket() {
+    if (!m_flowFinishedCallback.IsNull()) {
+
+        // The client might be recycled, so the (still closing) socket must no longer call back into it
+        m_socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+
+        // Notify outside of the socket call stack, as the client might be started again immediately
+        Simulator::ScheduleNow(&TcpFlowClient::NotifyFlowFinished, this);
+
+    }
     m_socket = 0;
 }
 
+void TcpFlowClient::NotifyFlowFinished() {
+    m_flowFinishedCallback(this);
+}
+
 int64_t TcpFlowClient::GetAckedBytes() {
     if (m_connFailed || m_closedNormally || m_closedByError) {
         return m_ackedBytes;
@@ -503,6 +577,16 @@ TcpFlowClient::FinalizeDetailedLogs() {
     }
 }
 
+Ptr<LogOutputSink>
+TcpFlowClient::CreateDetailedLogSink(std::string log_name, std::string value_column) {
+    return CreateLogOutputSink(
+            parse_log_output_format(m_logOutputFormat),
+            m_detailedLogWriter, // If none was set, the sink has its own which is closed with it
+            m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_%s.csv", m_tcpFlowId, log_name.c_str()),
+            {"tcp_flow_id", "time_ns", value_column}
+    );
+}
+
 uint64_t TcpFlowClient::GetTcpFlowId() {
     return m_tcpFlowId;
 }
@@ -48,8 +48,11 @@ public:
   virtual ~TcpFlowClient ();
 
   void SetTcpSocketGenerator(Ptr<TcpSocketGenerator> tcpSocketGenerator);
+  void SetDetailedLogWriter(Ptr<AsyncLogWriter> detailedLogWriter);
   void SetRemotePort(uint16_t remotePort);
   void SetIpTos(uint8_t ipTos);
+  void SetFlowFinishedCallback(Callback<void, Ptr<TcpFlowClient>> flowFinishedCallback);
+  void Recycle(Address remoteAddress, uint64_t tcpFlowId, uint64_t flowSizeByte, std::string additionalParameters);
 
   uint64_t GetTcpFlowId();
   std::string GetAdditionalParameters();
@@ -83,7 +86,9 @@ private:
   std::string     m_additionalParameters;         //!< Additional parameters (unused; reserved for future use)
   bool            m_enableDetailedLoggingToFile;  //!< True iff you want to write detailed logs
   std::string     m_baseLogsDir;                  //!< Where the logs will be written to:  logs_dir/tcp_flow_[id]_{progress, cwnd, ...}.csv
+  std::string     m_logOutputFormat;              //!< Format of the detailed logs with integer values (csv, binary or columnar)
   Ptr<TcpSocketGenerator> m_tcpSocketGenerator;   //!< TCP socket generator
+  Callback<void, Ptr<TcpFlowClient>> m_flowFinishedCallback; //!< Called once the flow has finished (null: not recycled)
 
   // State
   Ptr<Socket>     m_socket;           //!< Associated socket
@@ -97,6 +102,7 @@ private:
   bool            m_isCompleted;      //!< True iff the flow is completed fully AND closed normally
 
   // Detailed logging
+  Ptr<AsyncLogWriter> m_detailedLogWriter;                         //!< Writer of the integer detailed logs (shared, e.g., by all flows)
   LogUpdateHelper<int64_t> m_log_update_helper_progress_byte;      //!< Progress
   LogUpdateHelper<int64_t> m_log_update_helper_rtt_ns;             //!< RTT estimate
   LogUpdateHelper<int64_t> m_log_update_helper_rto_ns;             //!< Retransmission time-out
@@ -113,6 +119,9 @@ private:
   void DataSend (Ptr<Socket>, uint32_t);
   void SocketClosedNormal(Ptr<Socket> socket);
   void SocketClosedError(Ptr<Socket> socket);
+  void ReleaseSocket();
+  void NotifyFlowFinished();
+  Ptr<LogOutputSink> CreateDetailedLogSink(std::string log_name, std::string value_column);
   void TxBufferUnackSequenceChange (SequenceNumber32, SequenceNumber32);
   void RttChange (Time, Time newRtt);
   void RtoChange(Time, Time newRto);
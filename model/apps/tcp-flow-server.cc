@@ -61,6 +61,8 @@ TcpFlowServer::TcpFlowServer() {
     m_tcpSocketGenerator = CreateObject<TcpSocketGeneratorDefault>();
     m_socket = 0;
     m_totalRx = 0;
+    m_numAcceptedConnections = 0;
+    m_peakOpenConnections = 0;
 }
 
 TcpFlowServer::~TcpFlowServer() {
@@ -72,7 +74,7 @@ TcpFlowServer::~TcpFlowServer() {
 void TcpFlowServer::DoDispose(void) {
     NS_LOG_FUNCTION(this);
     m_socket = 0;
-    m_socketList.clear();
+    m_acceptedSockets.clear();
 
     // chain up
     Application::DoDispose();
@@ -142,11 +144,10 @@ void TcpFlowServer::StopApplication() {  // Called at time specified by Stop
      * Deprecated stop code:
      *
      * NS_LOG_FUNCTION(this);
-     * while (!m_socketList.empty()) {
-     *     Ptr <Socket> socket = m_socketList.front();
-     *     m_socketList.pop_front();
-     *     socket->Close();
+     * for (std::pair<Socket* const, Ptr<Socket>>& accepted : m_acceptedSockets) {
+     *     accepted.second->Close();
      * }
+     * m_acceptedSockets.clear();
      * if (m_socket) {
      *     m_socket->Close();
      * }
@@ -160,7 +161,9 @@ void TcpFlowServer::HandleAccept(Ptr<Socket> socket, const Address &from) {
             MakeCallback(&TcpFlowServer::HandlePeerClose, this),
             MakeCallback(&TcpFlowServer::HandlePeerError, this)
     );
-    m_socketList.push_back(socket);
+    m_acceptedSockets.insert(std::make_pair(PeekPointer(socket), socket));
+    m_numAcceptedConnections++;
+    m_peakOpenConnections = std::max(m_peakOpenConnections, (uint64_t) m_acceptedSockets.size());
 }
 
 void TcpFlowServer::HandleRead(Ptr<Socket> socket) {
@@ -191,17 +194,24 @@ void TcpFlowServer::CleanUp(Ptr<Socket> socket) {
     NS_LOG_FUNCTION(this << socket);
     // This function can be called 2x if the LAST_ACK retries fail.
     // That would result in first a normal close, and then an error close.
-    std::list<Ptr<Socket>>::iterator it;
-    for (it = m_socketList.begin(); it != m_socketList.end(); ++it) {
-        if (*it == socket) {
-            m_socketList.erase(it);
-            break;
-        }
-    }
+    // The second time the socket is no longer there, as such erasing does nothing.
+    m_acceptedSockets.erase(PeekPointer(socket));
 }
 
 uint64_t TcpFlowServer::GetTotalRx() {
     return m_totalRx;
 }
 
+uint64_t TcpFlowServer::GetNumAcceptedConnections() {
+    return m_numAcceptedConnections;
+}
+
+uint64_t TcpFlowServer::GetNumOpenConnections() {
+    return m_acceptedSockets.size();
+}
+
+uint64_t TcpFlowServer::GetPeakOpenConnections() {
+    return m_peakOpenConnections;
+}
+
 } // Namespace ns3
@@ -29,6 +29,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/address.h"
 #include "ns3/socket-generator.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -47,6 +48,9 @@ public:
   void SetIpTos(uint8_t ipTos);
 
   uint64_t GetTotalRx();
+  uint64_t GetNumAcceptedConnections();
+  uint64_t GetNumOpenConnections();
+  uint64_t GetPeakOpenConnections();
  
 protected:
   virtual void DoDispose (void);
@@ -67,8 +71,10 @@ private:
 
   // State
   Ptr<Socket> m_socket;                 //!< Listening socket (upon connection request, forks off a socket)
-  std::list<Ptr<Socket> > m_socketList; //!< List of accepted sockets (are removed upon closed)
+  std::unordered_map<Socket*, Ptr<Socket> > m_acceptedSockets; //!< Accepted sockets by address (are removed upon closed)
   uint64_t m_totalRx;                   //!< Total (payload) bytes received
+  uint64_t m_numAcceptedConnections;    //!< Total number of connections accepted
+  uint64_t m_peakOpenConnections;       //!< Maximum number of connections open at the same time
   Ptr<TcpSocketGenerator> m_tcpSocketGenerator;  //!< TCP socket generator
 
 };
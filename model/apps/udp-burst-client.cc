@@ -59,6 +59,12 @@ UdpBurstClient::GetTypeId(void) {
                           UintegerValue(0),
                           MakeUintegerAccessor(&UdpBurstClient::m_udpBurstId),
                           MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ServerSlot",
+                          "Slot the UDP burst was assigned when it was registered at the server "
+                          "(carried in each packet such that the server does not need to look up the identifier)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&UdpBurstClient::m_serverSlot),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("TargetRateMbps",
                           "Target rate (incl. headers) in Mbit/s",
                           DoubleValue(10.0),
@@ -84,6 +90,11 @@ UdpBurstClient::GetTypeId(void) {
                            StringValue (""),
                            MakeStringAccessor (&UdpBurstClient::m_baseLogsDir),
                            MakeStringChecker ())
+            .AddAttribute ("LogOutputFormat",
+                           "Format of the detailed log (csv, binary or columnar; the file extension follows the format)",
+                           StringValue ("csv"),
+                           MakeStringAccessor (&UdpBurstClient::m_logOutputFormat),
+                           MakeStringChecker ())
             .AddAttribute("MaxSegmentSizeByte",
                           "Maximum segment size (byte), in other words: "
                           "the maximum total packet size before it gets fragmented.",
@@ -98,23 +109,45 @@ UdpBurstClient::GetTypeId(void) {
     return tid;
 }
 
+/**
+ * Calculate the time between sending two consecutive packets of a burst.
+ * The packets of a burst are sent at its start time plus a multiple of this gap,
+ * which the receiving server uses to determine the one-way latency of each packet.
+ *
+ * @param maxSegmentSizeByte        Size of each packet (byte) including all headers
+ * @param targetRateMegabitPerSec   Target rate (Mbit/s) including all headers
+ *
+ * @return Packet gap (ns)
+ */
+int64_t
+UdpBurstClient::CalculatePacketGapNs(uint32_t maxSegmentSizeByte, double targetRateMegabitPerSec) {
+    return (int64_t) std::ceil((double) maxSegmentSizeByte / (targetRateMegabitPerSec / 8000.0));
+}
+
 UdpBurstClient::UdpBurstClient() {
     NS_LOG_FUNCTION(this);
     m_udpSocketGenerator = CreateObject<UdpSocketGeneratorDefault>();
     m_socket = 0;
     m_sent = 0;
     m_sendEvent = EventId();
+    m_preciseLogWriter = 0;
+    m_preciseLogSink = 0;
 }
 
 UdpBurstClient::~UdpBurstClient() {
     NS_LOG_FUNCTION(this);
     m_udpSocketGenerator = 0;
     m_socket = 0;
+    m_preciseLogSink = 0;
+    m_preciseLogWriter = 0;
 }
 
 void
 UdpBurstClient::DoDispose(void) {
     NS_LOG_FUNCTION(this);
+    ClosePreciseLog();
+    m_preciseLogSink = 0;
+    m_preciseLogWriter = 0;
     Application::DoDispose();
 }
 
@@ -123,6 +156,18 @@ UdpBurstClient::SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator
     m_udpSocketGenerator = udpSocketGenerator;
 }
 
+void
+UdpBurstClient::SetPreciseLogWriter(Ptr<AsyncLogWriter> preciseLogWriter) {
+    m_preciseLogWriter = preciseLogWriter;
+}
+
+void
+UdpBurstClient::ClosePreciseLog() {
+    if (m_preciseLogSink != 0) {
+        m_preciseLogSink->Close();
+    }
+}
+
 void
 UdpBurstClient::SetIpTos(uint8_t ipTos) {
     NS_ABORT_MSG_UNLESS(InetSocketAddress::IsMatchingType(m_localAddress), "Only IPv4 is supported.");
@@ -164,6 +209,17 @@ UdpBurstClient::StartApplication(void) {
     }
     m_startTime = Simulator::Now();
     m_socket->SetAllowBroadcast(false);
+
+    // The detailed log is closed as soon as the burst is done sending
+    if (m_enableDetailedLoggingToFile && m_preciseLogSink == 0) {
+        m_preciseLogSink = CreateLogOutputSink(
+                parse_log_output_format(m_logOutputFormat),
+                m_preciseLogWriter, // If none was set, the sink has its own which is closed with it
+                m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu32 "_outgoing.csv", m_udpBurstId),
+                {"udp_burst_id", "seq_no", "sent_timestamp_ns"}
+        );
+    }
+
     ScheduleTransmit(Seconds(0.));
 }
 
@@ -189,6 +245,7 @@ UdpBurstClient::Send(void) {
     UdpBurstHeader burstHeader;
     burstHeader.SetId(m_udpBurstId);
     burstHeader.SetSeq(m_sent);
+    burstHeader.SetSlot(m_serverSlot);
     Ptr<Packet> p = Create<Packet>(m_maxUdpPayloadSizeByte - burstHeader.GetSerializedSize());
     p->AddHeader(burstHeader);
 
@@ -197,10 +254,8 @@ UdpBurstClient::Send(void) {
 
     // Log precise timestamp sent away of the sequence packet if needed
     if (m_enableDetailedLoggingToFile) {
-        std::ofstream ofs;
-        ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_outgoing.csv", burstHeader.GetId()), std::ofstream::out | std::ofstream::app);
-        ofs << burstHeader.GetId() << "," << burstHeader.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
-        ofs.close();
+        int64_t record[3] = {(int64_t) burstHeader.GetId(), (int64_t) burstHeader.GetSeq(), Simulator::Now().GetNanoSeconds()};
+        m_preciseLogSink->WriteRecord(record);
     }
 
     // Send out
@@ -208,9 +263,11 @@ UdpBurstClient::Send(void) {
 
     // Schedule next transmit, or wait to close
     uint64_t now_ns = Simulator::Now().GetNanoSeconds();
-    uint64_t packet_gap_nanoseconds = std::ceil((double) m_maxSegmentSizeByte / (m_targetRateMegabitPerSec / 8000.0));
+    uint64_t packet_gap_nanoseconds = CalculatePacketGapNs(m_maxSegmentSizeByte, m_targetRateMegabitPerSec);
     if (now_ns + packet_gap_nanoseconds < (uint64_t) (m_startTime.GetNanoSeconds() + m_duration.GetNanoSeconds())) {
         ScheduleTransmit(NanoSeconds(packet_gap_nanoseconds));
+    } else {
+        ClosePreciseLog();
     }
 
 }
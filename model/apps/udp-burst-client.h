@@ -30,6 +30,8 @@
 #include "ns3/traced-callback.h"
 #include "ns3/udp-burst-header.h"
 #include "ns3/socket-generator.h"
+#include "ns3/async-log-writer.h"
+#include "ns3/log-output-sink.h"
 
 namespace ns3 {
 
@@ -40,11 +42,14 @@ class UdpBurstClient : public Application
 {
 public:
   static TypeId GetTypeId (void);
+  static int64_t CalculatePacketGapNs (uint32_t maxSegmentSizeByte, double targetRateMegabitPerSec);
   UdpBurstClient ();
   virtual ~UdpBurstClient ();
 
   void SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator);
   void SetIpTos(uint8_t ipTos);
+  void SetPreciseLogWriter(Ptr<AsyncLogWriter> preciseLogWriter);
+  void ClosePreciseLog();
 
   uint32_t GetUdpBurstId();
   std::string GetAdditionalParameters();
@@ -68,20 +73,24 @@ private:
   Address m_localAddress;                //!< Local address (IP, port)
   Address m_remoteAddress;               //!< Remote (server) address (IP, port)
   uint32_t m_udpBurstId;                 //!< Unique UDP burst identifier
+  uint32_t m_serverSlot;                 //!< Slot of the UDP burst at the receiving server
   Time m_startTime;                      //!< Start time
   double m_targetRateMegabitPerSec;      //!< Target rate (incl. headers) in Mbit/s
   Time m_duration;                       //!< Duration of the sending
   std::string m_additionalParameters;    //!< Additional parameters (unused; reserved for future use)
   bool m_enableDetailedLoggingToFile;    //!< True iff you want to write detailed logs
   std::string m_baseLogsDir;             //!< Where the logs will be written to: logs_dir/udp_burst_[id]_outgoing.csv
+  std::string m_logOutputFormat;         //!< Format of the detailed log (csv, binary or columnar)
   uint32_t m_maxSegmentSizeByte;         //!< Maximum segment size
   uint32_t m_maxUdpPayloadSizeByte;      //!< Maximum size of UDP payload before it gets fragmented
   Ptr<UdpSocketGenerator> m_udpSocketGenerator;  //!< UDP socket generator
+  Ptr<AsyncLogWriter> m_preciseLogWriter;        //!< Writer of the detailed logs (shared, e.g., by all bursts)
 
   // State
   Ptr<Socket> m_socket;  //!< Socket
   EventId m_sendEvent;   //!< Event to send the next packet
   uint32_t m_sent;       //!< Counter for sent packets
+  Ptr<LogOutputSink> m_preciseLogSink;  //!< Sink of the detailed log
 
 };
 
@@ -20,6 +20,8 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <stdexcept>
+#include <string>
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/header.h"
@@ -45,7 +47,8 @@ UdpBurstHeader::GetTypeId (void)
 
 UdpBurstHeader::UdpBurstHeader ()
   : m_id (0),
-    m_seq (0)
+    m_seq (0),
+    m_slot (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -54,6 +57,9 @@ void
 UdpBurstHeader::SetId (uint64_t id)
 {
     NS_LOG_FUNCTION (this << id);
+    if (id > UINT32_MAX) {
+        throw std::invalid_argument("UDP burst identifier does not fit in the 32 bits of the header: " + std::to_string(id));
+    }
     m_id = id;
 }
 
@@ -78,6 +84,20 @@ UdpBurstHeader::GetSeq (void) const
   return m_seq;
 }
 
+void
+UdpBurstHeader::SetSlot (uint32_t slot)
+{
+  NS_LOG_FUNCTION (this << slot);
+  m_slot = slot;
+}
+
+uint32_t
+UdpBurstHeader::GetSlot (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_slot;
+}
+
 TypeId
 UdpBurstHeader::GetInstanceTypeId (void) const
 {
@@ -103,7 +123,8 @@ UdpBurstHeader::Serialize (Buffer::Iterator start) const
 {
   NS_LOG_FUNCTION (this << &start);
   Buffer::Iterator i = start;
-  i.WriteHtonU64 (m_id);
+  i.WriteHtonU32 ((uint32_t) m_id);
+  i.WriteHtonU32 (m_slot);
   i.WriteHtonU64 (m_seq);
 }
 
@@ -112,7 +133,8 @@ UdpBurstHeader::Deserialize (Buffer::Iterator start)
 {
   NS_LOG_FUNCTION (this << &start);
   Buffer::Iterator i = start;
-  m_id = i.ReadNtohU64 ();
+  m_id = i.ReadNtohU32 ();
+  m_slot = i.ReadNtohU32 ();
   m_seq = i.ReadNtohU64 ();
   return GetSerializedSize ();
 }
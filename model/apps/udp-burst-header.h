@@ -35,8 +35,10 @@ public:
   UdpBurstHeader ();
   void SetId (uint64_t id);
   void SetSeq (uint64_t seq);
+  void SetSlot (uint32_t slot);
   uint64_t GetId (void) const;
   uint64_t GetSeq (void) const;
+  uint32_t GetSlot (void) const;
 
   virtual TypeId GetInstanceTypeId (void) const;
   virtual void Print (std::ostream &os) const;
@@ -45,8 +47,9 @@ public:
   virtual uint32_t Deserialize (Buffer::Iterator start);
 
 private:
-  uint64_t m_id;  //!< Identifier of what these sequences belong to
-  uint64_t m_seq; //!< Sequence number
+  uint64_t m_id;   //!< Identifier of what these sequences belong to (serialized as 32 bits)
+  uint64_t m_seq;  //!< Sequence number
+  uint32_t m_slot; //!< Slot of the burst at the receiving server (assigned at registration)
 };
 
 } // namespace ns3
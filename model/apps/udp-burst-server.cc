@@ -54,6 +54,11 @@ UdpBurstServer::GetTypeId(void) {
                            StringValue (""),
                            MakeStringAccessor (&UdpBurstServer::m_baseLogsDir),
                            MakeStringChecker ())
+            .AddAttribute ("LogOutputFormat",
+                           "Format of the detailed logs (csv, binary or columnar; the file extension follows the format)",
+                           StringValue ("csv"),
+                           MakeStringAccessor (&UdpBurstServer::m_logOutputFormat),
+                           MakeStringChecker ())
             .AddAttribute("MaxSegmentSizeByte",
                           "Maximum segment size (byte), in other words: "
                           "the maximum total packet size before it gets fragmented.",
@@ -72,17 +77,23 @@ UdpBurstServer::UdpBurstServer() {
     NS_LOG_FUNCTION(this);
     m_udpSocketGenerator = CreateObject<UdpSocketGeneratorDefault>();
     m_socket = 0;
+    m_preciseLogWriter = 0;
 }
 
 UdpBurstServer::~UdpBurstServer() {
     NS_LOG_FUNCTION(this);
     m_udpSocketGenerator = 0;
     m_socket = 0;
+    m_incoming_bursts_precise_log_sink.clear();
+    m_preciseLogWriter = 0;
 }
 
 void
 UdpBurstServer::DoDispose(void) {
     NS_LOG_FUNCTION(this);
+    ClosePreciseLogs();
+    m_incoming_bursts_precise_log_sink.clear();
+    m_preciseLogWriter = 0;
     Application::DoDispose();
 }
 
@@ -91,6 +102,20 @@ UdpBurstServer::SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator
     m_udpSocketGenerator = udpSocketGenerator;
 }
 
+void
+UdpBurstServer::SetPreciseLogWriter(Ptr<AsyncLogWriter> preciseLogWriter) {
+    m_preciseLogWriter = preciseLogWriter;
+}
+
+void
+UdpBurstServer::ClosePreciseLogs() {
+    for (Ptr<LogOutputSink>& sink : m_incoming_bursts_precise_log_sink) {
+        if (sink != 0) {
+            sink->Close();
+        }
+    }
+}
+
 void
 UdpBurstServer::SetIpTos(uint8_t ipTos) {
     NS_ABORT_MSG_UNLESS(InetSocketAddress::IsMatchingType(m_localAddress), "Only IPv4 is supported.");
@@ -109,16 +134,59 @@ UdpBurstServer::GetMaxUdpPayloadSizeByte() const {
     return m_maxUdpPayloadSizeByte;
 }
 
-void
+/**
+ * Register a burst which is going to arrive at this server. Each burst is assigned
+ * the next free slot, which the client must carry in the header of each of its packets.
+ * As its send times are unknown, the one-way latency of its packets is not tracked.
+ *
+ * @param udp_burst_id              UDP burst identifier
+ * @param enable_precise_logging    True iff the receive timestamp of each packet should be logged
+ *
+ * @return Slot assigned to the burst
+ */
+uint32_t
 UdpBurstServer::RegisterIncomingBurst(int64_t udp_burst_id, bool enable_precise_logging) {
+    return RegisterIncomingBurst(udp_burst_id, enable_precise_logging, -1, 0);
+}
+
+/**
+ * Register a burst which is going to arrive at this server, of which packet i is sent
+ * at start_time_ns + i * packet_gap_ns, such that the one-way latency of each arriving
+ * packet is tracked.
+ *
+ * @param udp_burst_id              UDP burst identifier
+ * @param enable_precise_logging    True iff the receive timestamp of each packet should be logged
+ * @param start_time_ns             Time the first packet is sent (ns), or -1 if unknown
+ * @param packet_gap_ns             Time between sending two packets (ns)
+ *
+ * @return Slot assigned to the burst
+ */
+uint32_t
+UdpBurstServer::RegisterIncomingBurst(int64_t udp_burst_id, bool enable_precise_logging, int64_t start_time_ns, int64_t packet_gap_ns) {
+    if (m_incoming_bursts_slot.find(udp_burst_id) != m_incoming_bursts_slot.end()) {
+        throw std::invalid_argument(format_string("UDP burst %" PRId64 " is already registered", udp_burst_id));
+    }
+    uint32_t slot = (uint32_t) m_incoming_bursts.size();
     m_incoming_bursts.push_back(udp_burst_id);
-    m_incoming_bursts_received_counter.insert(std::make_pair(udp_burst_id, 0));
-    m_incoming_bursts_enable_precise_logging.insert(std::make_pair(udp_burst_id, enable_precise_logging));
+    m_incoming_bursts_slot.insert(std::make_pair(udp_burst_id, slot));
+    m_incoming_bursts_received_counter.push_back(0);
+    m_incoming_bursts_received_bytes.push_back(0);
+    m_incoming_bursts_out_of_order_counter.push_back(0);
+    m_incoming_bursts_next_expected_seq.push_back(0);
+    m_incoming_bursts_start_time_ns.push_back(start_time_ns);
+    m_incoming_bursts_packet_gap_ns.push_back(packet_gap_ns);
+    m_incoming_bursts_one_way_latency_sketch.push_back(LatencySketch());
     if (enable_precise_logging) {
-        std::ofstream ofs;
-        ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_incoming.csv", udp_burst_id));
-        ofs.close();
+        m_incoming_bursts_precise_log_sink.push_back(CreateLogOutputSink(
+                parse_log_output_format(m_logOutputFormat),
+                m_preciseLogWriter, // If none was set, the sink has its own which is closed with it
+                m_baseLogsDir + "/" + format_string("udp_burst_%" PRId64 "_incoming.csv", udp_burst_id),
+                {"udp_burst_id", "seq_no", "received_timestamp_ns"}
+        ));
+    } else {
+        m_incoming_bursts_precise_log_sink.push_back(0);
     }
+    return slot;
 }
 
 void
@@ -156,32 +224,77 @@ UdpBurstServer::HandleRead(Ptr <Socket> socket) {
         UdpBurstHeader incomingBurstHeader;
         packet->RemoveHeader (incomingBurstHeader);
 
-        // Count packets from incoming bursts
-        m_incoming_bursts_received_counter.at(incomingBurstHeader.GetId()) += 1;
+        // Resolve the slot carried in the header
+        uint32_t slot = incomingBurstHeader.GetSlot();
+        if (slot >= m_incoming_bursts.size() || m_incoming_bursts[slot] != (int64_t) incomingBurstHeader.GetId()) {
+            throw std::runtime_error(format_string(
+                    "Received packet of UDP burst %" PRIu64 " with slot %" PRIu32 " which does not match the registration",
+                    incomingBurstHeader.GetId(), slot
+            ));
+        }
+
+        // Count packets and payload bytes from incoming bursts
+        m_incoming_bursts_received_counter[slot] += 1;
+        m_incoming_bursts_received_bytes[slot] += incomingBurstHeader.GetSerializedSize() + packet->GetSize();
+
+        // A packet is out-of-order if a higher sequence number already arrived
+        if (incomingBurstHeader.GetSeq() < m_incoming_bursts_next_expected_seq[slot]) {
+            m_incoming_bursts_out_of_order_counter[slot] += 1;
+        } else {
+            m_incoming_bursts_next_expected_seq[slot] = incomingBurstHeader.GetSeq() + 1;
+        }
+
+        // One-way latency if the send time is known
+        if (m_incoming_bursts_start_time_ns[slot] != -1) {
+            int64_t sent_ns = m_incoming_bursts_start_time_ns[slot] + (int64_t) incomingBurstHeader.GetSeq() * m_incoming_bursts_packet_gap_ns[slot];
+            m_incoming_bursts_one_way_latency_sketch[slot].Add(Simulator::Now().GetNanoSeconds() - sent_ns);
+        }
 
         // Log precise timestamp received of the sequence packet if needed
-        if (m_incoming_bursts_enable_precise_logging.at(incomingBurstHeader.GetId())) {
-            std::ofstream ofs;
-            ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_incoming.csv", incomingBurstHeader.GetId()), std::ofstream::out | std::ofstream::app);
-            ofs << incomingBurstHeader.GetId() << "," << incomingBurstHeader.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
-            ofs.close();
+        if (m_incoming_bursts_precise_log_sink[slot] != 0) {
+            int64_t record[3] = {(int64_t) incomingBurstHeader.GetId(), (int64_t) incomingBurstHeader.GetSeq(), Simulator::Now().GetNanoSeconds()};
+            m_incoming_bursts_precise_log_sink[slot]->WriteRecord(record);
         }
 
     }
 }
 
+uint32_t
+UdpBurstServer::GetSlotOf(int64_t udp_burst_id) {
+    std::map<int64_t, uint32_t>::const_iterator it = m_incoming_bursts_slot.find(udp_burst_id);
+    if (it == m_incoming_bursts_slot.end()) {
+        throw std::out_of_range(format_string("UDP burst %" PRId64 " is not registered", udp_burst_id));
+    }
+    return it->second;
+}
+
 std::vector<std::tuple<int64_t, uint64_t>>
 UdpBurstServer::GetIncomingBurstsInformation() {
     std::vector<std::tuple<int64_t, uint64_t>> result;
     for (size_t i = 0; i < m_incoming_bursts.size(); i++) {
-        result.push_back(std::make_tuple(m_incoming_bursts.at(i), m_incoming_bursts_received_counter.at(m_incoming_bursts.at(i))));
+        result.push_back(std::make_tuple(m_incoming_bursts.at(i), m_incoming_bursts_received_counter.at(i)));
     }
     return result;
 }
 
 uint64_t
 UdpBurstServer::GetReceivedCounterOf(int64_t udp_burst_id) {
-    return m_incoming_bursts_received_counter.at(udp_burst_id);
+    return m_incoming_bursts_received_counter.at(GetSlotOf(udp_burst_id));
+}
+
+uint64_t
+UdpBurstServer::GetReceivedBytesOf(int64_t udp_burst_id) {
+    return m_incoming_bursts_received_bytes.at(GetSlotOf(udp_burst_id));
+}
+
+uint64_t
+UdpBurstServer::GetOutOfOrderCounterOf(int64_t udp_burst_id) {
+    return m_incoming_bursts_out_of_order_counter.at(GetSlotOf(udp_burst_id));
+}
+
+const LatencySketch&
+UdpBurstServer::GetOneWayLatencySketchOf(int64_t udp_burst_id) {
+    return m_incoming_bursts_one_way_latency_sketch.at(GetSlotOf(udp_burst_id));
 }
 
 } // Namespace ns3
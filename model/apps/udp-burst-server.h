@@ -28,6 +28,9 @@
 #include "ns3/traced-callback.h"
 #include "ns3/udp-burst-header.h"
 #include "ns3/socket-generator.h"
+#include "ns3/async-log-writer.h"
+#include "ns3/log-output-sink.h"
+#include "ns3/latency-sketch.h"
 
 namespace ns3 {
 
@@ -43,12 +46,18 @@ public:
 
   void SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator);
   void SetIpTos(uint8_t ipTos);
+  void SetPreciseLogWriter(Ptr<AsyncLogWriter> preciseLogWriter);
+  void ClosePreciseLogs();
 
   uint32_t GetMaxSegmentSizeByte() const;
   uint32_t GetMaxUdpPayloadSizeByte() const;
-  void RegisterIncomingBurst(int64_t udp_burst_id, bool enable_precise_logging);
+  uint32_t RegisterIncomingBurst(int64_t udp_burst_id, bool enable_precise_logging);
+  uint32_t RegisterIncomingBurst(int64_t udp_burst_id, bool enable_precise_logging, int64_t start_time_ns, int64_t packet_gap_ns);
   std::vector<std::tuple<int64_t, uint64_t>> GetIncomingBurstsInformation();
   uint64_t GetReceivedCounterOf(int64_t udp_burst_id);
+  uint64_t GetReceivedBytesOf(int64_t udp_burst_id);
+  uint64_t GetOutOfOrderCounterOf(int64_t udp_burst_id);
+  const LatencySketch& GetOneWayLatencySketchOf(int64_t udp_burst_id);
 
 protected:
   virtual void DoDispose (void);
@@ -58,20 +67,30 @@ private:
   virtual void StartApplication (void);
   virtual void StopApplication (void);
   void HandleRead (Ptr<Socket> socket);
+  uint32_t GetSlotOf(int64_t udp_burst_id);
 
   Address m_localAddress;            //!< Local address (IPv4, port) the server operates out of
   std::string m_baseLogsDir;         //!< Where the logs will be written to: logs_dir/udp_burst_[id]_incoming.csv
+  std::string m_logOutputFormat;     //!< Format of the detailed logs (csv, binary or columnar)
   uint32_t m_maxSegmentSizeByte;     //!< Maximum segment size
   uint32_t m_maxUdpPayloadSizeByte;  //!< Maximum size of UDP payload before it gets fragmented
   Ptr<UdpSocketGenerator> m_udpSocketGenerator;  //!< UDP socket generator
+  Ptr<AsyncLogWriter> m_preciseLogWriter;        //!< Writer of the detailed logs (shared, e.g., by all bursts)
 
   // State
   Ptr<Socket> m_socket;  //!< IPv4 Socket
 
-  // Logging
-  std::vector<int64_t> m_incoming_bursts;                               //!< Registered incoming bursts
-  std::map<int64_t, uint64_t> m_incoming_bursts_received_counter;       //!< Counter for how many packets received
-  std::map<int64_t, uint64_t> m_incoming_bursts_enable_precise_logging; //!< True iff enable precise logging for each burst
+  // Logging (each registered incoming burst has a slot, which indexes the vectors below)
+  std::vector<int64_t> m_incoming_bursts;                              //!< Registered incoming bursts (slot -> UDP burst ID)
+  std::map<int64_t, uint32_t> m_incoming_bursts_slot;                  //!< UDP burst ID -> slot (not used when receiving)
+  std::vector<uint64_t> m_incoming_bursts_received_counter;            //!< Counter for how many packets received
+  std::vector<uint64_t> m_incoming_bursts_received_bytes;              //!< Counter for how many UDP payload bytes received
+  std::vector<uint64_t> m_incoming_bursts_out_of_order_counter;        //!< Counter for how many packets arrived after a higher sequence number
+  std::vector<uint64_t> m_incoming_bursts_next_expected_seq;           //!< One beyond the highest sequence number received
+  std::vector<int64_t> m_incoming_bursts_start_time_ns;               //!< Time the first packet is sent (-1 if unknown)
+  std::vector<int64_t> m_incoming_bursts_packet_gap_ns;                //!< Time between sending two packets
+  std::vector<LatencySketch> m_incoming_bursts_one_way_latency_sketch; //!< One-way latency (ns) quantile sketch (empty if send time unknown)
+  std::vector<Ptr<LogOutputSink>> m_incoming_bursts_precise_log_sink;  //!< Sink of each burst (0 if precise logging is disabled)
 
 };
 
@@ -0,0 +1,344 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/log.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/nstime.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/exp-util.h"
+#include "udp-ping-agent.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("UdpPingAgent");
+
+NS_OBJECT_ENSURE_REGISTERED (UdpPingAgent);
+
+TypeId
+UdpPingAgent::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::UdpPingAgent")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<UdpPingAgent>()
+            .AddAttribute("LocalAddress",
+                          "The local address (IPv4 address, port). Setting the IPv4 address will enable "
+                          "proper ECMP routing (as else it forces an early lookup with only destination IP). "
+                          "Setting the port is not necessary, as it will be assigned an ephemeral one.",
+                          AddressValue(),
+                          MakeAddressAccessor(&UdpPingAgent::m_localAddress),
+                          MakeAddressChecker())
+            .AddAttribute("EnablePerPingLogging",
+                          "True iff the timestamps of each ping are kept. If false, only the running statistics "
+                          "of the latencies and the number of replies are kept, which take constant memory apart from "
+                          "one bit per sent ping (to know whether its reply arrived).",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&UdpPingAgent::m_enablePerPingLogging),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+UdpPingAgent::UdpPingAgent() {
+    NS_LOG_FUNCTION(this);
+    m_udpSocketGenerator = CreateObject<UdpSocketGeneratorDefault>();
+    m_ipTos = 0;
+    m_socket = 0;
+    m_sendEvent = EventId();
+    m_waitForFinishEvent = EventId();
+    m_finishTimeNs = 0;
+}
+
+UdpPingAgent::~UdpPingAgent() {
+    NS_LOG_FUNCTION(this);
+    m_udpSocketGenerator = 0;
+    m_socket = 0;
+}
+
+void
+UdpPingAgent::DoDispose(void) {
+    NS_LOG_FUNCTION(this);
+    Application::DoDispose();
+}
+
+void
+UdpPingAgent::SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator) {
+    m_udpSocketGenerator = udpSocketGenerator;
+}
+
+void
+UdpPingAgent::SetIpTos(uint8_t ipTos) {
+    NS_ABORT_MSG_UNLESS(InetSocketAddress::IsMatchingType(m_localAddress), "Only IPv4 is supported.");
+    InetSocketAddress newLocalAddress = InetSocketAddress::ConvertFrom(m_localAddress);
+    newLocalAddress.SetTos(ipTos);
+    m_localAddress = newLocalAddress;
+    m_ipTos = ipTos;
+    for (InetSocketAddress& remoteAddress : m_remoteAddresses) {
+        remoteAddress.SetTos(ipTos);
+    }
+}
+
+/**
+ * Add a UDP ping to send out. Its pings are sent at start time + i * interval
+ * for as long as that is within the duration, after which it waits for replies
+ * until start time + duration + wait afterwards. All pings must be added before
+ * the agent starts, and in ascending UDP ping ID.
+ *
+ * @param udpPingId         UDP ping identifier
+ * @param remoteAddress     Address of the UdpPingServer (IPv4 address, port)
+ * @param startTimeNs       Time the first ping is sent (ns)
+ * @param intervalNs        Time between sending two pings (ns)
+ * @param durationNs        Duration of the sending (ns)
+ * @param waitAfterwardsNs  How long to wait for replies after the duration is over (ns)
+ *
+ * @return Slot assigned to the UDP ping
+ */
+uint32_t
+UdpPingAgent::AddPing(int64_t udpPingId, InetSocketAddress remoteAddress, int64_t startTimeNs, int64_t intervalNs, int64_t durationNs, int64_t waitAfterwardsNs) {
+    if (m_socket != 0) {
+        throw std::runtime_error("UDP pings cannot be added after the UDP ping agent has started");
+    }
+    if (!m_udpPingIds.empty() && udpPingId <= m_udpPingIds.back()) {
+        throw std::invalid_argument(format_string("UDP ping ID is not ascending (violation: %" PRId64 ")", udpPingId));
+    }
+    if (startTimeNs < 0 || intervalNs <= 0 || durationNs <= 0 || waitAfterwardsNs < 0) {
+        throw std::invalid_argument(format_string("Invalid timing of UDP ping %" PRId64, udpPingId));
+    }
+    uint32_t slot = m_udpPingIds.size();
+    remoteAddress.SetTos(m_ipTos);
+    m_udpPingIds.push_back(udpPingId);
+    m_remoteAddresses.push_back(remoteAddress);
+    m_startTimeNs.push_back(startTimeNs);
+    m_intervalNs.push_back(intervalNs);
+    m_durationNs.push_back(durationNs);
+    m_waitAfterwardsNs.push_back(waitAfterwardsNs);
+    m_sent.push_back(0);
+    m_replyArrived.push_back(std::vector<bool>());
+    m_latencyThereStatistics.push_back(RunningStatistics());
+    m_latencyBackStatistics.push_back(RunningStatistics());
+    m_rttStatistics.push_back(RunningStatistics());
+    m_rttSketch.push_back(LatencySketch());
+    if (m_enablePerPingLogging) {
+        m_sendRequestTimestamps.push_back(std::vector<int64_t>());
+        m_replyTimestamps.push_back(std::vector<int64_t>());
+        m_receiveReplyTimestamps.push_back(std::vector<int64_t>());
+    }
+    m_sendQueue.push(std::make_pair(startTimeNs, slot));
+    m_finishTimeNs = std::max(m_finishTimeNs, startTimeNs + durationNs + waitAfterwardsNs);
+    return slot;
+}
+
+void
+UdpPingAgent::StartApplication(void) {
+    NS_LOG_FUNCTION(this);
+    if (m_socket == 0) {
+        m_socket = m_udpSocketGenerator->GenerateUdpSocket(UdpPingAgent::GetTypeId(), this);
+
+        // Bind socket (it is not connected, as each ping has its own destination)
+        NS_ABORT_MSG_UNLESS(InetSocketAddress::IsMatchingType(m_localAddress), "Only IPv4 is supported.");
+        if (m_socket->Bind(m_localAddress) == -1) {
+            throw std::runtime_error("Failed to bind socket");
+        }
+
+    }
+    m_socket->SetRecvCallback(MakeCallback(&UdpPingAgent::HandleRead, this));
+    m_socket->SetAllowBroadcast(false);
+    ScheduleNextSend();
+}
+
+void
+UdpPingAgent::StopApplication() { // Called at time specified by Stop
+    throw std::runtime_error(
+            "UDP ping agent cannot be stopped like a regular application, only of its own volition."
+    );
+}
+
+void
+UdpPingAgent::Finish() {
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_UNLESS(m_sendEvent.IsExpired());
+    NS_ABORT_UNLESS(m_waitForFinishEvent.IsExpired());
+    if (m_socket != 0) {
+        m_socket->Close();
+        m_socket->SetRecvCallback(MakeNullCallback < void, Ptr < Socket > > ());
+        m_socket = 0;
+    }
+}
+
+/**
+ * Schedule the single send event at the earliest next send time among the pings,
+ * or if none has to send anymore, wait for the last replies to finish.
+ */
+void
+UdpPingAgent::ScheduleNextSend() {
+    NS_LOG_FUNCTION(this);
+    int64_t now_ns = Simulator::Now().GetNanoSeconds();
+    if (!m_sendQueue.empty()) {
+        NS_ABORT_MSG_IF(m_sendQueue.top().first < now_ns, "UDP ping agent started after the start of one of its pings.");
+        m_sendEvent = Simulator::Schedule(NanoSeconds(m_sendQueue.top().first - now_ns), &UdpPingAgent::SendDue, this);
+    } else {
+        m_waitForFinishEvent = Simulator::Schedule(NanoSeconds(std::max(m_finishTimeNs - now_ns, (int64_t) 0)), &UdpPingAgent::Finish, this);
+    }
+}
+
+/**
+ * Send out the pings of all UDP pings which are due right now (in order of slot).
+ */
+void
+UdpPingAgent::SendDue(void) {
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_sendEvent.IsExpired());
+    int64_t now_ns = Simulator::Now().GetNanoSeconds();
+    while (!m_sendQueue.empty() && m_sendQueue.top().first == now_ns) {
+        uint32_t slot = m_sendQueue.top().second;
+        m_sendQueue.pop();
+        Send(slot, now_ns);
+
+        // Next transmit if it is still within the duration
+        if (now_ns + m_intervalNs[slot] < m_startTimeNs[slot] + m_durationNs[slot]) {
+            m_sendQueue.push(std::make_pair(now_ns + m_intervalNs[slot], slot));
+        }
+
+    }
+    ScheduleNextSend();
+}
+
+void
+UdpPingAgent::Send(uint32_t slot, int64_t now_ns) {
+    NS_LOG_FUNCTION(this << slot);
+
+    // Packet with timestamp
+    Ptr<Packet> p = Create<Packet>();
+    UdpPingHeader pingHeader;
+    pingHeader.SetId(m_udpPingIds[slot]);
+    pingHeader.SetSeq(m_sent[slot]);
+    pingHeader.SetTs(now_ns);
+    p->AddHeader(pingHeader);
+
+    // Timestamps
+    m_replyArrived[slot].push_back(false);
+    if (m_enablePerPingLogging) {
+        m_sendRequestTimestamps[slot].push_back(now_ns);
+        m_replyTimestamps[slot].push_back(-1);
+        m_receiveReplyTimestamps[slot].push_back(-1);
+    }
+    m_sent[slot]++;
+
+    // Send out
+    m_socket->SendTo(p, 0, m_remoteAddresses[slot]);
+
+}
+
+void
+UdpPingAgent::HandleRead(Ptr <Socket> socket) {
+    NS_LOG_FUNCTION(this << socket);
+    Ptr <Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from))) {
+
+        // Receiving header
+        UdpPingHeader pingHeader;
+        packet->RemoveHeader (pingHeader);
+        uint32_t seqNo = pingHeader.GetSeq();
+
+        // Slot of the UDP ping (they are added in ascending UDP ping ID)
+        std::vector<int64_t>::iterator it = std::lower_bound(m_udpPingIds.begin(), m_udpPingIds.end(), (int64_t) pingHeader.GetId());
+        NS_ABORT_MSG_IF(it == m_udpPingIds.end() || *it != (int64_t) pingHeader.GetId(), "Reply of a UDP ping which is not of this agent.");
+        uint32_t slot = it - m_udpPingIds.begin();
+
+        // Replies which arrive after the UDP ping stopped waiting are not counted,
+        // the same as for a UdpPingClient which has closed its socket by then
+        int64_t receive_reply_ns = Simulator::Now().GetNanoSeconds();
+        if (receive_reply_ns >= m_startTimeNs[slot] + m_durationNs[slot] + m_waitAfterwardsNs[slot]) {
+            continue;
+        }
+
+        // Sanity checks
+        NS_ABORT_MSG_IF(seqNo >= m_sent[slot], "Sequence number has not (yet) been sent out.");
+        NS_ABORT_MSG_IF(m_replyArrived[slot][seqNo], "Already got reply for this sequence number.");
+        m_replyArrived[slot][seqNo] = true;
+
+        // Pings are sent at a fixed interval from the start, so the send timestamp follows from the sequence number
+        int64_t send_request_ns = m_startTimeNs[slot] + seqNo * m_intervalNs[slot];
+        int64_t reply_ns = pingHeader.GetTs();
+
+        // Update the statistics
+        m_latencyThereStatistics[slot].Add(reply_ns - send_request_ns);
+        m_latencyBackStatistics[slot].Add(receive_reply_ns - reply_ns);
+        m_rttStatistics[slot].Add(receive_reply_ns - send_request_ns);
+        m_rttSketch[slot].Add(receive_reply_ns - send_request_ns);
+
+        // Update the timestamps for this sequence number
+        if (m_enablePerPingLogging) {
+            m_replyTimestamps[slot].at(seqNo) = reply_ns;
+            m_receiveReplyTimestamps[slot].at(seqNo) = receive_reply_ns;
+        }
+
+    }
+}
+
+uint32_t UdpPingAgent::GetNumPings() {
+    return m_udpPingIds.size();
+}
+
+int64_t UdpPingAgent::GetUdpPingIdOf(uint32_t slot) {
+    return m_udpPingIds.at(slot);
+}
+
+uint32_t UdpPingAgent::GetSentOf(uint32_t slot) {
+    return m_sent.at(slot);
+}
+
+bool UdpPingAgent::IsPerPingLoggingEnabled() {
+    return m_enablePerPingLogging;
+}
+
+const std::vector<int64_t>& UdpPingAgent::GetSendRequestTimestampsOf(uint32_t slot) {
+    return m_sendRequestTimestamps.at(slot);
+}
+
+const std::vector<int64_t>& UdpPingAgent::GetReplyTimestampsOf(uint32_t slot) {
+    return m_replyTimestamps.at(slot);
+}
+
+const std::vector<int64_t>& UdpPingAgent::GetReceiveReplyTimestampsOf(uint32_t slot) {
+    return m_receiveReplyTimestamps.at(slot);
+}
+
+const RunningStatistics& UdpPingAgent::GetLatencyThereStatisticsOf(uint32_t slot) {
+    return m_latencyThereStatistics.at(slot);
+}
+
+const RunningStatistics& UdpPingAgent::GetLatencyBackStatisticsOf(uint32_t slot) {
+    return m_latencyBackStatistics.at(slot);
+}
+
+const RunningStatistics& UdpPingAgent::GetRttStatisticsOf(uint32_t slot) {
+    return m_rttStatistics.at(slot);
+}
+
+const LatencySketch& UdpPingAgent::GetRttSketchOf(uint32_t slot) {
+    return m_rttSketch.at(slot);
+}
+
+} // Namespace ns3
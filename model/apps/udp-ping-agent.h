@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef UDP_PING_AGENT_H
+#define UDP_PING_AGENT_H
+
+#include <queue>
+#include <algorithm>
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ptr.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/udp-ping-header.h"
+#include "ns3/socket-generator.h"
+#include "ns3/running-statistics.h"
+#include "ns3/latency-sketch.h"
+
+namespace ns3 {
+
+class Socket;
+class Packet;
+
+/**
+ * Sends the UDP pings of all pairs starting at a node, which makes a large pingmesh
+ * feasible compared to installing a UdpPingClient for each pair. It has a single socket
+ * for all of them, a single send event which always is at the earliest next send time
+ * among its pings, and it keeps the state of each ping in flat arrays indexed by the
+ * slot of the ping at the agent. The replies are sent back by a regular UdpPingServer.
+ */
+class UdpPingAgent : public Application
+{
+public:
+  static TypeId GetTypeId (void);
+  UdpPingAgent ();
+  virtual ~UdpPingAgent ();
+
+  void SetUdpSocketGenerator(Ptr<UdpSocketGenerator> udpSocketGenerator);
+  void SetIpTos(uint8_t ipTos);
+  uint32_t AddPing(int64_t udpPingId, InetSocketAddress remoteAddress, int64_t startTimeNs, int64_t intervalNs, int64_t durationNs, int64_t waitAfterwardsNs);
+
+  uint32_t GetNumPings();
+  int64_t GetUdpPingIdOf(uint32_t slot);
+  uint32_t GetSentOf(uint32_t slot);
+  bool IsPerPingLoggingEnabled();
+  const std::vector<int64_t>& GetSendRequestTimestampsOf(uint32_t slot);
+  const std::vector<int64_t>& GetReplyTimestampsOf(uint32_t slot);
+  const std::vector<int64_t>& GetReceiveReplyTimestampsOf(uint32_t slot);
+  const RunningStatistics& GetLatencyThereStatisticsOf(uint32_t slot);
+  const RunningStatistics& GetLatencyBackStatisticsOf(uint32_t slot);
+  const RunningStatistics& GetRttStatisticsOf(uint32_t slot);
+  const LatencySketch& GetRttSketchOf(uint32_t slot);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+  void Finish ();
+  void ScheduleNextSend ();
+  void SendDue (void);
+  void Send (uint32_t slot, int64_t now_ns);
+  void HandleRead (Ptr<Socket> socket);
+
+  // Parameters
+  Address m_localAddress;                //!< Local address (IP, port)
+  bool m_enablePerPingLogging;           //!< True iff the timestamps of each ping are kept (else only the statistics)
+  Ptr<UdpSocketGenerator> m_udpSocketGenerator;  //!< UDP socket generator
+  uint8_t m_ipTos;                       //!< IP TOS of all pings
+
+  // State
+  Ptr<Socket> m_socket;         //!< Socket shared by all pings
+  EventId m_sendEvent;          //!< Event to send the pings which are due next
+  EventId m_waitForFinishEvent; //!< Event to wait to finish the agent
+  int64_t m_finishTimeNs;       //!< Time after which no ping waits for replies anymore
+  std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>, std::greater<std::pair<int64_t, uint32_t>>> m_sendQueue; //!< (next send time (ns), slot) of each ping which still has to send
+
+  // Each ping (indexed by slot, in ascending UDP ping ID)
+  std::vector<int64_t> m_udpPingIds;                 //!< Unique UDP ping identifier
+  std::vector<InetSocketAddress> m_remoteAddresses;  //!< Remote (server) address (IP, port)
+  std::vector<int64_t> m_startTimeNs;                //!< Start time (ns)
+  std::vector<int64_t> m_intervalNs;                 //!< Packet inter-send time (ns)
+  std::vector<int64_t> m_durationNs;                 //!< Duration of the sending (ns)
+  std::vector<int64_t> m_waitAfterwardsNs;           //!< How long to wait for replies after the duration is over (ns)
+  std::vector<uint32_t> m_sent;                      //!< Counter for sent packets
+
+  // Statistics of the replies which arrived of each ping
+  std::vector<std::vector<bool>> m_replyArrived;              //!< True iff the reply of the ping with that sequence number arrived
+  std::vector<RunningStatistics> m_latencyThereStatistics;    //!< Latency there (ns)
+  std::vector<RunningStatistics> m_latencyBackStatistics;     //!< Latency back (ns)
+  std::vector<RunningStatistics> m_rttStatistics;             //!< Round-trip time (ns)
+  std::vector<LatencySketch> m_rttSketch;                     //!< Round-trip time (ns) quantile sketch
+
+  // Logging of each ping (only if per-ping logging is enabled)
+  std::vector<std::vector<int64_t>> m_sendRequestTimestamps;
+  std::vector<std::vector<int64_t>> m_replyTimestamps;
+  std::vector<std::vector<int64_t>> m_receiveReplyTimestamps;
+
+};
+
+} // namespace ns3
+
+#endif /* UDP_PING_AGENT_H */
@@ -27,6 +27,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "udp-ping-client.h"
 
@@ -78,7 +79,14 @@ UdpPingClient::GetTypeId(void) {
                            "Additional parameters (unused; reserved for future use)",
                            StringValue (""),
                            MakeStringAccessor (&UdpPingClient::m_additionalParameters),
-                           MakeStringChecker());
+                           MakeStringChecker())
+            .AddAttribute("EnablePerPingLogging",
+                          "True iff the timestamps of each ping are kept. If false, only the running statistics "
+                          "of the latencies and the number of replies are kept, which take constant memory apart from "
+                          "one bit per sent ping (to know whether its reply arrived).",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&UdpPingClient::m_enablePerPingLogging),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -185,9 +193,12 @@ UdpPingClient::Send(void) {
     p->AddHeader(pingHeader);
 
     // Timestamps
-    m_sendRequestTimestamps.push_back(now_ns);
-    m_replyTimestamps.push_back(-1);
-    m_receiveReplyTimestamps.push_back(-1);
+    m_replyArrived.push_back(false);
+    if (m_enablePerPingLogging) {
+        m_sendRequestTimestamps.push_back(now_ns);
+        m_replyTimestamps.push_back(-1);
+        m_receiveReplyTimestamps.push_back(-1);
+    }
     m_sent++;
 
     // Send out
@@ -225,12 +236,26 @@ UdpPingClient::HandleRead(Ptr <Socket> socket) {
         if (pingHeader.GetId() == m_udpPingId) {
 
             // Sanity checks
-            NS_ABORT_MSG_IF(seqNo >= m_sendRequestTimestamps.size(), "Sequence number has not (yet) been sent out.");
-            NS_ABORT_MSG_IF(m_replyTimestamps.at(seqNo) != -1 || m_receiveReplyTimestamps.at(seqNo) != -1, "Already got reply for this sequence number.");
+            NS_ABORT_MSG_IF(seqNo >= m_sent, "Sequence number has not (yet) been sent out.");
+            NS_ABORT_MSG_IF(m_replyArrived[seqNo], "Already got reply for this sequence number.");
+            m_replyArrived[seqNo] = true;
+
+            // Pings are sent at a fixed interval from the start, so the send timestamp follows from the sequence number
+            int64_t send_request_ns = m_startTime.GetNanoSeconds() + seqNo * m_interval.GetNanoSeconds();
+            int64_t reply_ns = pingHeader.GetTs();
+            int64_t receive_reply_ns = Simulator::Now().GetNanoSeconds();
+
+            // Update the statistics
+            m_latencyThereStatistics.Add(reply_ns - send_request_ns);
+            m_latencyBackStatistics.Add(receive_reply_ns - reply_ns);
+            m_rttStatistics.Add(receive_reply_ns - send_request_ns);
+            m_rttSketch.Add(receive_reply_ns - send_request_ns);
 
             // Update the timestamps for this sequence number
-            m_replyTimestamps.at(seqNo) = pingHeader.GetTs();
-            m_receiveReplyTimestamps.at(seqNo) = Simulator::Now().GetNanoSeconds();
+            if (m_enablePerPingLogging) {
+                m_replyTimestamps.at(seqNo) = reply_ns;
+                m_receiveReplyTimestamps.at(seqNo) = receive_reply_ns;
+            }
 
         }
 
@@ -249,16 +274,36 @@ uint32_t UdpPingClient::GetSent() {
     return m_sent;
 }
 
-std::vector<int64_t> UdpPingClient::GetSendRequestTimestamps() {
+bool UdpPingClient::IsPerPingLoggingEnabled() {
+    return m_enablePerPingLogging;
+}
+
+const std::vector<int64_t>& UdpPingClient::GetSendRequestTimestamps() {
     return m_sendRequestTimestamps;
 }
 
-std::vector<int64_t> UdpPingClient::GetReplyTimestamps() {
+const std::vector<int64_t>& UdpPingClient::GetReplyTimestamps() {
     return m_replyTimestamps;
 }
 
-std::vector<int64_t> UdpPingClient::GetReceiveReplyTimestamps() {
+const std::vector<int64_t>& UdpPingClient::GetReceiveReplyTimestamps() {
     return m_receiveReplyTimestamps;
 }
 
+const RunningStatistics& UdpPingClient::GetLatencyThereStatistics() {
+    return m_latencyThereStatistics;
+}
+
+const RunningStatistics& UdpPingClient::GetLatencyBackStatistics() {
+    return m_latencyBackStatistics;
+}
+
+const RunningStatistics& UdpPingClient::GetRttStatistics() {
+    return m_rttStatistics;
+}
+
+const LatencySketch& UdpPingClient::GetRttSketch() {
+    return m_rttSketch;
+}
+
 } // Namespace ns3
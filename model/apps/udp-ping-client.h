@@ -27,6 +27,8 @@
 #include "ns3/traced-callback.h"
 #include "ns3/udp-ping-header.h"
 #include "ns3/socket-generator.h"
+#include "ns3/running-statistics.h"
+#include "ns3/latency-sketch.h"
 
 namespace ns3 {
 
@@ -47,9 +49,14 @@ public:
   std::string GetAdditionalParameters();
 
   uint32_t GetSent();
-  std::vector<int64_t> GetSendRequestTimestamps();
-  std::vector<int64_t> GetReplyTimestamps();
-  std::vector<int64_t> GetReceiveReplyTimestamps();
+  bool IsPerPingLoggingEnabled();
+  const std::vector<int64_t>& GetSendRequestTimestamps();
+  const std::vector<int64_t>& GetReplyTimestamps();
+  const std::vector<int64_t>& GetReceiveReplyTimestamps();
+  const RunningStatistics& GetLatencyThereStatistics();
+  const RunningStatistics& GetLatencyBackStatistics();
+  const RunningStatistics& GetRttStatistics();
+  const LatencySketch& GetRttSketch();
 
 protected:
   virtual void DoDispose (void);
@@ -71,6 +78,7 @@ private:
   Time m_duration;                       //!< Duration of the sending
   Time m_waitAfterwards;                 //!< How long to wait after the duration is over before closing socket
   std::string m_additionalParameters;    //!< Additional parameters (unused; reserved for future use)
+  bool m_enablePerPingLogging;          //!< True iff the timestamps of each ping are kept (else only the statistics)
   Ptr<UdpSocketGenerator> m_udpSocketGenerator;  //!< UDP socket generator
 
   // State
@@ -80,7 +88,14 @@ private:
   EventId m_waitForFinishEvent; //!< Event to wait to finish the client
   uint32_t m_sent;              //!< Counter for sent packets
 
-  // Logging
+  // Statistics of the replies which arrived
+  std::vector<bool> m_replyArrived;             //!< True iff the reply of the ping with that sequence number arrived
+  RunningStatistics m_latencyThereStatistics;   //!< Latency there (ns)
+  RunningStatistics m_latencyBackStatistics;    //!< Latency back (ns)
+  RunningStatistics m_rttStatistics;            //!< Round-trip time (ns)
+  LatencySketch m_rttSketch;                    //!< Round-trip time (ns) quantile sketch
+
+  // Logging (only if per-ping logging is enabled)
   std::vector<int64_t> m_sendRequestTimestamps;
   std::vector<int64_t> m_replyTimestamps;
   std::vector<int64_t> m_receiveReplyTimestamps;
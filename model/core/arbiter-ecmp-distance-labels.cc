@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "arbiter-ecmp-distance-labels.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (ArbiterEcmpDistanceLabels);
+TypeId ArbiterEcmpDistanceLabels::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::ArbiterEcmpDistanceLabels")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+const uint8_t ArbiterEcmpDistanceLabels::UNREACHABLE;
+
+ArbiterEcmpDistanceLabels::ArbiterEcmpDistanceLabels(
+        int64_t num_nodes,
+        const std::vector<int64_t>& adjacency_offsets,
+        const std::vector<uint32_t>& adjacency_neighbors,
+        const std::set<int64_t>& destinations,
+        const std::set<int64_t>& servers
+) {
+    if (num_nodes < 0 || num_nodes > INT32_MAX) {
+        throw std::invalid_argument(format_string("Invalid number of nodes for the ECMP distance labels: %" PRId64, num_nodes));
+    }
+    if (adjacency_offsets.size() != (size_t) num_nodes + 1) {
+        throw std::invalid_argument("Adjacency offsets must have exactly one more entry than there are nodes");
+    }
+    m_num_nodes = num_nodes;
+    m_adjacency_offsets = adjacency_offsets;
+    m_adjacency_neighbors = adjacency_neighbors;
+
+    // Single-homed servers are reached via the label of their ToR
+    m_destination_label = std::vector<int32_t>(num_nodes, -1);
+    m_destination_last_hop = std::vector<int32_t>(num_nodes, -1);
+    std::map<int64_t, int32_t> label_node_id_to_label;
+    for (int64_t t : destinations) {
+        if (t < 0 || t >= num_nodes) {
+            throw std::invalid_argument(format_string("Destination node %" PRId64 " does not exist", t));
+        }
+        int64_t label_node_id = t;
+        if (servers.find(t) != servers.end() && m_adjacency_offsets[t + 1] - m_adjacency_offsets[t] == 1) {
+            label_node_id = m_adjacency_neighbors[m_adjacency_offsets[t]];
+            m_destination_last_hop[t] = (int32_t) label_node_id;
+        }
+        std::map<int64_t, int32_t>::iterator it = label_node_id_to_label.find(label_node_id);
+        if (it == label_node_id_to_label.end()) {
+            it = label_node_id_to_label.insert(std::make_pair(label_node_id, (int32_t) m_label_node_ids.size())).first;
+            m_label_node_ids.push_back(label_node_id);
+        }
+        m_destination_label[t] = it->second;
+    }
+
+    // Initially everything is unreachable
+    m_distances = std::vector<uint8_t>(m_label_node_ids.size() * num_nodes, UNREACHABLE);
+
+}
+
+ArbiterEcmpDistanceLabels::~ArbiterEcmpDistanceLabels() {
+    // Left empty intentionally
+}
+
+/**
+ * Set the hop distance of a node to a label.
+ *
+ * @param label_idx     Label index
+ * @param node_id       Node identifier
+ * @param distance      Hop distance (must be less than UNREACHABLE)
+ */
+void ArbiterEcmpDistanceLabels::SetDistance(int64_t label_idx, int64_t node_id, int64_t distance) {
+    if (distance < 0 || distance >= UNREACHABLE) {
+        throw std::invalid_argument(format_string(
+                "Distance %" PRId64 " of node %" PRId64 " cannot be stored in the ECMP distance labels (maximum is %d)",
+                distance, node_id, UNREACHABLE - 1
+        ));
+    }
+    m_distances.at(label_idx * m_num_nodes + node_id) = (uint8_t) distance;
+}
+
+int64_t ArbiterEcmpDistanceLabels::GetNumNodes() const {
+    return m_num_nodes;
+}
+
+int64_t ArbiterEcmpDistanceLabels::GetNumLabels() const {
+    return m_label_node_ids.size();
+}
+
+int64_t ArbiterEcmpDistanceLabels::GetLabelNodeId(int64_t label_idx) const {
+    return m_label_node_ids.at(label_idx);
+}
+
+const std::vector<int64_t>& ArbiterEcmpDistanceLabels::GetAdjacencyOffsets() const {
+    return m_adjacency_offsets;
+}
+
+const std::vector<uint32_t>& ArbiterEcmpDistanceLabels::GetAdjacencyNeighbors() const {
+    return m_adjacency_neighbors;
+}
+
+bool ArbiterEcmpDistanceLabels::IsDestination(int64_t node_id) const {
+    return m_destination_label.at(node_id) != -1;
+}
+
+/**
+ * Derive the number of candidate next hops of a node towards a destination.
+ *
+ * @param node_id                   Current node identifier
+ * @param destination_node_id       Destination node identifier
+ *
+ * @return Number of candidate next hops
+ */
+uint32_t ArbiterEcmpDistanceLabels::GetNumCandidates(int64_t node_id, int64_t destination_node_id) const {
+    int32_t label = m_destination_label.at(destination_node_id);
+    if (label == -1) {
+        throw std::invalid_argument(format_string(
+                "Node %" PRId64 " is not a destination in the ECMP distance labels", destination_node_id
+        ));
+    }
+    if (node_id == destination_node_id) {
+        return 0;
+    }
+    if (node_id == m_destination_last_hop[destination_node_id]) {
+        return 1;
+    }
+    const uint8_t* dist = &m_distances[label * m_num_nodes];
+    uint8_t dist_node = dist[node_id];
+    if (dist_node == UNREACHABLE || dist_node == 0) {
+        return 0;
+    }
+    uint32_t num_candidates = 0;
+    for (int64_t k = m_adjacency_offsets[node_id]; k < m_adjacency_offsets[node_id + 1]; k++) {
+        if (dist[m_adjacency_neighbors[k]] == dist_node - 1) {
+            num_candidates++;
+        }
+    }
+    return num_candidates;
+}
+
+/**
+ * Derive a candidate next hop of a node towards a destination.
+ * The candidates are in ascending order of node identifier.
+ *
+ * @param node_id                   Current node identifier
+ * @param destination_node_id       Destination node identifier
+ * @param idx                       Index of the candidate (less than the number of candidates)
+ *
+ * @return Candidate next hop node identifier
+ */
+uint32_t ArbiterEcmpDistanceLabels::GetCandidate(int64_t node_id, int64_t destination_node_id, uint32_t idx) const {
+    int32_t label = m_destination_label.at(destination_node_id);
+    if (label != -1 && node_id != destination_node_id) {
+        if (node_id == m_destination_last_hop[destination_node_id]) {
+            if (idx == 0) {
+                return (uint32_t) destination_node_id;
+            }
+        } else {
+            const uint8_t* dist = &m_distances[label * m_num_nodes];
+            uint8_t dist_node = dist[node_id];
+            if (dist_node != UNREACHABLE && dist_node != 0) {
+                uint32_t i = 0;
+                for (int64_t k = m_adjacency_offsets[node_id]; k < m_adjacency_offsets[node_id + 1]; k++) {
+                    if (dist[m_adjacency_neighbors[k]] == dist_node - 1) {
+                        if (i == idx) {
+                            return m_adjacency_neighbors[k];
+                        }
+                        i++;
+                    }
+                }
+            }
+        }
+    }
+    throw std::out_of_range("Candidate index is out of range");
+}
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef ARBITER_ECMP_DISTANCE_LABELS_H
+#define ARBITER_ECMP_DISTANCE_LABELS_H
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Destination-only ECMP routing state shared by all ECMP arbiters.
+ *
+ * Instead of storing the candidate next hops for every (node, destination) pair, it only stores
+ * the hop distance of every node to every label. The candidate next hops of node a towards
+ * destination t are derived at decision time: these are the neighbors b of a for which
+ * distance(b, t) == distance(a, t) - 1.
+ *
+ * There is a label for every destination, except for servers which are connected to only a single
+ * ToR: these share the label of their ToR, as distance(x, server) == distance(x, ToR) + 1 for any
+ * node x other than the server itself. Distances are stored as a single byte each.
+ *
+ * The distances are set once (distinct labels can be set concurrently) after which it is immutable.
+ */
+class ArbiterEcmpDistanceLabels : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    ArbiterEcmpDistanceLabels(
+            int64_t num_nodes,
+            const std::vector<int64_t>& adjacency_offsets,
+            const std::vector<uint32_t>& adjacency_neighbors,
+            const std::set<int64_t>& destinations,
+            const std::set<int64_t>& servers
+    );
+    virtual ~ArbiterEcmpDistanceLabels();
+
+    // Construction
+    void SetDistance(int64_t label_idx, int64_t node_id, int64_t distance);
+
+    // Retrieval
+    int64_t GetNumNodes() const;
+    int64_t GetNumLabels() const;
+    int64_t GetLabelNodeId(int64_t label_idx) const;
+    const std::vector<int64_t>& GetAdjacencyOffsets() const;
+    const std::vector<uint32_t>& GetAdjacencyNeighbors() const;
+    bool IsDestination(int64_t node_id) const;
+    uint32_t GetNumCandidates(int64_t node_id, int64_t destination_node_id) const;
+    uint32_t GetCandidate(int64_t node_id, int64_t destination_node_id, uint32_t idx) const;
+
+    // Distance which indicates it is not reachable
+    static const uint8_t UNREACHABLE = 255;
+
+private:
+    int64_t m_num_nodes;
+    std::vector<int64_t> m_adjacency_offsets;       // Neighbors of node i are at [offsets[i], offsets[i + 1])
+    std::vector<uint32_t> m_adjacency_neighbors;    // In ascending order for each node
+    std::vector<int32_t> m_destination_label;       // -1 if the node is not a destination
+    std::vector<int32_t> m_destination_last_hop;    // -1 if the destination has its own label, else its only neighbor (ToR)
+    std::vector<int64_t> m_label_node_ids;
+    std::vector<uint8_t> m_distances;               // Distance of node x to label l at [l * n + x]
+};
+
+}
+
+#endif //ARBITER_ECMP_DISTANCE_LABELS_H
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "arbiter-ecmp-flow-tag.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (ArbiterEcmpFlowTag);
+
+TypeId
+ArbiterEcmpFlowTag::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::ArbiterEcmpFlowTag")
+            .SetParent<Tag> ()
+            .SetGroupName("BasicSim")
+            .AddConstructor<ArbiterEcmpFlowTag> ()
+    ;
+    return tid;
+}
+
+ArbiterEcmpFlowTag::ArbiterEcmpFlowTag ()
+  : m_source_port (0),
+    m_destination_port (0)
+{
+    // Left empty intentionally
+}
+
+void
+ArbiterEcmpFlowTag::SetSourcePort (uint16_t source_port)
+{
+    m_source_port = source_port;
+}
+
+void
+ArbiterEcmpFlowTag::SetDestinationPort (uint16_t destination_port)
+{
+    m_destination_port = destination_port;
+}
+
+uint16_t
+ArbiterEcmpFlowTag::GetSourcePort (void) const
+{
+    return m_source_port;
+}
+
+uint16_t
+ArbiterEcmpFlowTag::GetDestinationPort (void) const
+{
+    return m_destination_port;
+}
+
+TypeId
+ArbiterEcmpFlowTag::GetInstanceTypeId (void) const
+{
+    return GetTypeId ();
+}
+
+uint32_t
+ArbiterEcmpFlowTag::GetSerializedSize (void) const
+{
+    return 2+2;
+}
+
+void
+ArbiterEcmpFlowTag::Serialize (TagBuffer i) const
+{
+    i.WriteU16 (m_source_port);
+    i.WriteU16 (m_destination_port);
+}
+
+void
+ArbiterEcmpFlowTag::Deserialize (TagBuffer i)
+{
+    m_source_port = i.ReadU16 ();
+    m_destination_port = i.ReadU16 ();
+}
+
+void
+ArbiterEcmpFlowTag::Print (std::ostream &os) const
+{
+    os << "(source_port=" << m_source_port << ", destination_port=" << m_destination_port << ")";
+}
+
+} // namespace ns3
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef ARBITER_ECMP_FLOW_TAG_H
+#define ARBITER_ECMP_FLOW_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+/**
+ * Packet tag attached once on the sender (at its RouteOutput) which carries the
+ * source and destination port of the TCP/UDP header. Every subsequent hop reads the
+ * ports from it instead of from the transport header, and combines them with the
+ * IP addresses and its node identifier into the same 5-tuple hash as before.
+ */
+class ArbiterEcmpFlowTag : public Tag
+{
+public:
+    static TypeId GetTypeId (void);
+
+    ArbiterEcmpFlowTag ();
+    void SetSourcePort (uint16_t source_port);
+    void SetDestinationPort (uint16_t destination_port);
+    uint16_t GetSourcePort (void) const;
+    uint16_t GetDestinationPort (void) const;
+
+    virtual TypeId GetInstanceTypeId (void) const;
+    virtual uint32_t GetSerializedSize (void) const;
+    virtual void Serialize (TagBuffer i) const;
+    virtual void Deserialize (TagBuffer i);
+    virtual void Print (std::ostream &os) const;
+
+private:
+    uint16_t m_source_port;       //!< Source port of the TCP/UDP header
+    uint16_t m_destination_port;  //!< Destination port of the TCP/UDP header
+};
+
+} // namespace ns3
+
+#endif /* ARBITER_ECMP_FLOW_TAG_H */
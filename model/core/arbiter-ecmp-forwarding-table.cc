@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "arbiter-ecmp-forwarding-table.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (ArbiterEcmpForwardingTable);
+TypeId ArbiterEcmpForwardingTable::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::ArbiterEcmpForwardingTable")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+ArbiterEcmpForwardingTable::ArbiterEcmpForwardingTable(int64_t num_nodes)
+        : ArbiterEcmpForwardingTable(num_nodes, std::vector<bool>(std::max(num_nodes, (int64_t) 0), true)) {
+    // Left empty intentionally
+}
+
+/**
+ * Constructor which only stores the rows (candidates towards all destinations) of a subset of the nodes.
+ *
+ * @param num_nodes         Number of nodes
+ * @param stored_nodes      For each node, whether its row is stored
+ */
+ArbiterEcmpForwardingTable::ArbiterEcmpForwardingTable(int64_t num_nodes, const std::vector<bool>& stored_nodes) {
+    if (num_nodes < 0 || num_nodes > (int64_t) UINT32_MAX) {
+        throw std::invalid_argument(format_string("Invalid number of nodes for the ECMP forwarding table: %" PRId64, num_nodes));
+    }
+    if (stored_nodes.size() != (size_t) num_nodes) {
+        throw std::invalid_argument(format_string(
+                "Stored nodes must have an entry for each of the %" PRId64 " nodes (has: %" PRIu64 ")", num_nodes, stored_nodes.size()
+        ));
+    }
+    m_num_nodes = num_nodes;
+    m_allocated = false;
+    m_compact_next_hops = num_nodes <= 65536;
+    m_num_stored_nodes = 0;
+    m_row_start = std::vector<int64_t>(num_nodes, -1);
+    for (int64_t a = 0; a < num_nodes; a++) {
+        if (stored_nodes[a]) {
+            m_row_start[a] = m_num_stored_nodes * (num_nodes + 1);
+            m_num_stored_nodes++;
+        }
+    }
+    m_node_base = std::vector<uint64_t>(num_nodes + 1, 0);
+    m_offsets = std::vector<uint32_t>(m_num_stored_nodes * (num_nodes + 1), 0);
+    m_row_start_data = m_row_start.data();
+    m_node_base_data = m_node_base.data();
+    m_offsets_data = m_offsets.data();
+    m_next_hops_16_data = nullptr;
+    m_next_hops_32_data = nullptr;
+    m_mapped_data = nullptr;
+    m_mapped_size = 0;
+}
+
+/**
+ * Size of an array in the cache file, padded to a multiple of 8 bytes.
+ *
+ * @param num_bytes     Size of the array (byte)
+ *
+ * @return Padded size (byte)
+ */
+static uint64_t cache_padded_size(uint64_t num_bytes) {
+    return (num_bytes + 7) / 8 * 8;
+}
+
+static const size_t CACHE_HEADER_SIZE = 48;
+
+/**
+ * Check that the arrays of a mapped cache file are consistent, such that no lookup
+ * can read beyond them.
+ *
+ * @param n                     Number of nodes
+ * @param num_stored_nodes      Number of stored nodes
+ * @param total_num_candidates  Total number of candidate next hops
+ * @param compact               True iff the next hops are 16-bit
+ * @param row_start             Start of the row of each node in the offsets (-1 if not stored)
+ * @param node_base             Base of each node in the next hops
+ * @param offsets               Offsets of the stored rows
+ * @param next_hops             Next hops
+ *
+ * @return Empty if consistent, else what is wrong
+ */
+static std::string check_cache_arrays(
+        uint64_t n,
+        uint64_t num_stored_nodes,
+        uint64_t total_num_candidates,
+        bool compact,
+        const int64_t* row_start,
+        const uint64_t* node_base,
+        const uint32_t* offsets,
+        const char* next_hops
+) {
+    uint64_t num_rows = 0;
+    for (uint64_t a = 0; a < n; a++) {
+        if (row_start[a] != -1) {
+            if (row_start[a] != (int64_t) (num_rows * (n + 1))) {
+                return "its row starts are invalid";
+            }
+            num_rows++;
+        }
+    }
+    if (num_rows != num_stored_nodes) {
+        return "its row starts are invalid";
+    }
+    if (node_base[0] != 0 || node_base[n] != total_num_candidates) {
+        return "its node bases are invalid";
+    }
+    for (uint64_t a = 0; a < n; a++) {
+        if (node_base[a + 1] < node_base[a]) {
+            return "its node bases are invalid";
+        }
+        uint64_t num_candidates = node_base[a + 1] - node_base[a];
+        if (row_start[a] == -1) {
+            if (num_candidates != 0) {
+                return "its node bases are invalid";
+            }
+            continue;
+        }
+        const uint32_t* row = offsets + row_start[a];
+        if (row[0] != 0 || row[n] != num_candidates) {
+            return "its offsets are invalid";
+        }
+        for (uint64_t t = 0; t < n; t++) {
+            if (row[t + 1] < row[t]) {
+                return "its offsets are invalid";
+            }
+        }
+    }
+    for (uint64_t i = 0; i < total_num_candidates; i++) {
+        uint32_t next_hop_node_id = compact ? ((const uint16_t*) next_hops)[i] : ((const uint32_t*) next_hops)[i];
+        if (next_hop_node_id >= n) {
+            return "its next hops are invalid";
+        }
+    }
+    return "";
+}
+
+/**
+ * Constructor which maps a cache file (written by SaveToFile()) read-only into memory.
+ *
+ * @param cache_filename    Cache file name
+ * @param expected_key      Key of the inputs the table must have been calculated from
+ */
+ArbiterEcmpForwardingTable::ArbiterEcmpForwardingTable(const std::string& cache_filename, uint64_t expected_key) {
+
+    // Map the file
+    int fd = open(cache_filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s could not be opened.", cache_filename.c_str()));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < CACHE_HEADER_SIZE) {
+        close(fd);
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s is too small.", cache_filename.c_str()));
+    }
+    m_mapped_size = (size_t) info.st_size;
+    m_mapped_data = mmap(nullptr, m_mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping remains valid
+    if (m_mapped_data == MAP_FAILED) {
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s could not be mapped into memory.", cache_filename.c_str()));
+    }
+    const char* data = (const char*) m_mapped_data;
+
+    // Header
+    uint32_t version;
+    uint64_t key;
+    uint64_t compact;
+    uint64_t total_num_candidates;
+    memcpy(&version, data + 4, 4);
+    memcpy(&key, data + 8, 8);
+    memcpy(&m_num_nodes, data + 16, 8);
+    memcpy(&m_num_stored_nodes, data + 24, 8);
+    memcpy(&compact, data + 32, 8);
+    memcpy(&total_num_candidates, data + 40, 8);
+    std::string error;
+    if (memcmp(data, "BSFT", 4) != 0) {
+        error = "it is not an ECMP forwarding table cache";
+    } else if (version != 1) {
+        error = format_string("unsupported version %u", version);
+    } else if (key != expected_key) {
+        error = "its key does not match the inputs";
+    } else if (m_num_nodes < 0 || m_num_nodes > (int64_t) UINT32_MAX || m_num_stored_nodes < 0 || m_num_stored_nodes > m_num_nodes) {
+        error = "it has an invalid number of nodes";
+    } else if (compact > 1 || (compact == 1 && m_num_nodes > 65536)) {
+        error = "it has an invalid next hop size";
+    } else if ((uint64_t) m_num_nodes > m_mapped_size / 8
+               || (uint64_t) m_num_stored_nodes > m_mapped_size / 4 / ((uint64_t) m_num_nodes + 1)
+               || total_num_candidates > m_mapped_size / 2) {
+        error = "its size does not match its header"; // Checked first such that the sizes below cannot overflow
+    }
+    uint64_t n = (uint64_t) m_num_nodes;
+    uint64_t row_start_size = cache_padded_size(n * 8);
+    uint64_t node_base_size = cache_padded_size((n + 1) * 8);
+    uint64_t offsets_size = cache_padded_size((uint64_t) m_num_stored_nodes * (n + 1) * 4);
+    uint64_t next_hops_size = cache_padded_size(total_num_candidates * (compact ? 2 : 4));
+    if (error.empty() && m_mapped_size != CACHE_HEADER_SIZE + row_start_size + node_base_size + offsets_size + next_hops_size) {
+        error = "its size does not match its header";
+    }
+
+    // Contents, such that a corrupt file cannot lead to reads beyond the mapping
+    if (error.empty()) {
+        error = check_cache_arrays(
+                n,
+                (uint64_t) m_num_stored_nodes,
+                total_num_candidates,
+                compact == 1,
+                (const int64_t*) (data + CACHE_HEADER_SIZE),
+                (const uint64_t*) (data + CACHE_HEADER_SIZE + row_start_size),
+                (const uint32_t*) (data + CACHE_HEADER_SIZE + row_start_size + node_base_size),
+                data + CACHE_HEADER_SIZE + row_start_size + node_base_size + offsets_size
+        );
+    }
+    if (!error.empty()) {
+        munmap(m_mapped_data, m_mapped_size);
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s cannot be used: %s.", cache_filename.c_str(), error.c_str()));
+    }
+
+    // Arrays (all 8-byte aligned as the mapping is page-aligned)
+    m_allocated = true;
+    m_compact_next_hops = compact == 1;
+    m_row_start_data = (const int64_t*) (data + CACHE_HEADER_SIZE);
+    m_node_base_data = (const uint64_t*) (data + CACHE_HEADER_SIZE + row_start_size);
+    m_offsets_data = (const uint32_t*) (data + CACHE_HEADER_SIZE + row_start_size + node_base_size);
+    const char* next_hops = data + CACHE_HEADER_SIZE + row_start_size + node_base_size + offsets_size;
+    m_next_hops_16_data = m_compact_next_hops ? (const uint16_t*) next_hops : nullptr;
+    m_next_hops_32_data = m_compact_next_hops ? nullptr : (const uint32_t*) next_hops;
+
+}
+
+ArbiterEcmpForwardingTable::~ArbiterEcmpForwardingTable() {
+    if (m_mapped_data != nullptr) {
+        munmap(m_mapped_data, m_mapped_size);
+    }
+}
+
+/**
+ * Set the number of candidate next hops of a node towards a destination.
+ * The count is temporarily stored at the end offset position, which Allocate() then
+ * turns into the actual offset using a prefix sum.
+ *
+ * @param node_id                   Current node identifier
+ * @param destination_node_id       Destination node identifier
+ * @param num_candidates            Number of candidate next hops
+ */
+void ArbiterEcmpForwardingTable::SetNumCandidates(int64_t node_id, int64_t destination_node_id, uint32_t num_candidates) {
+    if (m_allocated) {
+        throw std::runtime_error("Cannot set the number of candidates after the ECMP forwarding table has been allocated");
+    }
+    if (!IsStored(node_id)) {
+        throw std::out_of_range(format_string("Node %" PRId64 " is not stored in the ECMP forwarding table", node_id));
+    }
+    m_offsets.at(m_row_start[node_id] + destination_node_id + 1) = num_candidates;
+}
+
+/**
+ * Calculate the offsets from the number of candidates and allocate the next-hop array.
+ */
+void ArbiterEcmpForwardingTable::Allocate() {
+    if (m_allocated) {
+        throw std::runtime_error("ECMP forwarding table has already been allocated");
+    }
+    for (int64_t a = 0; a < m_num_nodes; a++) {
+        if (m_row_start[a] == -1) {
+            m_node_base[a + 1] = m_node_base[a];
+            continue;
+        }
+        uint32_t* row = &m_offsets[m_row_start[a]];
+        uint64_t total = 0;
+        for (int64_t t = 1; t <= m_num_nodes; t++) {
+            total += row[t];
+            if (total > UINT32_MAX) {
+                throw std::runtime_error(format_string("Node %" PRId64 " has too many candidate next hops in total", a));
+            }
+            row[t] = (uint32_t) total;
+        }
+        m_node_base[a + 1] = m_node_base[a] + total;
+    }
+    if (m_compact_next_hops) {
+        m_next_hops_16 = std::vector<uint16_t>(m_node_base[m_num_nodes], 0);
+        m_next_hops_16_data = m_next_hops_16.data();
+    } else {
+        m_next_hops_32 = std::vector<uint32_t>(m_node_base[m_num_nodes], 0);
+        m_next_hops_32_data = m_next_hops_32.data();
+    }
+    m_allocated = true;
+}
+
+/**
+ * Set a candidate next hop of a node towards a destination.
+ *
+ * @param node_id                   Current node identifier
+ * @param destination_node_id       Destination node identifier
+ * @param idx                       Index of the candidate (less than the number of candidates)
+ * @param next_hop_node_id          Next hop node identifier
+ */
+void ArbiterEcmpForwardingTable::SetCandidate(int64_t node_id, int64_t destination_node_id, uint32_t idx, uint32_t next_hop_node_id) {
+    if (!m_allocated) {
+        throw std::runtime_error("Cannot set a candidate before the ECMP forwarding table has been allocated");
+    }
+    if (m_mapped_data != nullptr) {
+        throw std::runtime_error("Cannot set a candidate of an ECMP forwarding table loaded from a cache file");
+    }
+    if (!IsStored(node_id)) {
+        throw std::out_of_range(format_string("Node %" PRId64 " is not stored in the ECMP forwarding table", node_id));
+    }
+    if (idx >= GetNumCandidates(node_id, destination_node_id)) {
+        throw std::out_of_range("Candidate index is out of range");
+    }
+    uint64_t pos = m_node_base[node_id] + m_offsets[m_row_start[node_id] + destination_node_id] + idx;
+    if (m_compact_next_hops) {
+        m_next_hops_16[pos] = (uint16_t) next_hop_node_id;
+    } else {
+        m_next_hops_32[pos] = next_hop_node_id;
+    }
+}
+
+int64_t ArbiterEcmpForwardingTable::GetNumNodes() const {
+    return m_num_nodes;
+}
+
+uint64_t ArbiterEcmpForwardingTable::GetTotalNumCandidates() const {
+    return m_node_base_data[m_num_nodes];
+}
+
+bool ArbiterEcmpForwardingTable::IsUsingCompactNextHops() const {
+    return m_compact_next_hops;
+}
+
+bool ArbiterEcmpForwardingTable::IsStored(int64_t node_id) const {
+    if (node_id < 0 || node_id >= m_num_nodes) {
+        throw std::out_of_range(format_string("Node %" PRId64 " does not exist in the ECMP forwarding table", node_id));
+    }
+    return m_row_start_data[node_id] != -1;
+}
+
+int64_t ArbiterEcmpForwardingTable::GetNumStoredNodes() const {
+    return m_num_stored_nodes;
+}
+
+/**
+ * Write a filled table to a cache file. It is first written to a temporary file which is then
+ * renamed, such that concurrent runs never read a partially written cache file.
+ *
+ * @param cache_filename    Cache file name
+ * @param key               Key of the inputs the table was calculated from
+ */
+void ArbiterEcmpForwardingTable::SaveToFile(const std::string& cache_filename, uint64_t key) const {
+    if (!m_allocated) {
+        throw std::runtime_error("Cannot save an ECMP forwarding table which has not been allocated");
+    }
+    std::string temporary_filename = cache_filename + ".tmp" + std::to_string(getpid());
+    FILE* file = fopen(temporary_filename.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s could not be created.", temporary_filename.c_str()));
+    }
+
+    // Header
+    uint32_t version = 1;
+    uint64_t compact = m_compact_next_hops ? 1 : 0;
+    uint64_t total_num_candidates = GetTotalNumCandidates();
+    bool ok = fwrite("BSFT", 1, 4, file) == 4;
+    ok = ok && fwrite(&version, 4, 1, file) == 1;
+    ok = ok && fwrite(&key, 8, 1, file) == 1;
+    ok = ok && fwrite(&m_num_nodes, 8, 1, file) == 1;
+    ok = ok && fwrite(&m_num_stored_nodes, 8, 1, file) == 1;
+    ok = ok && fwrite(&compact, 8, 1, file) == 1;
+    ok = ok && fwrite(&total_num_candidates, 8, 1, file) == 1;
+
+    // Arrays, each padded to a multiple of 8 bytes
+    const uint64_t zero = 0;
+    std::vector<std::pair<const void*, uint64_t>> arrays = {
+            std::make_pair((const void*) m_row_start_data, (uint64_t) m_num_nodes * 8),
+            std::make_pair((const void*) m_node_base_data, (uint64_t) (m_num_nodes + 1) * 8),
+            std::make_pair((const void*) m_offsets_data, (uint64_t) m_num_stored_nodes * (m_num_nodes + 1) * 4),
+            m_compact_next_hops ?
+                std::make_pair((const void*) m_next_hops_16_data, total_num_candidates * 2) :
+                std::make_pair((const void*) m_next_hops_32_data, total_num_candidates * 4)
+    };
+    for (std::pair<const void*, uint64_t>& array : arrays) {
+        ok = ok && (array.second == 0 || fwrite(array.first, 1, array.second, file) == array.second);
+        uint64_t padding = cache_padded_size(array.second) - array.second;
+        ok = ok && (padding == 0 || fwrite(&zero, 1, padding, file) == padding);
+    }
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || rename(temporary_filename.c_str(), cache_filename.c_str()) != 0) {
+        remove_file_if_exists(temporary_filename);
+        throw std::runtime_error(format_string("ECMP forwarding table cache file %s could not be written.", cache_filename.c_str()));
+    }
+}
+
+bool ArbiterEcmpForwardingTable::IsLoadedFromFile() const {
+    return m_mapped_data != nullptr;
+}
+
+}
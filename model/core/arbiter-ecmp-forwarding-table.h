@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef ARBITER_ECMP_FORWARDING_TABLE_H
+#define ARBITER_ECMP_FORWARDING_TABLE_H
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Global ECMP forwarding table shared by all ECMP arbiters, stored in a compressed sparse row (CSR) format.
+ *
+ * The candidate next hops of node a towards destination t are located in the flat next-hop array at:
+ * [ node_base[a] + offsets[row_start[a] + t], node_base[a] + offsets[row_start[a] + t + 1] )
+ *
+ * Optionally only the rows of a subset of nodes are stored (e.g., in a distributed run only those
+ * of the nodes assigned to this system, as the others never make a forwarding decision here).
+ *
+ * The next-hop array uses 16-bit entries if all node identifiers fit (n <= 65536), else 32-bit entries.
+ *
+ * It is constructed in three steps:
+ * (1) SetNumCandidates() for each (node, destination) pair which has at least one candidate;
+ * (2) Allocate() to determine the offsets and to allocate the next-hop array;
+ * (3) SetCandidate() for each candidate next hop.
+ * Distinct (node, destination) pairs can be set concurrently in steps (1) and (3).
+ * After it has been filled, it is immutable and only read from.
+ *
+ * A filled table can be saved to a cache file, which later runs map into memory read-only
+ * instead of calculating the table again. The file starts with a header:
+ * <magic (4 bytes): "BSFT"><version (uint32): 1><key (uint64)><n (int64)><number of stored nodes (int64)>
+ * <compact (uint64): 0 or 1><total number of candidates (uint64)>
+ * followed by the arrays row_start (int64), node_base (uint64), offsets (uint32) and the next hops
+ * (uint16 if compact, else uint32), each padded to a multiple of 8 bytes. All values are in
+ * the byte order of the machine, as the cache is not meant to be moved between machines.
+ */
+class ArbiterEcmpForwardingTable : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    ArbiterEcmpForwardingTable(int64_t num_nodes);
+    ArbiterEcmpForwardingTable(int64_t num_nodes, const std::vector<bool>& stored_nodes);
+    ArbiterEcmpForwardingTable(const std::string& cache_filename, uint64_t expected_key);
+    virtual ~ArbiterEcmpForwardingTable();
+
+    // Construction
+    void SetNumCandidates(int64_t node_id, int64_t destination_node_id, uint32_t num_candidates);
+    void Allocate();
+    void SetCandidate(int64_t node_id, int64_t destination_node_id, uint32_t idx, uint32_t next_hop_node_id);
+
+    // Cache
+    void SaveToFile(const std::string& cache_filename, uint64_t key) const;
+    bool IsLoadedFromFile() const;
+
+    // Retrieval
+    int64_t GetNumNodes() const;
+    uint64_t GetTotalNumCandidates() const;
+    bool IsUsingCompactNextHops() const;
+    bool IsStored(int64_t node_id) const;
+    int64_t GetNumStoredNodes() const;
+    inline uint32_t GetNumCandidates(int64_t node_id, int64_t destination_node_id) const {
+        NS_ASSERT_MSG(node_id >= 0 && node_id < m_num_nodes && m_row_start_data[node_id] != -1, "Node is not stored in the ECMP forwarding table");
+        NS_ASSERT_MSG(destination_node_id >= 0 && destination_node_id < m_num_nodes, "Destination node is out of range");
+        const uint32_t* row = &m_offsets_data[m_row_start_data[node_id]];
+        return row[destination_node_id + 1] - row[destination_node_id];
+    }
+    inline uint32_t GetCandidate(int64_t node_id, int64_t destination_node_id, uint32_t idx) const {
+        NS_ASSERT_MSG(node_id >= 0 && node_id < m_num_nodes && m_row_start_data[node_id] != -1, "Node is not stored in the ECMP forwarding table");
+        NS_ASSERT_MSG(destination_node_id >= 0 && destination_node_id < m_num_nodes, "Destination node is out of range");
+        NS_ASSERT_MSG(idx < GetNumCandidates(node_id, destination_node_id), "Candidate index is out of range");
+        uint64_t pos = m_node_base_data[node_id] + m_offsets_data[m_row_start_data[node_id] + destination_node_id] + idx;
+        return m_compact_next_hops ? m_next_hops_16_data[pos] : m_next_hops_32_data[pos];
+    }
+
+private:
+    int64_t m_num_nodes;
+    bool m_allocated;
+    bool m_compact_next_hops;
+    int64_t m_num_stored_nodes;
+    std::vector<int64_t> m_row_start;       // Size: n, start of the row of each node in the offsets (-1 if not stored)
+    std::vector<uint64_t> m_node_base;      // Size: n + 1
+    std::vector<uint32_t> m_offsets;        // Size: (number of stored nodes) * (n + 1), relative to the node base
+    std::vector<uint16_t> m_next_hops_16;   // Only used if compact
+    std::vector<uint32_t> m_next_hops_32;   // Only used if not compact
+
+    // What is read from: either the vectors above, or the mapped cache file
+    const int64_t* m_row_start_data;
+    const uint64_t* m_node_base_data;
+    const uint32_t* m_offsets_data;
+    const uint16_t* m_next_hops_16_data;
+    const uint32_t* m_next_hops_32_data;
+    void* m_mapped_data;
+    size_t m_mapped_size;
+};
+
+}
+
+#endif //ARBITER_ECMP_FORWARDING_TABLE_H
@@ -34,22 +34,106 @@ ArbiterEcmp::ArbiterEcmp(
         Ptr<Node> this_node,
         NodeContainer nodes,
         Ptr<TopologyPtop> topology,
-        std::vector<std::vector<uint32_t>> candidate_list
+        Ptr<ArbiterEcmpForwardingTable> forwarding_table
 ) : ArbiterPtop(this_node, nodes, topology)
 {
-    m_candidate_list = candidate_list;
+    m_forwarding_table = forwarding_table;
+    m_flow_tag_enabled = false;
+    m_flow_cache_hits = 0;
+    m_flow_cache_misses = 0;
 }
 
-int32_t ArbiterEcmp::TopologyPtopDecide(int32_t source_node_id, int32_t target_node_id, const std::set<int64_t>& neighbor_node_ids, Ptr<const Packet> pkt, Ipv4Header const &ipHeader, bool is_request_for_source_ip_so_no_next_header) {
-    uint32_t hash = ComputeFiveTupleHash(ipHeader, pkt, m_node_id, is_request_for_source_ip_so_no_next_header);
-    size_t s = m_candidate_list.at(target_node_id).size();
+ArbiterEcmp::ArbiterEcmp(
+        Ptr<Node> this_node,
+        NodeContainer nodes,
+        Ptr<TopologyPtop> topology,
+        Ptr<ArbiterEcmpDistanceLabels> distance_labels
+) : ArbiterPtop(this_node, nodes, topology)
+{
+    m_distance_labels = distance_labels;
+    m_flow_tag_enabled = false;
+    m_flow_cache_hits = 0;
+    m_flow_cache_misses = 0;
+}
+
+uint32_t ArbiterEcmp::GetNumCandidates(int32_t target_node_id) {
+    if (m_forwarding_table) {
+        return m_forwarding_table->GetNumCandidates(m_node_id, target_node_id);
+    } else {
+        return m_distance_labels->GetNumCandidates(m_node_id, target_node_id);
+    }
+}
+
+uint32_t ArbiterEcmp::GetCandidate(int32_t target_node_id, uint32_t idx) {
+    if (m_forwarding_table) {
+        return m_forwarding_table->GetCandidate(m_node_id, target_node_id, idx);
+    } else {
+        return m_distance_labels->GetCandidate(m_node_id, target_node_id, idx);
+    }
+}
+
+int32_t ArbiterEcmp::DecideFromHash(int32_t source_node_id, int32_t target_node_id, uint32_t hash) {
+    uint32_t s = GetNumCandidates(target_node_id);
     if (s == 0) {
         throw std::invalid_argument(format_string(
                 "There are no candidate ECMP next hops available at current node %d for a packet from source %d to destination %d",
                 m_node_id, source_node_id, target_node_id
         ));
     }
-    return m_candidate_list.at(target_node_id).at(hash % s);
+    return GetCandidate(target_node_id, hash % s);
+}
+
+int32_t ArbiterEcmp::TopologyPtopDecide(int32_t source_node_id, int32_t target_node_id, const std::set<int64_t>& neighbor_node_ids, Ptr<const Packet> pkt, Ipv4Header const &ipHeader, bool is_request_for_source_ip_so_no_next_header) {
+
+    // Without flow cache, the hash is calculated for every packet
+    if (m_flow_cache.empty()) {
+        uint32_t hash = ComputeFiveTupleHash(ipHeader, pkt, m_node_id, is_request_for_source_ip_so_no_next_header);
+        return DecideFromHash(source_node_id, target_node_id, hash);
+    }
+
+    // 5-tuple of the packet
+    uint32_t source_ip = ipHeader.GetSource().Get();
+    uint32_t destination_ip = ipHeader.GetDestination().Get();
+    uint8_t protocol = ipHeader.GetProtocol();
+    uint16_t source_port;
+    uint16_t destination_port;
+    ReadPorts(ipHeader, pkt, is_request_for_source_ip_so_no_next_header, source_port, destination_port);
+
+    // Slot in the flow cache
+    uint32_t slot_hash = source_ip * 0x9E3779B1u;
+    slot_hash ^= destination_ip * 0x85EBCA77u;
+    slot_hash ^= ((((uint32_t) source_port) << 16) | destination_port) * 0xC2B2AE3Du;
+    slot_hash ^= protocol;
+    slot_hash ^= slot_hash >> 15;
+    FlowCacheEntry& entry = m_flow_cache[slot_hash % m_flow_cache.size()];
+
+    // Hit: the forwarding state is immutable, so the earlier decision for this 5-tuple still holds
+    if (entry.valid
+        && entry.source_ip == source_ip
+        && entry.destination_ip == destination_ip
+        && entry.source_port == source_port
+        && entry.destination_port == destination_port
+        && entry.protocol == protocol) {
+        m_flow_cache_hits++;
+        return entry.next_hop_node_id;
+    }
+
+    // Miss: decide and replace whichever flow was in the slot
+    m_flow_cache_misses++;
+    int32_t next_hop_node_id = DecideFromHash(
+            source_node_id,
+            target_node_id,
+            HashFiveTuple(source_ip, destination_ip, protocol, source_port, destination_port, m_node_id)
+    );
+    entry.source_ip = source_ip;
+    entry.destination_ip = destination_ip;
+    entry.source_port = source_port;
+    entry.destination_port = destination_port;
+    entry.protocol = protocol;
+    entry.valid = true;
+    entry.next_hop_node_id = next_hop_node_id;
+    return next_hop_node_id;
+
 }
 
 ArbiterEcmp::~ArbiterEcmp() {
@@ -80,12 +164,36 @@ ArbiterEcmp::~ArbiterEcmp() {
 uint32_t
 ArbiterEcmp::ComputeFiveTupleHash(const Ipv4Header &header, Ptr<const Packet> p, int32_t node_id, bool no_other_headers)
 {
-    NS_ABORT_MSG_IF(node_id < 0, "Node identifier cannot be negative as it is converted to an unsigned integer.");
-    uint32_t unsigned_node_id = (uint32_t) node_id;
+    uint16_t source_port;
+    uint16_t destination_port;
+    ReadPorts(header, p, no_other_headers, source_port, destination_port);
+    return HashFiveTuple(
+            header.GetSource().Get(),
+            header.GetDestination().Get(),
+            header.GetProtocol(),
+            source_port,
+            destination_port,
+            node_id
+    );
+}
 
-    // IP header fields
-    Ipv4Address source_ip = header.GetSource ();
-    Ipv4Address destination_ip = header.GetDestination ();
+/**
+ * Retrieve the source and destination port from the TCP or UDP header.
+ *
+ * Both the TCP and UDP header start with the 16-bit source port followed by the
+ * 16-bit destination port, so only these first four bytes are copied out of the packet
+ * instead of deserializing the entire header.
+ *
+ * @param header               IPv4 header
+ * @param p                    Packet (without the IPv4 header)
+ * @param no_other_headers     True iff there are no other headers outside of the IPv4 one,
+ *                             irrespective of what the IP protocol field claims
+ * @param source_port          Source port, or zero if not TCP/UDP (output)
+ * @param destination_port     Destination port, or zero if not TCP/UDP (output)
+ */
+void
+ArbiterEcmp::ReadPorts(const Ipv4Header &header, Ptr<const Packet> p, bool no_other_headers, uint16_t& source_port, uint16_t& destination_port)
+{
     uint8_t protocol = header.GetProtocol ();
     uint16_t frag_offset = header.GetFragmentOffset ();
 
@@ -93,36 +201,48 @@ ArbiterEcmp::ComputeFiveTupleHash(const Ipv4Header &header, Ptr<const Packet> p,
     // (a) We have NOT been notified that even though the protocol field might be non-zero,
     //     there is actually not another header to peek at
     // (b) The packet is not fragmented (fragment offset is zero)
-    uint16_t source_port = 0;
-    uint16_t destination_port = 0;
-    if (!no_other_headers) {
-        if (protocol == 6 && frag_offset == 0) { // TCP
-            TcpHeader tcpHdr;
-            p->PeekHeader(tcpHdr);
-            source_port = tcpHdr.GetSourcePort();
-            destination_port = tcpHdr.GetDestinationPort();
-            NS_ABORT_MSG_IF(
-                    source_port == 0 || destination_port == 0,
-                    "Invalid port numbers; this indicates the TCP header is likely not present whereas it is expected to be"
-            );
-
-        } else if (protocol == 17 && frag_offset == 0) {  // UDP
-            UdpHeader udpHdr;
-            p->PeekHeader(udpHdr);
-            source_port = udpHdr.GetSourcePort();
-            destination_port = udpHdr.GetDestinationPort();
-            NS_ABORT_MSG_IF(
-                    source_port == 0 || destination_port == 0,
-                    "Invalid port numbers; this indicates the UDP header is likely not present whereas it is expected to be"
-            );
+    source_port = 0;
+    destination_port = 0;
+    if (!no_other_headers && (protocol == 6 || protocol == 17) && frag_offset == 0) {
+
+        // The sender might have attached them already in a tag
+        ArbiterEcmpFlowTag flow_tag;
+        if (m_flow_tag_enabled && p->PeekPacketTag(flow_tag)) {
+            source_port = flow_tag.GetSourcePort();
+            destination_port = flow_tag.GetDestinationPort();
+            return;
         }
+
+        uint8_t ports[4] = {0, 0, 0, 0};
+        p->CopyData(ports, 4);
+        source_port = (((uint16_t) ports[0]) << 8) | ports[1];
+        destination_port = (((uint16_t) ports[2]) << 8) | ports[3];
+        NS_ABORT_MSG_IF(
+                source_port == 0 || destination_port == 0,
+                (protocol == 6 ?
+                "Invalid port numbers; this indicates the TCP header is likely not present whereas it is expected to be" :
+                "Invalid port numbers; this indicates the UDP header is likely not present whereas it is expected to be")
+        );
     }
+}
+
+uint32_t
+ArbiterEcmp::HashFiveTuple(uint32_t source_ip, uint32_t destination_ip, uint8_t protocol, uint16_t source_port, uint16_t destination_port, int32_t node_id)
+{
+    NS_ABORT_MSG_IF(node_id < 0, "Node identifier cannot be negative as it is converted to an unsigned integer.");
+    uint32_t unsigned_node_id = (uint32_t) node_id;
 
     // Serialize the 5-tuple, per-node perturbation (the node identifier) and the constant ECMP perturbation
     uint32_t ecmp_perturbation = 1333527522;
     uint8_t buf[21];
-    source_ip.Serialize (buf);
-    destination_ip.Serialize (buf + 4);
+    buf[0] = (source_ip >> 24) & 0xff; // IP addresses in network byte order
+    buf[1] = (source_ip >> 16) & 0xff;
+    buf[2] = (source_ip >> 8) & 0xff;
+    buf[3] = source_ip & 0xff;
+    buf[4] = (destination_ip >> 24) & 0xff;
+    buf[5] = (destination_ip >> 16) & 0xff;
+    buf[6] = (destination_ip >> 8) & 0xff;
+    buf[7] = destination_ip & 0xff;
     buf[8] = protocol;
     buf[9] = (source_port >> 8) & 0xff;
     buf[10] = source_port & 0xff;
@@ -143,18 +263,86 @@ ArbiterEcmp::ComputeFiveTupleHash(const Ipv4Header &header, Ptr<const Packet> p,
 
 }
 
+/**
+ * Enable that the ports are attached in a flow tag to each TCP packet on its sender,
+ * such that every subsequent hop reads them from the tag instead of from the
+ * TCP header. UDP packets are not tagged, as their sender only routes them before
+ * the UDP header is added. The resulting hashes, and as such decisions, are the same.
+ */
+void ArbiterEcmp::EnableFlowTag() {
+    m_flow_tag_enabled = true;
+}
+
+bool ArbiterEcmp::IsFlowTagEnabled() {
+    return m_flow_tag_enabled;
+}
+
+void ArbiterEcmp::TagOutgoingPacket(Ptr<Packet> pkt, Ipv4Header const &ipHeader) {
+
+    // Only if enabled, and it is not a request for the source IP (that has no other header,
+    // which is always the case for UDP)
+    if (!m_flow_tag_enabled || ipHeader.GetSource().Get() == SOCKET_REQUEST_FOR_SOURCE_IP) {
+        return;
+    }
+
+    // Ports as they are read from the TCP header
+    ArbiterEcmpFlowTag flow_tag;
+    pkt->RemovePacketTag(flow_tag);
+    uint16_t source_port;
+    uint16_t destination_port;
+    ReadPorts(ipHeader, pkt, false, source_port, destination_port);
+    if (source_port != 0) {
+        flow_tag.SetSourcePort(source_port);
+        flow_tag.SetDestinationPort(destination_port);
+        pkt->AddPacketTag(flow_tag);
+    }
+
+}
+
+/**
+ * Enable the per-flow next-hop decision cache.
+ *
+ * Each slot holds the decision of the most recent flow (5-tuple) mapped to it,
+ * which is evicted when another flow maps to the same slot.
+ *
+ * @param num_entries   Number of slots (at least one)
+ */
+void ArbiterEcmp::EnableFlowCache(int64_t num_entries) {
+    if (num_entries < 1) {
+        throw std::invalid_argument(format_string("Flow cache must have at least one entry (given: %" PRId64 ")", num_entries));
+    }
+    FlowCacheEntry empty_entry = {0, 0, 0, 0, 0, false, -1};
+    m_flow_cache = std::vector<FlowCacheEntry>(num_entries, empty_entry);
+    m_flow_cache_hits = 0;
+    m_flow_cache_misses = 0;
+}
+
+int64_t ArbiterEcmp::GetFlowCacheSize() {
+    return (int64_t) m_flow_cache.size();
+}
+
+int64_t ArbiterEcmp::GetFlowCacheHits() {
+    return m_flow_cache_hits;
+}
+
+int64_t ArbiterEcmp::GetFlowCacheMisses() {
+    return m_flow_cache_misses;
+}
+
 std::string ArbiterEcmp::StringReprOfForwardingState() {
     std::ostringstream res;
     res << "ECMP state of node " << m_node_id << std::endl;
     for (int i = 0; i < m_topology->GetNumNodes(); i++) {
+        if (m_distance_labels && !m_distance_labels->IsDestination(i)) {
+            continue; // Distance labels only have state towards destinations
+        }
         res << "  -> " << i << ": {";
-        bool first = true;
-        for (int j : m_candidate_list.at(i)) {
-            if (!first) {
+        uint32_t s = GetNumCandidates(i);
+        for (uint32_t j = 0; j < s; j++) {
+            if (j != 0) {
                 res << ",";
             }
-            res << j;
-            first = false;
+            res << GetCandidate(i, j);
         }
         res << "}" << std::endl;
     }
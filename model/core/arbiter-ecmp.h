@@ -22,6 +22,9 @@
 
 #include "ns3/arbiter-ptop.h"
 #include "ns3/hash.h"
+#include "ns3/arbiter-ecmp-forwarding-table.h"
+#include "ns3/arbiter-ecmp-distance-labels.h"
+#include "ns3/arbiter-ecmp-flow-tag.h"
 
 namespace ns3 {
 
@@ -35,7 +38,15 @@ public:
             Ptr<Node> this_node,
             NodeContainer nodes,
             Ptr<TopologyPtop> topology,
-            std::vector<std::vector<uint32_t>> candidate_list
+            Ptr<ArbiterEcmpForwardingTable> forwarding_table
+    );
+
+    // Constructor for destination-only ECMP state (candidates are derived from distances)
+    ArbiterEcmp(
+            Ptr<Node> this_node,
+            NodeContainer nodes,
+            Ptr<TopologyPtop> topology,
+            Ptr<ArbiterEcmpDistanceLabels> distance_labels
     );
     virtual ~ArbiterEcmp();
 
@@ -55,8 +66,42 @@ public:
     // Made public for testing
     uint32_t ComputeFiveTupleHash(const Ipv4Header &header, Ptr<const Packet> p, int32_t node_id, bool no_other_headers);
 
+    // Flow tag with the ports attached on the sender (disabled until enabled)
+    void EnableFlowTag();
+    bool IsFlowTagEnabled();
+    void TagOutgoingPacket(ns3::Ptr<ns3::Packet> pkt, ns3::Ipv4Header const &ipHeader);
+
+    // Per-flow next-hop decision cache (disabled until enabled)
+    void EnableFlowCache(int64_t num_entries);
+    int64_t GetFlowCacheSize();
+    int64_t GetFlowCacheHits();
+    int64_t GetFlowCacheMisses();
+
 private:
-    std::vector<std::vector<uint32_t>> m_candidate_list;
+    uint32_t GetNumCandidates(int32_t target_node_id);
+    uint32_t GetCandidate(int32_t target_node_id, uint32_t idx);
+    int32_t DecideFromHash(int32_t source_node_id, int32_t target_node_id, uint32_t hash);
+    void ReadPorts(const Ipv4Header &header, Ptr<const Packet> p, bool no_other_headers, uint16_t& source_port, uint16_t& destination_port);
+    uint32_t HashFiveTuple(uint32_t source_ip, uint32_t destination_ip, uint8_t protocol, uint16_t source_port, uint16_t destination_port, int32_t node_id);
+
+    // Exactly one of these two is set, and it is shared among all ECMP arbiters
+    Ptr<ArbiterEcmpForwardingTable> m_forwarding_table;
+    Ptr<ArbiterEcmpDistanceLabels> m_distance_labels;
+
+    // Direct-mapped flow cache: the 5-tuple uniquely determines the next hop at this node
+    struct FlowCacheEntry {
+        uint32_t source_ip;
+        uint32_t destination_ip;
+        uint16_t source_port;
+        uint16_t destination_port;
+        uint8_t protocol;
+        bool valid;
+        int32_t next_hop_node_id;
+    };
+    bool m_flow_tag_enabled;
+    std::vector<FlowCacheEntry> m_flow_cache;
+    int64_t m_flow_cache_hits;
+    int64_t m_flow_cache_misses;
 
 };
 
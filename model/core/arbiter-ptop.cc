@@ -35,7 +35,7 @@ ArbiterPtop::ArbiterPtop(
         Ptr<Node> this_node,
         NodeContainer nodes,
         Ptr<TopologyPtop> topology
-) : Arbiter(this_node, nodes) {
+) : Arbiter(this_node, nodes, topology->GetIpToNodeIdIndex()) {
 
     // Topology
     m_topology = topology;
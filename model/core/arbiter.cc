@@ -68,16 +68,19 @@ TypeId Arbiter::GetTypeId (void)
     return tid;
 }
 
-Arbiter::Arbiter(Ptr<Node> this_node, NodeContainer nodes) {
+Arbiter::Arbiter(
+        Ptr<Node> this_node,
+        NodeContainer nodes
+) : Arbiter(this_node, nodes, CreateObject<IpToNodeIdIndex>(nodes)) {
+    // Left empty intentionally
+}
+
+Arbiter::Arbiter(Ptr<Node> this_node, NodeContainer nodes, Ptr<IpToNodeIdIndex> ip_to_node_id_index) {
     m_node_id = this_node->GetId();
     m_nodes = nodes;
 
-    // Store IP address to node id (each interface has an IP address, so multiple IPs per node)
-    for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
-        for (uint32_t j = 1; j < m_nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces(); j++) {
-            m_ip_to_node_id.insert({m_nodes.Get(i)->GetObject<Ipv4>()->GetAddress(j, 0).GetLocal().Get(), i});
-        }
-    }
+    // Shared IP address to node id index (each interface has an IP address, so multiple IPs per node)
+    m_ip_to_node_id_index = ip_to_node_id_index;
 
 }
 
@@ -86,14 +89,11 @@ Arbiter::~Arbiter() {
 }
 
 uint32_t Arbiter::ResolveNodeIdFromIp(uint32_t ip) {
-    m_ip_to_node_id_it = m_ip_to_node_id.find(ip);
-    if (m_ip_to_node_id_it != m_ip_to_node_id.end()) {
-        return m_ip_to_node_id_it->second;
-    } else {
-        std::ostringstream res;
-        res << "IP address " << Ipv4Address(ip)  << " (" << ip << ") is not mapped to a node id";
-        throw std::invalid_argument(res.str());
-    }
+    return m_ip_to_node_id_index->ResolveNodeIdFromIp(ip);
+}
+
+void Arbiter::TagOutgoingPacket(Ptr<Packet> pkt, Ipv4Header const &ipHeader) {
+    // Left empty intentionally
 }
 
 ArbiterResult Arbiter::BaseDecide(Ptr<const Packet> pkt, Ipv4Header const &ipHeader) {
@@ -102,9 +102,8 @@ ArbiterResult Arbiter::BaseDecide(Ptr<const Packet> pkt, Ipv4Header const &ipHea
     uint32_t source_ip = ipHeader.GetSource().Get();
     uint32_t source_node_id;
 
-    // Ipv4Address default constructor has IP 0x66666666 = 102.102.102.102 = 1717986918,
-    // which is set by TcpSocketBase::SetupEndpoint to discover its actually source IP.
-    bool is_socket_request_for_source_ip = source_ip == 1717986918;
+    // Set by TcpSocketBase::SetupEndpoint (and the UDP socket) to discover its actual source IP
+    bool is_socket_request_for_source_ip = source_ip == SOCKET_REQUEST_FOR_SOURCE_IP;
 
     // If it is a request for source IP, the source node id is just the current node.
     if (is_socket_request_for_source_ip) {
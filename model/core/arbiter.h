@@ -24,6 +24,7 @@
 #include "ns3/topology.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/ip-to-node-id-index.h"
 
 namespace ns3 {
 
@@ -48,6 +49,7 @@ class Arbiter : public Object
 public:
     static TypeId GetTypeId (void);
     Arbiter(Ptr<Node> this_node, NodeContainer nodes);
+    Arbiter(Ptr<Node> this_node, NodeContainer nodes, Ptr<IpToNodeIdIndex> ip_to_node_id_index);
     virtual ~Arbiter();
 
     /**
@@ -106,6 +108,22 @@ public:
             bool is_socket_request_for_source_ip
     ) = 0;
 
+    /**
+     * Called once for each packet on the sender before its routing decision (at RouteOutput).
+     * It enables an arbiter to attach a packet tag with information which remains the
+     * same at every hop. By default, nothing is done.
+     *
+     * Only TCP packets pass through here with their transport header: a UDP source only
+     * asks for source IP (before its UDP header is added), and does not do another call.
+     *
+     * @param pkt                               Packet (incl. transport header if TCP, without IP header)
+     * @param ipHeader                          IP header of the packet
+     */
+    virtual void TagOutgoingPacket(
+            ns3::Ptr<ns3::Packet> pkt,
+            ns3::Ipv4Header const &ipHeader
+    );
+
     /**
      * Convert the forwarding state (i.e., routing table) to a string representation.
      *
@@ -113,13 +131,16 @@ public:
      */
     virtual std::string StringReprOfForwardingState() = 0;
 
+    // Ipv4Address default constructor has IP 0x66666666 = 102.102.102.102 = 1717986918,
+    // which is set by a socket as source IP when it requests its actual source IP
+    static const uint32_t SOCKET_REQUEST_FOR_SOURCE_IP = 1717986918;
+
 protected:
     int32_t m_node_id;
     ns3::NodeContainer m_nodes;
 
 private:
-    std::map<uint32_t, uint32_t> m_ip_to_node_id;
-    std::map<uint32_t, uint32_t>::iterator m_ip_to_node_id_it;
+    Ptr<IpToNodeIdIndex> m_ip_to_node_id_index;
 
 };
 
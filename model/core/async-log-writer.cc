@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/async-log-writer.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (AsyncLogWriter);
+TypeId AsyncLogWriter::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::AsyncLogWriter")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+AsyncLogWriter::AsyncLogWriter() : AsyncLogWriter(1048576) {
+    // Left empty intentionally
+}
+
+AsyncLogWriter::AsyncLogWriter(int64_t buffer_size_byte) : AsyncLogWriter(buffer_size_byte, 256) {
+    // Left empty intentionally
+}
+
+AsyncLogWriter::AsyncLogWriter(int64_t buffer_size_byte, int64_t max_open_files) {
+    if (buffer_size_byte < 1) {
+        throw std::invalid_argument(format_string("Buffer size must be at least 1 byte (given: %" PRId64 ")", buffer_size_byte));
+    }
+    if (max_open_files < 1) {
+        throw std::invalid_argument(format_string("Maximum number of open files must be at least 1 (given: %" PRId64 ")", max_open_files));
+    }
+    m_buffer_size_byte = buffer_size_byte;
+    m_max_open_files = max_open_files;
+    m_closed = false;
+    m_writing = false;
+    m_stop = false;
+    m_write_failed_file_handle = -1;
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    try {
+        Close();
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl; // Destructors are not allowed to throw
+    }
+}
+
+/**
+ * Add a file to write to. It is created (or truncated) right away, but only kept open
+ * while data is being written to it.
+ *
+ * @param filename      File name
+ * @param append        True iff to append to the file if it already exists, else it is truncated
+ *
+ * @return File handle to use with Write()
+ */
+int64_t AsyncLogWriter::Open(const std::string& filename, bool append) {
+    if (m_closed) {
+        throw std::runtime_error("Cannot open a file in an asynchronous log writer which is closed: " + filename);
+    }
+    FILE* file = fopen(filename.c_str(), append ? "a" : "w");
+    if (file == nullptr) {
+        throw std::runtime_error("Could not open log file: " + filename);
+    }
+    fclose(file);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_filenames.push_back(filename);
+    m_files.push_back(nullptr);
+    m_open_order_position.push_back(m_open_order.end());
+    lock.unlock();
+    m_buffers.push_back(std::string());
+    m_file_closed.push_back(false);
+    return (int64_t) m_buffers.size() - 1;
+}
+
+/**
+ * Append data to a file. It is only guaranteed to be on disk after CloseFile(), Flush() or Close().
+ *
+ * @param file_handle   File handle as returned by Open()
+ * @param data          Data
+ * @param length        Length of the data (byte)
+ */
+void AsyncLogWriter::Write(int64_t file_handle, const char* data, size_t length) {
+    if (m_file_closed.at(file_handle)) {
+        throw std::runtime_error("Cannot write to a log file which is closed: " + m_filenames.at(file_handle));
+    }
+
+    // The buffer is not reserved upfront, but grows as data is written to it, such that
+    // files which are written to rarely (or not at all) do not each hold a full buffer
+    std::string& buffer = m_buffers.at(file_handle);
+    buffer.append(data, length);
+    if ((int64_t) buffer.size() >= m_buffer_size_byte) {
+        HandOver(file_handle, false);
+    }
+}
+
+/**
+ * Close a single file once nothing more is written to it, releasing its buffer and descriptor.
+ * Its data is written in the background; it is only guaranteed to be on disk after Flush() or Close().
+ *
+ * @param file_handle   File handle as returned by Open()
+ */
+void AsyncLogWriter::CloseFile(int64_t file_handle) {
+    if (m_closed || m_file_closed.at(file_handle)) {
+        return;
+    }
+    m_file_closed.at(file_handle) = true;
+    HandOver(file_handle, true);
+}
+
+void AsyncLogWriter::HandOver(int64_t file_handle, bool close_file) {
+    PendingChunk chunk;
+    chunk.file_handle = file_handle;
+    chunk.data.swap(m_buffers.at(file_handle));
+    chunk.close_file = close_file;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) {
+        m_thread = std::thread(&AsyncLogWriter::WriteLoop, this);
+    }
+    m_pending.push_back(std::move(chunk));
+    lock.unlock();
+    m_work_available.notify_one();
+}
+
+/**
+ * Get the open file to write to, opening it to append if it is not. If already the maximum
+ * number of files is open, the least recently written one is closed first.
+ * Must be called while holding the mutex.
+ *
+ * @param file_handle   File handle
+ *
+ * @return File (nullptr if it could not be opened)
+ */
+FILE* AsyncLogWriter::AcquireFile(int64_t file_handle) {
+    FILE* file = m_files.at(file_handle);
+    if (file != nullptr) {
+        m_open_order.splice(m_open_order.begin(), m_open_order, m_open_order_position.at(file_handle));
+        return file;
+    }
+    if ((int64_t) m_open_order.size() >= m_max_open_files) {
+        int64_t least_recent = m_open_order.back();
+        if (!ReleaseFile(least_recent) && m_write_failed_file_handle == -1) {
+            m_write_failed_file_handle = least_recent;
+        }
+    }
+    file = fopen(m_filenames.at(file_handle).c_str(), "a");
+    if (file != nullptr) {
+        m_files.at(file_handle) = file;
+        m_open_order.push_front(file_handle);
+        m_open_order_position.at(file_handle) = m_open_order.begin();
+    }
+    return file;
+}
+
+/**
+ * Close a file if it is open. Must be called while holding the mutex.
+ *
+ * @param file_handle   File handle
+ *
+ * @return True iff it was not open or it was closed successfully
+ */
+bool AsyncLogWriter::ReleaseFile(int64_t file_handle) {
+    FILE* file = m_files.at(file_handle);
+    if (file == nullptr) {
+        return true;
+    }
+    m_files.at(file_handle) = nullptr;
+    m_open_order.erase(m_open_order_position.at(file_handle));
+    m_open_order_position.at(file_handle) = m_open_order.end();
+    return fclose(file) == 0;
+}
+
+void AsyncLogWriter::WriteLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work_available.wait(lock, [this]{ return !m_pending.empty() || m_stop; });
+        if (m_pending.empty()) {
+            return; // Stop and nothing left to write
+        }
+        PendingChunk chunk = std::move(m_pending.front());
+        m_pending.pop_front();
+        bool success = true;
+        if (!chunk.data.empty()) {
+            FILE* file = AcquireFile(chunk.file_handle);
+            m_writing = true;
+
+            // Write without holding the lock, such that the simulation thread can hand over more
+            // (only this thread opens and closes files while writing, as such the file stays open)
+            lock.unlock();
+            success = file != nullptr && fwrite(chunk.data.data(), 1, chunk.data.size(), file) == chunk.data.size();
+            lock.lock();
+
+            m_writing = false;
+        }
+        if (chunk.close_file) {
+            success = ReleaseFile(chunk.file_handle) && success;
+        }
+        if (!success && m_write_failed_file_handle == -1) {
+            m_write_failed_file_handle = chunk.file_handle;
+        }
+        if (m_pending.empty()) {
+            m_work_done.notify_all();
+        }
+    }
+}
+
+/**
+ * Wait until all data written so far is written to disk.
+ */
+void AsyncLogWriter::Flush() {
+    if (m_closed) {
+        return;
+    }
+
+    // Hand over what is remaining in the buffers
+    for (size_t i = 0; i < m_buffers.size(); i++) {
+        if (!m_buffers.at(i).empty()) {
+            HandOver(i, false);
+        }
+    }
+
+    // Wait for the background thread to be done
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_work_done.wait(lock, [this]{ return m_pending.empty() && !m_writing; });
+    for (int64_t i : m_open_order) {
+        if (fflush(m_files.at(i)) != 0 && m_write_failed_file_handle == -1) {
+            m_write_failed_file_handle = i;
+        }
+    }
+    if (m_write_failed_file_handle != -1) {
+        throw std::runtime_error("Failed to write to log file: " + m_filenames.at(m_write_failed_file_handle));
+    }
+}
+
+/**
+ * Flush, stop the background thread and close all files.
+ */
+void AsyncLogWriter::Close() {
+    if (m_closed) {
+        return;
+    }
+
+    // Flush, but the background thread must be stopped and files closed regardless of whether it succeeds
+    bool flush_failed = false;
+    std::string flush_failed_what;
+    try {
+        Flush();
+    } catch (std::runtime_error& e) {
+        flush_failed = true;
+        flush_failed_what = e.what();
+    }
+    m_closed = true;
+
+    // Stop the background thread
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    lock.unlock();
+    m_work_available.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // Close all files which are still open
+    while (!m_open_order.empty()) {
+        ReleaseFile(m_open_order.front());
+    }
+
+    if (flush_failed) {
+        throw std::runtime_error(flush_failed_what);
+    }
+}
+
+int64_t AsyncLogWriter::GetBufferSizeByte() {
+    return m_buffer_size_byte;
+}
+
+int64_t AsyncLogWriter::GetMaxOpenFiles() {
+    return m_max_open_files;
+}
+
+int64_t AsyncLogWriter::GetNumFiles() {
+    return (int64_t) m_buffers.size();
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef ASYNC_LOG_WRITER_H
+#define ASYNC_LOG_WRITER_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Asynchronous buffered writer for log files which receive many small appends
+ * (e.g., one line per packet).
+ *
+ * Lines are appended to an in-memory buffer of their file, which is handed over to a
+ * background thread once it exceeds the buffer size. The background thread does the
+ * actual writing, such that the simulation thread never blocks on file I/O. A file is
+ * only opened once data is written to it, and at most a maximum number of files are
+ * open at a time (if more are written to, the least recently written is closed and
+ * reopened later to append). CloseFile() releases a single file once nothing more is
+ * written to it. Flush() waits until everything written so far is on disk; Close()
+ * (also called upon destruction) additionally closes all files.
+ */
+class AsyncLogWriter : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    AsyncLogWriter();
+    AsyncLogWriter(int64_t buffer_size_byte);
+    AsyncLogWriter(int64_t buffer_size_byte, int64_t max_open_files);
+    virtual ~AsyncLogWriter();
+
+    int64_t Open(const std::string& filename, bool append);
+    void Write(int64_t file_handle, const char* data, size_t length);
+    void CloseFile(int64_t file_handle);
+    void Flush();
+    void Close();
+
+    int64_t GetBufferSizeByte();
+    int64_t GetMaxOpenFiles();
+    int64_t GetNumFiles();
+
+private:
+    struct PendingChunk {
+        int64_t file_handle;
+        std::string data;
+        bool close_file; // Close the file after writing the data
+    };
+
+    void HandOver(int64_t file_handle, bool close_file);
+    void WriteLoop();
+    FILE* AcquireFile(int64_t file_handle);
+    bool ReleaseFile(int64_t file_handle);
+
+    // Only accessed by the simulation thread
+    int64_t m_buffer_size_byte;
+    int64_t m_max_open_files;
+    std::vector<std::string> m_buffers;
+    std::vector<bool> m_file_closed;
+    bool m_closed;
+
+    // Shared with the background thread (guarded by the mutex)
+    std::vector<std::string> m_filenames;
+    std::vector<FILE*> m_files;  // nullptr if not open
+    std::list<int64_t> m_open_order;  // Open files, most recently written first
+    std::vector<std::list<int64_t>::iterator> m_open_order_position;
+    std::deque<PendingChunk> m_pending;
+    bool m_writing;
+    bool m_stop;
+    int64_t m_write_failed_file_handle;  // -1 if no write failed
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_work_done;
+    std::thread m_thread;
+};
+
+}
+
+#endif //ASYNC_LOG_WRITER_H
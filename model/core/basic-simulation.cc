@@ -63,6 +63,34 @@ void BasicSimulation::RegisterTimestamp(std::string label) {
     m_timestamps.push_back(std::make_pair(label, NowNsSinceEpoch()));
 }
 
+/**
+ * Register a statistic of this system which helps diagnose the partition of a distributed run.
+ * They are written to the distributed statistics files in the order registered.
+ *
+ * @param label     Statistic label
+ * @param value     Statistic value
+ */
+void BasicSimulation::RegisterDistributedStatistic(std::string label, int64_t value) {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such there are no distributed statistics");
+    }
+    m_distributed_statistics.push_back(std::make_pair(label, value));
+}
+
+/**
+ * Register a statistic of this system which is only known once the simulation has run
+ * (e.g., a packet counter). The getter is called right after the simulation has finished.
+ *
+ * @param label     Statistic label
+ * @param getter    Callback which returns the statistic value
+ */
+void BasicSimulation::RegisterDistributedStatistic(std::string label, Callback<int64_t> getter) {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such there are no distributed statistics");
+    }
+    m_distributed_statistic_getters.push_back(std::make_pair(label, getter));
+}
+
 void BasicSimulation::ConfigureRunDirectory() {
     std::cout << "CONFIGURE RUN DIRECTORY" << std::endl;
 
@@ -137,30 +165,20 @@ void BasicSimulation::ConfigureSimulation() {
             throw std::runtime_error(format_string("Systems count in configuration (%u) does not match up with MPI systems count (%u)", config_systems_count, m_systems_count));
         }
 
-        // Check node-to-system-id assignment
-        m_distributed_node_system_id_assignment = parse_list_positive_int64(GetConfigParamOrFail("distributed_node_system_id_assignment"));
-        std::vector<int> system_id_counter(m_systems_count, 0);
-        for (uint32_t i = 0; i < m_distributed_node_system_id_assignment.size(); i++) {
-            if (m_distributed_node_system_id_assignment.at(i) < 0 || m_distributed_node_system_id_assignment.at(i) >= m_systems_count) {
-                throw std::invalid_argument(format_string(
-                        "Node %d is assigned to an invalid system id %" PRId64 " (k=%" PRId64 ")",
-                        i,
-                        m_distributed_node_system_id_assignment.at(i),
-                        m_systems_count
-                ));
-            }
-            system_id_counter.at(m_distributed_node_system_id_assignment.at(i))++;
-        }
-
-        // All good, showing summary
-        printf("  > System information (%u systems):\n", GetSystemsCount());
-        for (uint32_t i = 0; i < m_systems_count; i++) {
-            printf("    >> System %d has %d node(s)\n", i, system_id_counter.at(i));
+        // Node-to-system-id assignment (if automatic, it is set by the topology once it is known)
+        std::string assignment_str = GetConfigParamOrFail("distributed_node_system_id_assignment");
+        if (trim(assignment_str) == "auto") {
+            m_distributed_node_system_id_assignment_auto = true;
+            printf("  > Node-to-system-id assignment... automatic (set by topology)\n");
+        } else {
+            m_distributed_node_system_id_assignment_auto = false;
+            SetDistributedNodeSystemIdAssignment(parse_list_positive_int64(assignment_str));
         }
 
     } else {
         printf("  > Distributed is not enabled\n");
         m_distributed_node_system_id_assignment.clear();
+        m_distributed_node_system_id_assignment_auto = false;
         m_system_id = 0;
         m_systems_count = 1;
     }
@@ -186,6 +204,10 @@ void BasicSimulation::PrepareBasicSimulationLogFiles() {
         m_finished_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_finished.txt";
         m_timing_results_txt_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_timing_results.txt";
         m_timing_results_csv_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_timing_results.csv";
+        m_distributed_statistics_txt_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_distributed_statistics.txt";
+        m_distributed_statistics_csv_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_distributed_statistics.csv";
+        remove_file_if_exists(m_distributed_statistics_txt_filename);
+        remove_file_if_exists(m_distributed_statistics_csv_filename);
     } else {
         m_finished_filename = m_logs_dir + "/finished.txt";
         m_timing_results_txt_filename = m_logs_dir + "/timing_results.txt";
@@ -279,12 +301,22 @@ void BasicSimulation::Run() {
     printf("Finished simulation.\n");
 
     // Print final duration
+    int64_t run_wallclock_ns = NowNsSinceEpoch() - m_sim_start_time_ns_since_epoch;
     printf(
             "Simulation of %.1f seconds took in wallclock time %.1f seconds.\n\n",
             m_simulation_end_time_ns / 1e9,
-            (NowNsSinceEpoch() - m_sim_start_time_ns_since_epoch) / 1e9
+            run_wallclock_ns / 1e9
     );
 
+    // Statistics which are only known after the run
+    if (m_enable_distributed) {
+        m_distributed_statistics.push_back(std::make_pair("Run wallclock time (ns)", run_wallclock_ns));
+        m_distributed_statistics.push_back(std::make_pair("Events executed", (int64_t) Simulator::GetEventCount()));
+        for (std::pair<std::string, Callback<int64_t>>& getter : m_distributed_statistic_getters) {
+            m_distributed_statistics.push_back(std::make_pair(getter.first, getter.second()));
+        }
+    }
+
     RegisterTimestamp("Run simulation");
 }
 
@@ -351,9 +383,40 @@ void BasicSimulation::StoreTimingResults() {
     std::cout << std::endl;
 }
 
+void BasicSimulation::StoreDistributedStatistics() {
+    std::cout << "DISTRIBUTED STATISTICS" << std::endl;
+    std::cout << "------" << std::endl;
+
+    // Write to both files and out
+    std::ofstream file_txt(m_distributed_statistics_txt_filename);
+    std::ofstream file_csv(m_distributed_statistics_csv_filename);
+    for (std::pair <std::string, int64_t> &statistic : m_distributed_statistics) {
+
+        // Format text line
+        std::string line = format_string("%-40s %" PRId64, (statistic.first + ":").c_str(), statistic.second);
+
+        // Standard out (console)
+        std::cout << line << std::endl;
+
+        // distributed_statistics.txt
+        file_txt << line << std::endl;
+
+        // distributed_statistics.csv (line format: <statistic label>,<value>)
+        file_csv << statistic.first << "," << statistic.second << std::endl;
+
+    }
+    file_txt.close();
+    file_csv.close();
+
+    std::cout << std::endl;
+}
+
 void BasicSimulation::Finalize() {
     CleanUpSimulation();
     StoreTimingResults();
+    if (m_enable_distributed) {
+        StoreDistributedStatistics();
+    }
 
     // Information about the end
     std::cout << "BASIC SIMULATION END" << std::endl;
@@ -394,6 +457,47 @@ bool BasicSimulation::IsNodeAssignedToThisSystem(int64_t node_id) {
     return m_distributed_node_system_id_assignment.at(node_id) == m_system_id;
 }
 
+bool BasicSimulation::IsDistributedNodeSystemIdAssignmentAuto() {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such there is no node assignment");
+    }
+    return m_distributed_node_system_id_assignment_auto;
+}
+
+/**
+ * Set the node-to-system-id assignment. It is checked that each system id is valid,
+ * after which a summary of the number of nodes per system is shown.
+ *
+ * @param assignment    System id of each node (index is node id)
+ */
+void BasicSimulation::SetDistributedNodeSystemIdAssignment(const std::vector<int64_t>& assignment) {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such the node assignment cannot be set");
+    }
+
+    // Check node-to-system-id assignment
+    std::vector<int> system_id_counter(m_systems_count, 0);
+    for (uint32_t i = 0; i < assignment.size(); i++) {
+        if (assignment.at(i) < 0 || assignment.at(i) >= m_systems_count) {
+            throw std::invalid_argument(format_string(
+                    "Node %d is assigned to an invalid system id %" PRId64 " (k=%" PRId64 ")",
+                    i,
+                    assignment.at(i),
+                    m_systems_count
+            ));
+        }
+        system_id_counter.at(assignment.at(i))++;
+    }
+    m_distributed_node_system_id_assignment = assignment;
+
+    // All good, showing summary
+    printf("  > System information (%u systems):\n", GetSystemsCount());
+    for (uint32_t i = 0; i < m_systems_count; i++) {
+        printf("    >> System %d has %d node(s)\n", i, system_id_counter.at(i));
+    }
+
+}
+
 const std::vector<int64_t>& BasicSimulation::GetDistributedNodeSystemIdAssignment() {
     if (!m_enable_distributed) {
         throw std::runtime_error("Distributed mode is not enabled, as such the node assignment should not need to be retrieved");
@@ -45,11 +45,16 @@ public:
     // Timestamps to track performance
     void RegisterTimestamp(std::string label);
 
+    // Statistics to diagnose the partition of a distributed run
+    void RegisterDistributedStatistic(std::string label, int64_t value);
+    void RegisterDistributedStatistic(std::string label, Callback<int64_t> getter);
+
     // Getters
     bool IsDistributedEnabled();
     uint32_t GetSystemId();
     uint32_t GetSystemsCount();
     bool IsNodeAssignedToThisSystem(int64_t node_id);
+    bool IsDistributedNodeSystemIdAssignmentAuto();
     const std::vector<int64_t>& GetDistributedNodeSystemIdAssignment();
     int64_t GetSimulationEndTimeNs();
     std::string GetConfigParamOrFail(std::string key);
@@ -57,6 +62,9 @@ public:
     std::string GetLogsDir();
     std::string GetRunDir();
 
+    // Setters
+    void SetDistributedNodeSystemIdAssignment(const std::vector<int64_t>& assignment);
+
 private:
 
     // Internal setup
@@ -70,17 +78,24 @@ private:
     void CleanUpSimulation();
     void ConfirmAllConfigParamKeysRequested();
     void StoreTimingResults();
+    void StoreDistributedStatistics();
 
     // Timestamp to identify which parts take long
     int64_t NowNsSinceEpoch();
     std::vector<std::pair<std::string, int64_t>> m_timestamps; // List of all important events happening in the pipeline
 
+    // Distributed statistics (the getters are evaluated once the simulation has run)
+    std::vector<std::pair<std::string, int64_t>> m_distributed_statistics;
+    std::vector<std::pair<std::string, Callback<int64_t>>> m_distributed_statistic_getters;
+
     // Run directory
     std::string m_run_dir;
     std::string m_logs_dir;
     std::string m_finished_filename;
     std::string m_timing_results_csv_filename;
     std::string m_timing_results_txt_filename;
+    std::string m_distributed_statistics_csv_filename;
+    std::string m_distributed_statistics_txt_filename;
 
     // Config variables
     std::map<std::string, std::string> m_config;
@@ -91,6 +106,7 @@ private:
     uint32_t m_systems_count;
     bool m_enable_distributed;
     std::vector<int64_t> m_distributed_node_system_id_assignment;
+    bool m_distributed_node_system_id_assignment_auto;
 
     // Progress show variables
     int64_t m_sim_start_time_ns_since_epoch;
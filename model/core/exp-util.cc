@@ -147,6 +147,42 @@ std::vector<std::string> split_string(const std::string line, const std::string
     return the_split;
 }
 
+/**
+ * Split the character range [begin, end) by a single-character delimiter without copying,
+ * and check that the split size is of expected size. If it is not of expected size, throw an exception.
+ * The fields vector is overwritten, such that it can be re-used without allocation across lines.
+ *
+ * @param begin         Start of the range (e.g., of "a,b,c")
+ * @param end           End of the range (exclusive)
+ * @param delimiter     Delimiter character (e.g., ',')
+ * @param expected      Expected number (e.g., 3)
+ * @param fields        Output: [begin, end) of each field (e.g., of [a, b, c])
+ */
+void split_string_in_place(const char* begin, const char* end, char delimiter, size_t expected, std::vector<std::pair<const char*, const char*>>& fields) {
+    fields.clear();
+    const char* field_begin = begin;
+    const char* idx;
+    while ((idx = (const char*) memchr(field_begin, delimiter, end - field_begin)) != nullptr) {
+        fields.push_back(std::make_pair(field_begin, idx));
+        field_begin = idx + 1;
+    }
+    fields.push_back(std::make_pair(field_begin, end));
+
+    // It must match the expected split length, else throw exception
+    if (fields.size() != expected) {
+        throw std::invalid_argument(
+                format_string(
+                        "String %s has a %c-split of %zu != %zu",
+                        std::string(begin, end).c_str(),
+                        delimiter,
+                        fields.size(),
+                        expected
+                )
+        );
+    }
+
+}
+
 /**
  * Parse string (whitespace removed) into an int64, or throw an exception.
  *
@@ -155,23 +191,55 @@ std::vector<std::string> split_string(const std::string line, const std::string
  * @return Int64
  */
 int64_t parse_int64(const std::string& str) {
+    return parse_int64(str.data(), str.data() + str.size());
+}
 
-    // Parse using stoll -- rethrow argument to be a bit easier debuggable
-    std::string str_no_whitespace = trim(str);
-    int64_t val;
-    size_t i;
-    try {
-        val = std::stoll(str_no_whitespace, &i);
-    } catch (const std::invalid_argument&) {
-        throw std::invalid_argument("Could not convert to int64: " + str);
+/**
+ * Parse the character range [begin, end) (whitespace removed) into an int64, or throw an exception.
+ * It is parsed in place, without copying or allocating.
+ *
+ * @param begin     Start of the range
+ * @param end       End of the range (exclusive)
+ *
+ * @return Int64
+ */
+int64_t parse_int64(const char* begin, const char* end) {
+
+    // Remove whitespace
+    const char* p = begin;
+    const char* q = end;
+    while (p < q && isspace((unsigned char) *p)) {
+        p++;
+    }
+    while (q > p && isspace((unsigned char) *(q - 1))) {
+        q--;
     }
 
-    // No remainder
-    if (i != str_no_whitespace.size()) {
-        throw std::invalid_argument("Could not convert to int64: " + str);
+    // Optional sign
+    bool negative = false;
+    if (p < q && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
     }
 
-    return val;
+    // Only digits may remain, at least one
+    if (p == q) {
+        throw std::invalid_argument("Could not convert to int64: " + std::string(begin, end));
+    }
+    uint64_t magnitude = 0;
+    const uint64_t limit = negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+    for (; p < q; p++) {
+        if (*p < '0' || *p > '9') {
+            throw std::invalid_argument("Could not convert to int64: " + std::string(begin, end));
+        }
+        uint64_t digit = (uint64_t) (*p - '0');
+        if (magnitude > (limit - digit) / 10) {
+            throw std::out_of_range("Out of range of int64: " + std::string(begin, end));
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+
+    return negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude;
 }
 
 /**
@@ -182,7 +250,19 @@ int64_t parse_int64(const std::string& str) {
  * @return Int64
  */
 int64_t parse_positive_int64(const std::string& str) {
-    int64_t val = parse_int64(str);
+    return parse_positive_int64(str.data(), str.data() + str.size());
+}
+
+/**
+ * Parse the character range [begin, end) into a positive int64, or throw an exception.
+ *
+ * @param begin     Start of the range
+ * @param end       End of the range (exclusive)
+ *
+ * @return Int64
+ */
+int64_t parse_positive_int64(const char* begin, const char* end) {
+    int64_t val = parse_int64(begin, end);
     if (val < 0) {
         throw std::invalid_argument(format_string("Negative int64 value not permitted: %" PRId64, val));
     }
@@ -246,6 +326,54 @@ double parse_positive_double(const std::string& str) {
     return val;
 }
 
+/**
+ * Parse the character range [begin, end) into a positive double, or throw an exception.
+ * Short values (as in schedules) are parsed from a stack buffer, without allocating.
+ *
+ * @param begin     Start of the range
+ * @param end       End of the range (exclusive)
+ *
+ * @return Positive double
+ */
+double parse_positive_double(const char* begin, const char* end) {
+
+    // Remove whitespace
+    const char* p = begin;
+    const char* q = end;
+    while (p < q && isspace((unsigned char) *p)) {
+        p++;
+    }
+    while (q > p && isspace((unsigned char) *(q - 1))) {
+        q--;
+    }
+
+    // Long values take the regular path
+    char buffer[64];
+    if (q - p >= (int64_t) sizeof(buffer)) {
+        return parse_positive_double(std::string(begin, end));
+    }
+    if (p == q) {
+        throw std::invalid_argument("Could not convert to double: " + std::string(begin, end));
+    }
+
+    // Parse using strtod (as stod does), the full value must be consumed
+    memcpy(buffer, p, q - p);
+    buffer[q - p] = '\0';
+    char* parse_end;
+    errno = 0;
+    double val = strtod(buffer, &parse_end);
+    if (parse_end != buffer + (q - p)) {
+        throw std::invalid_argument("Could not convert to double: " + std::string(begin, end));
+    }
+    if (errno == ERANGE) {
+        throw std::out_of_range("Out of range of double: " + std::string(begin, end));
+    }
+    if (val < 0) {
+        throw std::invalid_argument(format_string("Negative double value not permitted: %f", val));
+    }
+    return val;
+}
+
 /**
  * Parse string into a double in the range of [0.0, 1.0], or throw an exception.
  *
@@ -745,3 +873,63 @@ std::vector<std::string> read_file_direct(const std::string& filename) {
     return lines;
 
 }
+
+/**
+ * Map a file read-only into memory, such that its lines can be scanned without copying.
+ *
+ * @param filename  File name
+ */
+MappedFileLineReader::MappedFileLineReader(const std::string& filename) {
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw std::runtime_error(format_string("File %s could not be opened.", filename.c_str()));
+    }
+    struct stat info;
+    if (fstat(m_fd, &info) != 0) {
+        close(m_fd);
+        throw std::runtime_error(format_string("File %s could not be inspected.", filename.c_str()));
+    }
+    m_size = (size_t) info.st_size;
+    m_position = 0;
+    m_data = nullptr;
+    if (m_size > 0) { // An empty file cannot be mapped
+        void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(m_fd);
+            throw std::runtime_error(format_string("File %s could not be mapped into memory.", filename.c_str()));
+        }
+        madvise(mapped, m_size, MADV_SEQUENTIAL);
+        m_data = (const char*) mapped;
+    }
+}
+
+MappedFileLineReader::~MappedFileLineReader() {
+    if (m_data != nullptr) {
+        munmap((void*) m_data, m_size);
+    }
+    close(m_fd);
+}
+
+/**
+ * Retrieve the next line (without the newline character), like getline() would.
+ *
+ * @param line_begin    Output: start of the line
+ * @param line_end      Output: end of the line (exclusive)
+ *
+ * @return True iff there was a next line
+ */
+bool MappedFileLineReader::NextLine(const char*& line_begin, const char*& line_end) {
+    if (m_position >= m_size) {
+        return false;
+    }
+    line_begin = m_data + m_position;
+    const char* newline = (const char*) memchr(line_begin, '\n', m_size - m_position);
+    if (newline == nullptr) {
+        line_end = m_data + m_size;
+        m_position = m_size;
+    } else {
+        line_end = newline;
+        m_position = newline - m_data + 1;
+    }
+    return true;
+}
@@ -33,8 +33,13 @@
 #include <cinttypes>
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <climits>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 /**
  * Direct format() for a string in one line (e.g., for exceptions).
@@ -67,13 +72,17 @@ bool starts_with(const std::string& str, const std::string& prefix);
 std::string remove_start_end_double_quote_if_present(std::string s);
 std::vector<std::string> split_string(std::string line, const std::string delimiter);
 std::vector<std::string> split_string(std::string line, const std::string delimiter, size_t expected);
+void split_string_in_place(const char* begin, const char* end, char delimiter, size_t expected, std::vector<std::pair<const char*, const char*>>& fields);
 
 // Parsing values
 int64_t parse_int64(const std::string& str);
 int64_t parse_positive_int64(const std::string& str);
+int64_t parse_int64(const char* begin, const char* end);
+int64_t parse_positive_int64(const char* begin, const char* end);
 int64_t parse_geq_one_int64(const std::string& str);
 double parse_double(const std::string& str);
 double parse_positive_double(const std::string& str);;
+double parse_positive_double(const char* begin, const char* end);
 double parse_double_between_zero_and_one(const std::string& str);
 bool parse_boolean(const std::string& str);
 std::set<std::string> parse_set_string(const std::string line);
@@ -107,4 +116,19 @@ void remove_dir_if_exists(std::string dirname);
 void mkdir_if_not_exists(std::string dirname);
 std::vector<std::string> read_file_direct(const std::string& filename);
 
+// Zero-copy line scanning of a (large) file mapped into memory
+class MappedFileLineReader {
+public:
+    MappedFileLineReader(const std::string& filename);
+    ~MappedFileLineReader();
+    bool NextLine(const char*& line_begin, const char*& line_end);
+private:
+    MappedFileLineReader(const MappedFileLineReader&) = delete;
+    MappedFileLineReader& operator=(const MappedFileLineReader&) = delete;
+    int m_fd;
+    const char* m_data;
+    size_t m_size;
+    size_t m_position;
+};
+
 #endif //EXP_UTIL_H
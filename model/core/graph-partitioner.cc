@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "graph-partitioner.h"
+
+namespace ns3 {
+
+/**
+ * Find the representative of a node in a union-find structure (with path halving).
+ *
+ * @param parent    Union-find parents
+ * @param x         Node
+ *
+ * @return Representative
+ */
+static int64_t union_find_root(std::vector<int64_t>& parent, int64_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * Contract all edges with a delay strictly less than the threshold.
+ *
+ * @param num_nodes         Number of nodes
+ * @param undirected_edges  Undirected edges
+ * @param edge_delays_ns    Delay of each edge
+ * @param threshold_ns      Threshold delay
+ * @param component         Output: component index of each node (0, 1, ...)
+ *
+ * @return Number of components
+ */
+static int64_t contract_below_delay(
+        int64_t num_nodes,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<int64_t>& edge_delays_ns,
+        int64_t threshold_ns,
+        std::vector<int64_t>& component
+) {
+    std::vector<int64_t> parent(num_nodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (size_t i = 0; i < undirected_edges.size(); i++) {
+        if (edge_delays_ns[i] < threshold_ns) {
+            parent[union_find_root(parent, undirected_edges[i].first)] = union_find_root(parent, undirected_edges[i].second);
+        }
+    }
+    component.assign(num_nodes, -1);
+    std::vector<int64_t> root_to_component(num_nodes, -1);
+    int64_t num_components = 0;
+    for (int64_t v = 0; v < num_nodes; v++) {
+        int64_t root = union_find_root(parent, v);
+        if (root_to_component[root] == -1) {
+            root_to_component[root] = num_components++;
+        }
+        component[v] = root_to_component[root];
+    }
+    return num_components;
+}
+
+/**
+ * Pack the components into parts without exceeding the capacity and with each part non-empty.
+ * First greedy graph growing is tried: fill the parts one after the other in the given
+ * order (of adjacency), leaving enough components for the remaining parts to be non-empty.
+ * If that does not fit, each component is put in the least full part in order of
+ * decreasing size instead (which does not keep adjacent components together).
+ *
+ * @param order                 Components in order of adjacency
+ * @param component_size        Size of each component
+ * @param num_parts             Number of parts (at most the number of components)
+ * @param capacity              Maximum size of a part
+ * @param part_of               Output: part of each component
+ * @param part_size             Output: size of each part
+ * @param part_num_components   Output: number of components of each part
+ *
+ * @return True iff the components could be packed
+ */
+static bool pack_components(
+        const std::vector<int64_t>& order,
+        const std::vector<int64_t>& component_size,
+        int64_t num_parts,
+        int64_t capacity,
+        std::vector<int64_t>& part_of,
+        std::vector<int64_t>& part_size,
+        std::vector<int64_t>& part_num_components
+) {
+    int64_t num_nodes = std::accumulate(component_size.begin(), component_size.end(), (int64_t) 0);
+    double target = (double) num_nodes / (double) num_parts;
+
+    // Greedy graph growing
+    part_of.assign(component_size.size(), -1);
+    part_size.assign(num_parts, 0);
+    part_num_components.assign(num_parts, 0);
+    int64_t p = 0;
+    bool fits = true;
+    for (size_t idx = 0; idx < order.size() && fits; idx++) {
+        int64_t c = order[idx];
+        int64_t num_remaining = order.size() - idx;
+        if (p < num_parts - 1 && part_size[p] > 0 && (
+                part_size[p] >= target
+                || part_size[p] + component_size[c] > capacity
+                || num_remaining <= num_parts - 1 - p
+        )) {
+            p++;
+        }
+        int64_t chosen = p;
+        if (part_size[chosen] + component_size[c] > capacity) { // Then it is the last part, so take the least full one
+            chosen = std::min_element(part_size.begin(), part_size.end()) - part_size.begin();
+        }
+        fits = part_size[chosen] + component_size[c] <= capacity;
+        part_of[c] = chosen;
+        part_size[chosen] += component_size[c];
+        part_num_components[chosen]++;
+    }
+    if (fits) {
+        return true;
+    }
+
+    // Least full part in order of decreasing size (the first components each get an empty part)
+    std::vector<int64_t> by_size(order);
+    std::stable_sort(by_size.begin(), by_size.end(), [&component_size](int64_t a, int64_t b) {
+        return component_size[a] > component_size[b];
+    });
+    part_of.assign(component_size.size(), -1);
+    part_size.assign(num_parts, 0);
+    part_num_components.assign(num_parts, 0);
+    for (int64_t c : by_size) {
+        int64_t chosen = std::min_element(part_size.begin(), part_size.end()) - part_size.begin();
+        if (part_size[chosen] + component_size[c] > capacity) {
+            return false;
+        }
+        part_of[c] = chosen;
+        part_size[chosen] += component_size[c];
+        part_num_components[chosen]++;
+    }
+    return true;
+}
+
+/**
+ * Partition the nodes of a graph into parts, such that:
+ *
+ * (1) The minimum delay of the edges between parts (the lookahead) is high: the edges
+ *     below the highest delay threshold for which the remaining components could be
+ *     packed into the parts are never cut (packing is a heuristic, so it is not
+ *     guaranteed to be the maximum);
+ * (2) The size of each part is at most (1 + max_imbalance) times the average (rounded up),
+ *     and each part has at least one node;
+ * (3) The total weight of the edges between parts is low (greedy graph growing
+ *     followed by refinement, it is a heuristic).
+ *
+ * The outcome is deterministic.
+ *
+ * @param num_nodes         Number of nodes (node identifiers are 0 to num_nodes - 1)
+ * @param undirected_edges  Undirected edges
+ * @param edge_weights      Weight of each edge (e.g., its data rate)
+ * @param edge_delays_ns    Delay of each edge (ns)
+ * @param num_parts         Number of parts (at least 1, and at most the number of nodes)
+ * @param max_imbalance     Maximum imbalance of the part sizes (at least 0)
+ *
+ * @return Part of each node
+ */
+std::vector<int64_t> partition_graph(
+        int64_t num_nodes,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<double>& edge_weights,
+        const std::vector<int64_t>& edge_delays_ns,
+        int64_t num_parts,
+        double max_imbalance
+) {
+
+    // Check input
+    if (num_parts < 1 || num_parts > num_nodes) {
+        throw std::invalid_argument(format_string("Cannot partition %" PRId64 " nodes into %" PRId64 " parts", num_nodes, num_parts));
+    }
+    if (max_imbalance < 0) {
+        throw std::invalid_argument(format_string("Maximum imbalance must be non-negative (is: %f)", max_imbalance));
+    }
+    if (edge_weights.size() != undirected_edges.size() || edge_delays_ns.size() != undirected_edges.size()) {
+        throw std::invalid_argument("Each edge must have exactly one weight and one delay");
+    }
+    for (const std::pair<int64_t, int64_t>& edge : undirected_edges) {
+        if (edge.first < 0 || edge.first >= num_nodes || edge.second < 0 || edge.second >= num_nodes) {
+            throw std::invalid_argument(format_string("Edge %" PRId64 "-%" PRId64 " has a non-existent node", edge.first, edge.second));
+        }
+    }
+    int64_t capacity = std::max(
+            (int64_t) std::ceil((double) num_nodes / (double) num_parts),
+            (int64_t) std::floor((1.0 + max_imbalance) * (double) num_nodes / (double) num_parts)
+    );
+
+    // Lookahead: find the highest delay threshold such that contracting all edges below it
+    // still leaves enough components which each fit in a part (this necessary condition is
+    // monotone in the threshold, and contracting no edge at all always meets it)
+    std::vector<int64_t> thresholds(edge_delays_ns);
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+    std::vector<int64_t> component;
+    int64_t lo = 0; // Index of the highest threshold known to meet it (index 0: contract nothing)
+    int64_t hi = thresholds.size() - 1;
+    while (lo < hi) {
+        int64_t mid = (lo + hi + 1) / 2;
+        int64_t num_components = contract_below_delay(num_nodes, undirected_edges, edge_delays_ns, thresholds[mid], component);
+        std::vector<int64_t> component_size(num_components, 0);
+        for (int64_t v = 0; v < num_nodes; v++) {
+            component_size[component[v]]++;
+        }
+        if (num_components >= num_parts && *std::max_element(component_size.begin(), component_size.end()) <= capacity) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    // Lower the threshold until the components can actually be packed into the parts
+    // (without contracting any edge all components are single nodes, which always fit)
+    int64_t num_components;
+    std::vector<int64_t> component_size;
+    std::vector<std::map<int64_t, double>> adjacency;
+    std::vector<int64_t> order;
+    std::vector<int64_t> part_of;
+    std::vector<int64_t> part_size;
+    std::vector<int64_t> part_num_components;
+    for (int64_t t = lo; ; t--) {
+        num_components = contract_below_delay(num_nodes, undirected_edges, edge_delays_ns, thresholds.empty() ? 0 : thresholds[t], component);
+
+        // Contracted graph
+        component_size.assign(num_components, 0);
+        for (int64_t v = 0; v < num_nodes; v++) {
+            component_size[component[v]]++;
+        }
+        adjacency.assign(num_components, std::map<int64_t, double>());
+        for (size_t i = 0; i < undirected_edges.size(); i++) {
+            int64_t a = component[undirected_edges[i].first];
+            int64_t b = component[undirected_edges[i].second];
+            if (a != b) {
+                adjacency[a][b] += edge_weights[i];
+                adjacency[b][a] += edge_weights[i];
+            }
+        }
+
+        // Order the components by breadth-first search, starting each time from the largest unvisited
+        std::vector<int64_t> by_size(num_components);
+        std::iota(by_size.begin(), by_size.end(), 0);
+        std::stable_sort(by_size.begin(), by_size.end(), [&component_size](int64_t a, int64_t b) {
+            return component_size[a] > component_size[b];
+        });
+        std::vector<bool> visited(num_components, false);
+        order.clear();
+        for (int64_t start : by_size) {
+            if (visited[start]) {
+                continue;
+            }
+            visited[start] = true;
+            size_t head = order.size();
+            order.push_back(start);
+            while (head < order.size()) {
+                int64_t c = order[head++];
+                for (const std::pair<const int64_t, double>& neighbor : adjacency[c]) {
+                    if (!visited[neighbor.first]) {
+                        visited[neighbor.first] = true;
+                        order.push_back(neighbor.first);
+                    }
+                }
+            }
+        }
+
+        if (num_components >= num_parts && pack_components(order, component_size, num_parts, capacity, part_of, part_size, part_num_components)) {
+            break;
+        }
+        if (t == 0) {
+            throw std::runtime_error("Cannot pack the nodes into the parts within the capacity"); // Cannot happen (single nodes always fit)
+        }
+    }
+
+    // Refinement: move a component to the part it is most connected to if that reduces
+    // the cut weight and the balance and non-emptiness are maintained
+    for (int pass = 0; pass < 20; pass++) {
+        bool moved = false;
+        for (int64_t c : order) {
+            int64_t from = part_of[c];
+            if (part_num_components[from] == 1) {
+                continue;
+            }
+            std::map<int64_t, double> connection;
+            for (const std::pair<const int64_t, double>& neighbor : adjacency[c]) {
+                connection[part_of[neighbor.first]] += neighbor.second;
+            }
+            int64_t best = from;
+            double best_gain = 1e-9;
+            for (const std::pair<const int64_t, double>& to : connection) {
+                double gain = to.second - connection[from];
+                if (to.first != from && gain > best_gain && part_size[to.first] + component_size[c] <= capacity) {
+                    best = to.first;
+                    best_gain = gain;
+                }
+            }
+            if (best != from) {
+                part_of[c] = best;
+                part_size[from] -= component_size[c];
+                part_size[best] += component_size[c];
+                part_num_components[from]--;
+                part_num_components[best]++;
+                moved = true;
+            }
+        }
+        if (!moved) {
+            break;
+        }
+    }
+
+    // Assignment of each node
+    std::vector<int64_t> assignment(num_nodes);
+    for (int64_t v = 0; v < num_nodes; v++) {
+        assignment[v] = part_of[component[v]];
+    }
+    return assignment;
+
+}
+
+/**
+ * Calculate the lookahead of a partition: the minimum delay of the edges between parts.
+ *
+ * @param assignment        Part of each node
+ * @param undirected_edges  Undirected edges
+ * @param edge_delays_ns    Delay of each edge (ns)
+ *
+ * @return Lookahead (ns), or -1 if no edge is between parts
+ */
+int64_t calculate_partition_lookahead_ns(
+        const std::vector<int64_t>& assignment,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<int64_t>& edge_delays_ns
+) {
+    int64_t lookahead_ns = -1;
+    for (size_t i = 0; i < undirected_edges.size(); i++) {
+        if (assignment.at(undirected_edges[i].first) != assignment.at(undirected_edges[i].second)) {
+            if (lookahead_ns == -1 || edge_delays_ns.at(i) < lookahead_ns) {
+                lookahead_ns = edge_delays_ns.at(i);
+            }
+        }
+    }
+    return lookahead_ns;
+}
+
+/**
+ * Calculate the cut weight of a partition: the total weight of the edges between parts.
+ *
+ * @param assignment        Part of each node
+ * @param undirected_edges  Undirected edges
+ * @param edge_weights      Weight of each edge
+ *
+ * @return Cut weight
+ */
+double calculate_partition_cut_weight(
+        const std::vector<int64_t>& assignment,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<double>& edge_weights
+) {
+    double cut_weight = 0;
+    for (size_t i = 0; i < undirected_edges.size(); i++) {
+        if (assignment.at(undirected_edges[i].first) != assignment.at(undirected_edges[i].second)) {
+            cut_weight += edge_weights.at(i);
+        }
+    }
+    return cut_weight;
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef GRAPH_PARTITIONER_H
+#define GRAPH_PARTITIONER_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <limits>
+#include <cinttypes>
+#include <stdexcept>
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+std::vector<int64_t> partition_graph(
+        int64_t num_nodes,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<double>& edge_weights,
+        const std::vector<int64_t>& edge_delays_ns,
+        int64_t num_parts,
+        double max_imbalance
+);
+
+int64_t calculate_partition_lookahead_ns(
+        const std::vector<int64_t>& assignment,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<int64_t>& edge_delays_ns
+);
+
+double calculate_partition_cut_weight(
+        const std::vector<int64_t>& assignment,
+        const std::vector<std::pair<int64_t, int64_t>>& undirected_edges,
+        const std::vector<double>& edge_weights
+);
+
+}
+
+#endif //GRAPH_PARTITIONER_H
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/interval-log-spill.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (IntervalLogSpill);
+TypeId IntervalLogSpill::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::IntervalLogSpill")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+IntervalLogSpill::IntervalLogSpill(const std::string& spill_filename) {
+    m_spill_filename = spill_filename;
+    m_writer = CreateObject<AsyncLogWriter>();
+    m_file_handle = m_writer->Open(spill_filename, false);
+    m_num_spilled_intervals = 0;
+}
+
+IntervalLogSpill::~IntervalLogSpill() {
+    try {
+        Remove();
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl; // Destructors are not allowed to throw
+    }
+}
+
+/**
+ * Add a stream (i.e., a log) to the spill file.
+ *
+ * @return Stream identifier
+ */
+int64_t IntervalLogSpill::AddStream() {
+    m_stream_blocks.push_back(std::vector<std::pair<int64_t, int64_t>>());
+    return (int64_t) m_stream_blocks.size() - 1;
+}
+
+/**
+ * Spill a block of intervals of a stream. They must follow on the previously spilled intervals of that stream.
+ *
+ * @param stream_id     Stream identifier
+ * @param intervals     Intervals (start, end, value)
+ */
+void IntervalLogSpill::Spill(int64_t stream_id, const std::vector<std::tuple<int64_t, int64_t, int64_t>>& intervals) {
+    if (m_writer == 0) {
+        throw std::runtime_error("Cannot spill to an interval log spill file which has been removed: " + m_spill_filename);
+    }
+    if (intervals.empty()) {
+        return;
+    }
+
+    // Each interval is a record of three little-endian int64
+    m_block.clear();
+    for (const std::tuple<int64_t, int64_t, int64_t>& interval : intervals) {
+        int64_t values[3] = {std::get<0>(interval), std::get<1>(interval), std::get<2>(interval)};
+        for (int64_t value : values) {
+            uint64_t v = (uint64_t) value;
+            for (int i = 0; i < 8; i++) {
+                m_block.push_back((char) ((v >> (8 * i)) & 0xFF));
+            }
+        }
+    }
+    m_writer->Write(m_file_handle, m_block.data(), m_block.size());
+
+    // Index the block
+    m_stream_blocks.at(stream_id).push_back(std::make_pair(m_num_spilled_intervals, (int64_t) intervals.size()));
+    m_num_spilled_intervals += intervals.size();
+}
+
+/**
+ * Write all spilled intervals of a stream in order as records <record prefix>,<start>,<end>,<value>
+ * to a log output sink. Only one block is in memory at a time.
+ *
+ * @param stream_id         Stream identifier
+ * @param sink              Log output sink
+ * @param record_prefix     Values which precede each interval in the record
+ */
+void IntervalLogSpill::WriteStream(int64_t stream_id, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+    if (m_writer == 0) {
+        throw std::runtime_error("Cannot read from an interval log spill file which has been removed: " + m_spill_filename);
+    }
+    if (record_prefix.size() + 3 != sink->GetColumns().size()) {
+        throw std::invalid_argument("Log output sink must have three columns (start, end, value) besides the record prefix.");
+    }
+
+    // Everything spilled must be on disk before reading it back
+    m_writer->Flush();
+    FILE* file = fopen(m_spill_filename.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Could not open interval log spill file: " + m_spill_filename);
+    }
+
+    // Read back block-by-block
+    std::vector<int64_t> record = record_prefix;
+    record.resize(record_prefix.size() + 3);
+    for (const std::pair<int64_t, int64_t>& block : m_stream_blocks.at(stream_id)) {
+        m_block.resize(block.second * 24);
+        if (fseek(file, block.first * 24, SEEK_SET) != 0 || fread(&m_block[0], 1, m_block.size(), file) != m_block.size()) {
+            fclose(file);
+            throw std::runtime_error("Could not read block from interval log spill file: " + m_spill_filename);
+        }
+        for (int64_t i = 0; i < block.second; i++) {
+            for (int64_t j = 0; j < 3; j++) {
+                uint64_t v = 0;
+                for (int k = 0; k < 8; k++) {
+                    v |= ((uint64_t) (unsigned char) m_block[i * 24 + j * 8 + k]) << (8 * k);
+                }
+                record[record_prefix.size() + j] = (int64_t) v;
+            }
+            sink->WriteRecord(record.data());
+        }
+    }
+    fclose(file);
+}
+
+/**
+ * Close and remove the spill file. Afterwards nothing can be spilled or read back anymore.
+ */
+void IntervalLogSpill::Remove() {
+    if (m_writer != 0) {
+        m_writer->Close();
+        m_writer = 0;
+        remove_file_if_exists(m_spill_filename);
+    }
+}
+
+const std::string& IntervalLogSpill::GetSpillFilename() {
+    return m_spill_filename;
+}
+
+int64_t IntervalLogSpill::GetNumStreams() {
+    return (int64_t) m_stream_blocks.size();
+}
+
+int64_t IntervalLogSpill::GetNumSpilledIntervals() {
+    return m_num_spilled_intervals;
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef INTERVAL_LOG_SPILL_H
+#define INTERVAL_LOG_SPILL_H
+
+#include <tuple>
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+#include "ns3/async-log-writer.h"
+#include "ns3/log-output-sink.h"
+
+namespace ns3 {
+
+/**
+ * Spill file to which the finalized intervals (start, end, value) of multiple logs (streams)
+ * are written in blocks while the simulation runs, such that each log only has to keep a
+ * bounded number of intervals in memory.
+ *
+ * The blocks of the streams are interleaved in the spill file, but an index of the blocks
+ * of each stream is kept. Afterwards, each stream can be written out in order to a
+ * log output sink, reading back only one block at a time.
+ */
+class IntervalLogSpill : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    IntervalLogSpill(const std::string& spill_filename);
+    virtual ~IntervalLogSpill();
+
+    int64_t AddStream();
+    void Spill(int64_t stream_id, const std::vector<std::tuple<int64_t, int64_t, int64_t>>& intervals);
+    void WriteStream(int64_t stream_id, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
+    void Remove();
+
+    const std::string& GetSpillFilename();
+    int64_t GetNumStreams();
+    int64_t GetNumSpilledIntervals();
+
+private:
+    std::string m_spill_filename;
+    Ptr<AsyncLogWriter> m_writer;
+    int64_t m_file_handle;
+    int64_t m_num_spilled_intervals;
+    std::vector<std::vector<std::pair<int64_t, int64_t>>> m_stream_blocks; // Per stream: (first interval index, number of intervals)
+    std::string m_block;
+};
+
+}
+
+#endif //INTERVAL_LOG_SPILL_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/ip-to-node-id-index.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (IpToNodeIdIndex);
+TypeId IpToNodeIdIndex::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::IpToNodeIdIndex")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+IpToNodeIdIndex::IpToNodeIdIndex(NodeContainer nodes) {
+
+    // Each interface has an IP address, so multiple IPs per node (interface 0 is the loop-back)
+    m_num_addresses = 0;
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        m_num_addresses += nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces() - 1;
+    }
+
+    // Capacity is a power of two of at least twice the number of addresses, such that probe sequences are short
+    uint64_t capacity = 2;
+    uint32_t log2_capacity = 1;
+    while (capacity < (uint64_t) (2 * m_num_addresses)) {
+        capacity *= 2;
+        log2_capacity++;
+    }
+    if (log2_capacity > 31) {
+        throw std::runtime_error(format_string("Too many IP addresses to index: %" PRId64, m_num_addresses));
+    }
+    m_mask = capacity - 1;
+    m_shift = 32 - log2_capacity; // Multiplicative hashing: use the most significant bits
+    m_keys = std::vector<uint32_t>(capacity, 0);
+    m_values = std::vector<uint32_t>(capacity, 0);
+
+    // Store IP address to node id
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        Ptr<Ipv4> ipv4 = nodes.Get(i)->GetObject<Ipv4>();
+        for (uint32_t j = 1; j < ipv4->GetNInterfaces(); j++) {
+            Insert(ipv4->GetAddress(j, 0).GetLocal().Get(), i);
+        }
+    }
+
+}
+
+IpToNodeIdIndex::~IpToNodeIdIndex() {
+    // Left empty intentionally
+}
+
+void IpToNodeIdIndex::Insert(uint32_t ip, uint32_t node_id) {
+    uint64_t slot = Slot(ip);
+    while (m_values[slot] != 0) {
+        if (m_keys[slot] == ip) {
+            return; // The first node with this IP address is kept
+        }
+        slot = (slot + 1) & m_mask;
+    }
+    m_keys[slot] = ip;
+    m_values[slot] = node_id + 1;
+}
+
+int64_t IpToNodeIdIndex::GetNumAddresses() const {
+    return m_num_addresses;
+}
+
+int64_t IpToNodeIdIndex::GetCapacity() const {
+    return (int64_t) m_keys.size();
+}
+
+uint32_t IpToNodeIdIndex::ResolveNodeIdFromIp(uint32_t ip) const {
+    uint64_t slot = Slot(ip);
+    while (m_values[slot] != 0) {
+        if (m_keys[slot] == ip) {
+            return m_values[slot] - 1;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+    std::ostringstream res;
+    res << "IP address " << Ipv4Address(ip)  << " (" << ip << ") is not mapped to a node id";
+    throw std::invalid_argument(res.str());
+}
+
+}
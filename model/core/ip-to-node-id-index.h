@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef IP_TO_NODE_ID_INDEX_H
+#define IP_TO_NODE_ID_INDEX_H
+
+#include "ns3/core-module.h"
+#include "ns3/node-container.h"
+#include "ns3/ipv4.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Immutable index from interface IP address to node identifier, built once for all nodes
+ * and shared by all arbiters.
+ *
+ * It is a flat open-addressing hash table with linear probing, with a power-of-two capacity
+ * of at least twice the number of addresses. As such, a lookup is O(1) and touches only
+ * one or a few adjacent slots.
+ */
+class IpToNodeIdIndex : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    IpToNodeIdIndex(NodeContainer nodes);
+    virtual ~IpToNodeIdIndex();
+
+    // Retrieval
+    int64_t GetNumAddresses() const;
+    int64_t GetCapacity() const;
+    uint32_t ResolveNodeIdFromIp(uint32_t ip) const;
+
+private:
+    void Insert(uint32_t ip, uint32_t node_id);
+    inline uint64_t Slot(uint32_t ip) const {
+        return (uint64_t) ((ip * 2654435761u) >> m_shift) & m_mask;
+    }
+
+    int64_t m_num_addresses;
+    uint64_t m_mask;
+    uint32_t m_shift;
+    std::vector<uint32_t> m_keys;       // IP address in the slot
+    std::vector<uint32_t> m_values;     // Node identifier + 1 in the slot (0 means the slot is empty)
+};
+
+}
+
+#endif //IP_TO_NODE_ID_INDEX_H
@@ -153,6 +153,9 @@ namespace ns3 {
         // Info: If no route is found for a packet with the header with source IP = 102.102.102.102,
         //       the TCP socket will conclude there is no route and not even send out SYNs (any real packet).
         //       If source IP is set already, it just gets dropped and the TCP socket sees it as a normal loss somewhere in the network.
+        if (m_arbiter != 0 && p != 0) {
+            m_arbiter->TagOutgoingPacket(p, header); // Only once on the sender, before its decision
+        }
         Ptr<Ipv4Route> route = LookupArbiter(destination, header, p, oif);
         if (route == 0) {
             sockerr = Socket::ERROR_NOROUTETOHOST;
@@ -271,6 +274,11 @@ namespace ns3 {
     void 
     Ipv4ArbiterRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const {
         std::ostream* os = stream->GetStream ();
+        if (m_arbiter == 0) {
+            // In a distributed run, nodes of other systems do not get an arbiter
+            *os << "No arbiter at node " << m_nodeId << " (it belongs to another system)" << std::endl;
+            return;
+        }
         *os << m_arbiter->StringReprOfForwardingState();
     }
 
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "latency-sketch.h"
+
+namespace ns3 {
+
+const double LatencySketch::DEFAULT_RELATIVE_ACCURACY = 0.01;
+
+LatencySketch::LatencySketch() : LatencySketch(DEFAULT_RELATIVE_ACCURACY) {
+    // Left empty intentionally
+}
+
+LatencySketch::LatencySketch(double relative_accuracy) {
+    if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0)) {
+        throw std::invalid_argument(format_string("Relative accuracy must be in (0, 1): %f", relative_accuracy));
+    }
+    m_relative_accuracy = relative_accuracy;
+    m_gamma = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+    m_log_gamma = std::log(m_gamma);
+    m_count = 0;
+    m_min = -1;
+    m_max = -1;
+    m_bucket_offset = 0;
+}
+
+/**
+ * Calculate the bucket of a value.
+ *
+ * @param value     Non-negative value
+ *
+ * @return Bucket (-1 for value 0)
+ */
+int32_t LatencySketch::CalculateBucket(int64_t value) const {
+    if (value == 0) {
+        return -1;
+    }
+    return (int32_t) std::ceil(std::log((double) value) / m_log_gamma);
+}
+
+/**
+ * Grow the kept range of buckets such that it includes the bucket.
+ *
+ * @param bucket    Bucket
+ */
+void LatencySketch::EnsureBucket(int32_t bucket) {
+    if (m_bucket_counts.empty()) {
+        m_bucket_offset = bucket;
+        m_bucket_counts.push_back(0);
+    } else if (bucket < m_bucket_offset) {
+        m_bucket_counts.insert(m_bucket_counts.begin(), m_bucket_offset - bucket, 0);
+        m_bucket_offset = bucket;
+    } else if (bucket >= m_bucket_offset + (int32_t) m_bucket_counts.size()) {
+        m_bucket_counts.resize(bucket - m_bucket_offset + 1, 0);
+    }
+}
+
+/**
+ * Add a value.
+ *
+ * @param value     Non-negative value
+ */
+void LatencySketch::Add(int64_t value) {
+    if (value < 0) {
+        throw std::invalid_argument(format_string("Value must be non-negative: %" PRId64, value));
+    }
+    int32_t bucket = CalculateBucket(value);
+    EnsureBucket(bucket);
+    m_bucket_counts[bucket - m_bucket_offset] += 1;
+    m_min = m_count == 0 ? value : std::min(m_min, value);
+    m_max = m_count == 0 ? value : std::max(m_max, value);
+    m_count++;
+}
+
+/**
+ * Merge another sketch into this one, such that it is as if all the values
+ * of both had been added here.
+ *
+ * @param other     Sketch with the same relative accuracy
+ */
+void LatencySketch::Merge(const LatencySketch& other) {
+    if (other.m_relative_accuracy != m_relative_accuracy) {
+        throw std::invalid_argument(format_string(
+                "Cannot merge sketches of different relative accuracy: %f vs. %f",
+                m_relative_accuracy, other.m_relative_accuracy
+        ));
+    }
+    if (other.m_count == 0) {
+        return;
+    }
+    EnsureBucket(other.m_bucket_offset);
+    EnsureBucket(other.m_bucket_offset + (int32_t) other.m_bucket_counts.size() - 1);
+    for (size_t i = 0; i < other.m_bucket_counts.size(); i++) {
+        m_bucket_counts[other.m_bucket_offset + i - m_bucket_offset] += other.m_bucket_counts[i];
+    }
+    m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+    m_max = m_count == 0 ? other.m_max : std::max(m_max, other.m_max);
+    m_count += other.m_count;
+}
+
+/**
+ * Retrieve the relative accuracy.
+ *
+ * @return Relative accuracy
+ */
+double LatencySketch::GetRelativeAccuracy() const {
+    return m_relative_accuracy;
+}
+
+/**
+ * Retrieve the number of values added.
+ *
+ * @return Count
+ */
+int64_t LatencySketch::GetCount() const {
+    return m_count;
+}
+
+/**
+ * Estimate a quantile. The estimate is within the relative accuracy of the value
+ * of rank floor(q * (count - 1)) among the added values in ascending order
+ * (the lowest and highest rank are exact).
+ *
+ * @param q     Quantile in [0, 1] (e.g., 0.99)
+ *
+ * @return Estimated value at the quantile (-1 if no values were added)
+ */
+int64_t LatencySketch::GetQuantile(double q) const {
+    if (q < 0.0 || q > 1.0) {
+        throw std::invalid_argument(format_string("Quantile must be in [0, 1]: %f", q));
+    }
+    if (m_count == 0) {
+        return -1;
+    }
+    int64_t rank = (int64_t) (q * (m_count - 1));
+    if (rank == 0) {
+        return m_min;
+    } else if (rank == m_count - 1) {
+        return m_max;
+    }
+    int64_t cumulative = 0;
+    size_t i = 0;
+    for (; i < m_bucket_counts.size(); i++) {
+        cumulative += m_bucket_counts[i];
+        if (cumulative > rank) {
+            break;
+        }
+    }
+    int64_t value = GetBucketValue(m_bucket_offset + (int32_t) i);
+    return std::max(m_min, std::min(m_max, value));
+}
+
+/**
+ * Retrieve the non-empty buckets, e.g., to write the sketch to file.
+ *
+ * @return Ascending list of (bucket, count)
+ */
+std::vector<std::pair<int32_t, uint64_t>> LatencySketch::GetBuckets() const {
+    std::vector<std::pair<int32_t, uint64_t>> result;
+    for (size_t i = 0; i < m_bucket_counts.size(); i++) {
+        if (m_bucket_counts[i] > 0) {
+            result.push_back(std::make_pair(m_bucket_offset + (int32_t) i, m_bucket_counts[i]));
+        }
+    }
+    return result;
+}
+
+/**
+ * Retrieve the value which represents a bucket, which is within the
+ * relative accuracy of all values counted in it.
+ *
+ * @param bucket    Bucket
+ *
+ * @return Representative value
+ */
+int64_t LatencySketch::GetBucketValue(int32_t bucket) const {
+    if (bucket < 0) {
+        return 0;
+    }
+    return (int64_t) std::round(2.0 * std::pow(m_gamma, bucket) / (m_gamma + 1.0));
+}
+
+/**
+ * Write the non-empty buckets to file, each line as: [bucket],[count],[bucket value].
+ * Files of sketches with the same relative accuracy (e.g., of each system in a
+ * distributed run) are merged by adding up the counts of equal buckets.
+ *
+ * @param filename  Output filename
+ */
+void LatencySketch::WriteToFile(const std::string& filename) const {
+    FILE* file = fopen(filename.c_str(), "w+");
+    if (file == nullptr) {
+        throw std::runtime_error("Could not open file for writing: " + filename);
+    }
+    for (std::pair<int32_t, uint64_t> b : GetBuckets()) {
+        fprintf(file, "%" PRId32 ",%" PRIu64 ",%" PRId64 "\n", b.first, b.second, GetBucketValue(b.first));
+    }
+    fclose(file);
+}
+
+}
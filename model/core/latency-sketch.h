@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef LATENCY_SKETCH_H
+#define LATENCY_SKETCH_H
+
+#include <vector>
+#include <cinttypes>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+/**
+ * Quantile sketch of a stream of non-negative integer values (e.g., latencies in ns),
+ * in the manner of DDSketch: value v > 0 is counted in bucket ceil(log_gamma(v)) with
+ * gamma = (1 + a) / (1 - a), such that any quantile is estimated within relative accuracy a.
+ * Only the range of buckets between the lowest and highest value is kept (value 0 has
+ * bucket -1). Sketches with the same relative accuracy can be merged by adding up buckets.
+ */
+class LatencySketch
+{
+public:
+    static const double DEFAULT_RELATIVE_ACCURACY;
+    LatencySketch();
+    LatencySketch(double relative_accuracy);
+    void Add(int64_t value);
+    void Merge(const LatencySketch& other);
+    double GetRelativeAccuracy() const;
+    int64_t GetCount() const;
+    int64_t GetQuantile(double q) const;
+    std::vector<std::pair<int32_t, uint64_t>> GetBuckets() const;
+    int64_t GetBucketValue(int32_t bucket) const;
+    void WriteToFile(const std::string& filename) const;
+
+private:
+    int32_t CalculateBucket(int64_t value) const;
+    void EnsureBucket(int32_t bucket);
+    double m_relative_accuracy;
+    double m_gamma;
+    double m_log_gamma;
+    int64_t m_count;
+    int64_t m_min;
+    int64_t m_max;
+    int32_t m_bucket_offset;        // Bucket of m_bucket_counts[0]
+    std::vector<uint64_t> m_bucket_counts;
+};
+
+}
+
+#endif /* LATENCY_SKETCH_H */
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/log-output-sink-binary.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LogOutputSinkBinary);
+TypeId LogOutputSinkBinary::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::LogOutputSinkBinary")
+            .SetParent<LogOutputSink> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+LogOutputSinkBinary::LogOutputSinkBinary(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns)
+        : LogOutputSink(writer, filename, columns) {
+    EmitBinaryHeader("BSLB");
+    m_record.reserve(8 * m_columns.size());
+}
+
+void LogOutputSinkBinary::WriteRecord(const int64_t* values) {
+    m_record.clear();
+    for (size_t i = 0; i < m_columns.size(); i++) {
+        AppendInt64LittleEndian(m_record, values[i]);
+    }
+    Emit(m_record.data(), m_record.size());
+    m_num_records++;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/log-output-sink-columnar.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LogOutputSinkColumnar);
+TypeId LogOutputSinkColumnar::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::LogOutputSinkColumnar")
+            .SetParent<LogOutputSink> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+LogOutputSinkColumnar::LogOutputSinkColumnar(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns)
+        : LogOutputSinkColumnar(writer, filename, columns, 4096) {
+    // Left empty intentionally
+}
+
+LogOutputSinkColumnar::LogOutputSinkColumnar(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns, int64_t chunk_num_rows)
+        : LogOutputSink(writer, filename, columns) {
+    if (chunk_num_rows < 1) {
+        throw std::invalid_argument(format_string("Number of rows in a chunk must be at least 1 (given: %" PRId64 ")", chunk_num_rows));
+    }
+    m_chunk_num_rows = chunk_num_rows;
+    m_chunk_columns.resize(m_columns.size());
+    for (std::vector<int64_t>& column : m_chunk_columns) {
+        column.reserve(m_chunk_num_rows);
+    }
+    EmitBinaryHeader("BSLC");
+}
+
+LogOutputSinkColumnar::~LogOutputSinkColumnar() {
+    // The base class destructor can no longer reach DoClose() of this class
+    try {
+        Close();
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl; // Destructors are not allowed to throw
+    }
+}
+
+void LogOutputSinkColumnar::WriteRecord(const int64_t* values) {
+    for (size_t i = 0; i < m_columns.size(); i++) {
+        m_chunk_columns[i].push_back(values[i]);
+    }
+    m_num_records++;
+    if ((int64_t) m_chunk_columns[0].size() == m_chunk_num_rows) {
+        EmitChunk();
+    }
+}
+
+void LogOutputSinkColumnar::EmitChunk() {
+    m_chunk.clear();
+    AppendUint32LittleEndian(m_chunk, (uint32_t) m_chunk_columns[0].size());
+    for (std::vector<int64_t>& column : m_chunk_columns) {
+        for (int64_t value : column) {
+            AppendInt64LittleEndian(m_chunk, value);
+        }
+        column.clear();
+    }
+    Emit(m_chunk.data(), m_chunk.size());
+}
+
+void LogOutputSinkColumnar::DoClose() {
+    if (!m_chunk_columns[0].empty()) {
+        EmitChunk();
+    }
+}
+
+int64_t LogOutputSinkColumnar::GetChunkNumRows() {
+    return m_chunk_num_rows;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef LOG_OUTPUT_SINK_COLUMNAR_H
+#define LOG_OUTPUT_SINK_COLUMNAR_H
+
+#include "ns3/log-output-sink.h"
+
+namespace ns3 {
+
+/**
+ * Writes the binary header (magic "BSLC") followed by chunks of at most a fixed number of rows.
+ * Each chunk is <number of rows (uint32)> followed by, column after column, the values of
+ * that column for all rows in the chunk as little-endian int64. A post-processing step which
+ * only needs some of the columns can as such skip over the others.
+ */
+class LogOutputSinkColumnar : public LogOutputSink
+{
+public:
+    static TypeId GetTypeId (void);
+    LogOutputSinkColumnar(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns);
+    LogOutputSinkColumnar(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns, int64_t chunk_num_rows);
+    virtual ~LogOutputSinkColumnar();
+    void WriteRecord(const int64_t* values);
+    int64_t GetChunkNumRows();
+
+protected:
+    void DoClose();
+
+private:
+    void EmitChunk();
+
+    int64_t m_chunk_num_rows;
+    std::vector<std::vector<int64_t>> m_chunk_columns;
+    std::string m_chunk;
+};
+
+}
+
+#endif //LOG_OUTPUT_SINK_COLUMNAR_H
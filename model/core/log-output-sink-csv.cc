@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/log-output-sink-csv.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LogOutputSinkCsv);
+TypeId LogOutputSinkCsv::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::LogOutputSinkCsv")
+            .SetParent<LogOutputSink> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+LogOutputSinkCsv::LogOutputSinkCsv(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns)
+        : LogOutputSink(writer, filename, columns) {
+    // Left empty intentionally
+}
+
+void LogOutputSinkCsv::WriteRecord(const int64_t* values) {
+    char line[32];
+    for (size_t i = 0; i < m_columns.size(); i++) {
+
+        // Integer is written back to front
+        char* end = line + sizeof(line);
+        char* p = end;
+        *(--p) = (i + 1 == m_columns.size() ? '\n' : ',');
+        uint64_t magnitude = values[i] < 0 ? -((uint64_t) values[i]) : (uint64_t) values[i];
+        do {
+            *(--p) = (char) ('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (values[i] < 0) {
+            *(--p) = '-';
+        }
+        Emit(p, end - p);
+
+    }
+    m_num_records++;
+}
+
+}
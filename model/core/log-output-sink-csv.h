@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef LOG_OUTPUT_SINK_CSV_H
+#define LOG_OUTPUT_SINK_CSV_H
+
+#include "ns3/log-output-sink.h"
+
+namespace ns3 {
+
+/**
+ * Writes every record as a comma-separated line, without a header line.
+ * This is byte-for-byte the same as what the loggers have always written.
+ */
+class LogOutputSinkCsv : public LogOutputSink
+{
+public:
+    static TypeId GetTypeId (void);
+    LogOutputSinkCsv(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns);
+    void WriteRecord(const int64_t* values);
+};
+
+}
+
+#endif //LOG_OUTPUT_SINK_CSV_H
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "ns3/log-output-sink.h"
+#include "ns3/log-output-sink-csv.h"
+#include "ns3/log-output-sink-binary.h"
+#include "ns3/log-output-sink-columnar.h"
+
+namespace ns3 {
+
+/**
+ * Parse the log output format.
+ *
+ * @param str   Format string ("csv", "binary" or "columnar")
+ *
+ * @return Log output format
+ */
+LogOutputFormat parse_log_output_format(const std::string& str) {
+    if (str == "csv") {
+        return LOG_OUTPUT_FORMAT_CSV;
+    } else if (str == "binary") {
+        return LOG_OUTPUT_FORMAT_BINARY;
+    } else if (str == "columnar") {
+        return LOG_OUTPUT_FORMAT_COLUMNAR;
+    } else {
+        throw std::invalid_argument("Invalid log output format (must be csv, binary or columnar): " + str);
+    }
+}
+
+/**
+ * Determine the filename of a log in a certain output format, by replacing the .csv extension
+ * (or appending if it is not present) with the one of the format.
+ *
+ * @param csv_filename  Filename the log would have as CSV
+ * @param format        Log output format
+ *
+ * @return Filename of the log in the output format
+ */
+std::string get_log_output_filename(const std::string& csv_filename, LogOutputFormat format) {
+    if (format == LOG_OUTPUT_FORMAT_CSV) {
+        return csv_filename;
+    }
+    std::string base = csv_filename;
+    if (ends_with(base, ".csv")) {
+        base = base.substr(0, base.size() - 4);
+    }
+    return base + (format == LOG_OUTPUT_FORMAT_BINARY ? ".bin" : ".col");
+}
+
+NS_OBJECT_ENSURE_REGISTERED (LogOutputSink);
+TypeId LogOutputSink::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::LogOutputSink")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+LogOutputSink::LogOutputSink(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns) {
+    if (columns.empty()) {
+        throw std::invalid_argument("A log output sink must have at least one column: " + filename);
+    }
+    m_columns = columns;
+    m_num_records = 0;
+    m_filename = filename;
+    m_own_writer = writer == 0;
+    m_writer = m_own_writer ? CreateObject<AsyncLogWriter>(65536) : writer;
+    m_file_handle = m_writer->Open(filename, false);
+    m_closed = false;
+}
+
+LogOutputSink::~LogOutputSink() {
+    try {
+        Close();
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl; // Destructors are not allowed to throw
+    }
+}
+
+/**
+ * Write out whatever the format still holds back. If the sink has its own writer, it is
+ * closed as well, such that the log is complete on disk afterwards. If the writer is shared,
+ * only the file of the sink is closed in it (it is complete on disk once the writer is flushed).
+ */
+void LogOutputSink::Close() {
+    if (m_closed) {
+        return;
+    }
+    DoClose();
+    m_closed = true;
+    if (m_own_writer) {
+        m_writer->Close();
+    } else {
+        m_writer->CloseFile(m_file_handle);
+    }
+    m_writer = 0;
+}
+
+void LogOutputSink::DoClose() {
+    // Left empty intentionally
+}
+
+void LogOutputSink::Emit(const char* data, size_t length) {
+    if (m_closed) {
+        throw std::runtime_error("Cannot write to a log output sink which is closed: " + m_filename);
+    }
+    m_writer->Write(m_file_handle, data, length);
+}
+
+/**
+ * Write the header shared by the binary formats:
+ * <magic (4 byte)><version (uint32)><number of columns (uint32)>
+ * followed for every column by <name length (uint32)><name>.
+ * All integers are little-endian.
+ *
+ * @param magic     Four characters identifying the format
+ */
+void LogOutputSink::EmitBinaryHeader(const char* magic) {
+    std::string header(magic, 4);
+    AppendUint32LittleEndian(header, 1);
+    AppendUint32LittleEndian(header, (uint32_t) m_columns.size());
+    for (const std::string& column : m_columns) {
+        AppendUint32LittleEndian(header, (uint32_t) column.size());
+        header += column;
+    }
+    Emit(header.data(), header.size());
+}
+
+void LogOutputSink::AppendUint32LittleEndian(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back((char) ((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void LogOutputSink::AppendInt64LittleEndian(std::string& out, int64_t value) {
+    uint64_t v = (uint64_t) value;
+    for (int i = 0; i < 8; i++) {
+        out.push_back((char) ((v >> (8 * i)) & 0xFF));
+    }
+}
+
+const std::string& LogOutputSink::GetFilename() {
+    return m_filename;
+}
+
+const std::vector<std::string>& LogOutputSink::GetColumns() {
+    return m_columns;
+}
+
+int64_t LogOutputSink::GetNumRecords() {
+    return m_num_records;
+}
+
+/**
+ * Create a log output sink of a certain format.
+ *
+ * @param format        Log output format
+ * @param writer        Asynchronous log writer to write with (0 to let the sink create its own)
+ * @param csv_filename  Filename the log would have as CSV (the extension is adapted to the format)
+ * @param columns       Column names
+ *
+ * @return Log output sink
+ */
+Ptr<LogOutputSink> CreateLogOutputSink(
+        LogOutputFormat format,
+        Ptr<AsyncLogWriter> writer,
+        const std::string& csv_filename,
+        const std::vector<std::string>& columns
+) {
+    std::string filename = get_log_output_filename(csv_filename, format);
+    switch (format) {
+        case LOG_OUTPUT_FORMAT_CSV:
+            return CreateObject<LogOutputSinkCsv>(writer, filename, columns);
+        case LOG_OUTPUT_FORMAT_BINARY:
+            return CreateObject<LogOutputSinkBinary>(writer, filename, columns);
+        case LOG_OUTPUT_FORMAT_COLUMNAR:
+            return CreateObject<LogOutputSinkColumnar>(writer, filename, columns);
+    }
+    throw std::invalid_argument("Unknown log output format");
+}
+
+}
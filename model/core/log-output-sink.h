@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef LOG_OUTPUT_SINK_H
+#define LOG_OUTPUT_SINK_H
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+#include "ns3/async-log-writer.h"
+
+namespace ns3 {
+
+/**
+ * Format in which integer log records are written out:
+ *
+ * - LOG_OUTPUT_FORMAT_CSV      : Plain-text comma-separated lines (".csv")
+ * - LOG_OUTPUT_FORMAT_BINARY   : Header followed by fixed-width little-endian int64 records (".bin")
+ * - LOG_OUTPUT_FORMAT_COLUMNAR : Header followed by chunks, each storing its rows column after column (".col")
+ */
+enum LogOutputFormat {
+    LOG_OUTPUT_FORMAT_CSV,
+    LOG_OUTPUT_FORMAT_BINARY,
+    LOG_OUTPUT_FORMAT_COLUMNAR
+};
+
+LogOutputFormat parse_log_output_format(const std::string& str);
+std::string get_log_output_filename(const std::string& csv_filename, LogOutputFormat format);
+
+/**
+ * Sink for a log of which every record consists of a fixed number of integer columns.
+ * The sink encodes the records in its format and writes them via an asynchronous log writer.
+ * If no writer is given, it creates one for itself, which is closed together with the sink.
+ * If a writer is shared, closing the sink closes its file in the writer, and it is the
+ * responsibility of the owner of the writer to flush and close it after the sink has been closed.
+ */
+class LogOutputSink : public Object
+{
+public:
+    static TypeId GetTypeId (void);
+    LogOutputSink(Ptr<AsyncLogWriter> writer, const std::string& filename, const std::vector<std::string>& columns);
+    virtual ~LogOutputSink();
+
+    virtual void WriteRecord(const int64_t* values) = 0;
+    void Close();
+
+    const std::string& GetFilename();
+    const std::vector<std::string>& GetColumns();
+    int64_t GetNumRecords();
+
+protected:
+    virtual void DoClose();
+    void Emit(const char* data, size_t length);
+    void EmitBinaryHeader(const char* magic);
+    static void AppendUint32LittleEndian(std::string& out, uint32_t value);
+    static void AppendInt64LittleEndian(std::string& out, int64_t value);
+
+    std::vector<std::string> m_columns;
+    int64_t m_num_records;
+
+private:
+    Ptr<AsyncLogWriter> m_writer;
+    bool m_own_writer;
+    int64_t m_file_handle;
+    std::string m_filename;
+    bool m_closed;
+};
+
+Ptr<LogOutputSink> CreateLogOutputSink(
+        LogOutputFormat format,
+        Ptr<AsyncLogWriter> writer,
+        const std::string& csv_filename,
+        const std::vector<std::string>& columns
+);
+
+}
+
+#endif //LOG_OUTPUT_SINK_H
@@ -26,6 +26,21 @@
 #include <fstream>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
+#include "ns3/log-output-sink.h"
+#include "ns3/interval-log-spill.h"
+
+// Values are written to a log output sink (or spilled) as integer, which is only possible for integer
+// types: the constructors with a sink or spill do not compile for other value types, as such the
+// overload for those is never called
+template <class V>
+inline int64_t log_update_helper_sink_value(const V& value, std::true_type) {
+    return (int64_t) value;
+}
+template <class V>
+inline int64_t log_update_helper_sink_value(const V&, std::false_type) {
+    return 0;
+}
 
 template <class V>
 class LogUpdateHelper {
@@ -33,10 +48,17 @@ class LogUpdateHelper {
 public:
     LogUpdateHelper();
     LogUpdateHelper(bool save_in_memory, bool save_to_file, std::string save_filename, std::string file_line_prefix);
+    LogUpdateHelper(bool save_in_memory, ns3::Ptr<ns3::LogOutputSink> save_sink, std::vector<int64_t> sink_record_prefix);
+    LogUpdateHelper(ns3::Ptr<ns3::IntervalLogSpill> spill, int64_t max_intervals_in_memory);
     void Update(int64_t time, V value);
     const std::vector<std::tuple<int64_t, int64_t, V>>& Finalize(int64_t time);
+    int64_t GetSpillStreamId();
+    int64_t GetNumIntervalsInMemory();
 
 private:
+    void SaveToMemory(int64_t start_time, int64_t end_time, const V& value);
+    void SaveToFile(int64_t time, const V& value);
+
     std::vector<std::tuple<int64_t, int64_t, V>> m_log_time_value;
     V m_last_update_value;
     V m_interval_alpha_value;
@@ -49,6 +71,14 @@ private:
     std::string m_save_filename;
     std::string m_file_line_prefix;
     std::fstream m_save_file_stream;
+    ns3::Ptr<ns3::LogOutputSink> m_save_sink;
+    std::vector<int64_t> m_sink_record;
+
+    // Streaming: finalized intervals are spilled in blocks, bounding the intervals in memory
+    ns3::Ptr<ns3::IntervalLogSpill> m_spill;
+    int64_t m_spill_stream_id;
+    int64_t m_max_intervals_in_memory;
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> m_spill_block;
 };
 
 template <class V>
@@ -65,6 +95,8 @@ LogUpdateHelper<V>::LogUpdateHelper(bool save_in_memory, bool save_to_file, std:
     m_save_to_file = save_to_file;
     m_save_filename = save_filename;
     m_file_line_prefix = file_line_prefix;
+    m_spill_stream_id = -1;
+    m_max_intervals_in_memory = -1;
     if (m_save_to_file) {
         m_save_file_stream.open(m_save_filename, std::fstream::out);
     }
@@ -75,6 +107,75 @@ LogUpdateHelper<V>::LogUpdateHelper() : LogUpdateHelper(true, false, "", "") {
     // Left empty intentionally
 }
 
+template <class V>
+LogUpdateHelper<V>::LogUpdateHelper(bool save_in_memory, ns3::Ptr<ns3::LogOutputSink> save_sink, std::vector<int64_t> sink_record_prefix)
+        : LogUpdateHelper(true, false, "", "") {
+    static_assert(std::is_integral<V>::value, "Only integer values can be written to a log output sink.");
+    if (sink_record_prefix.size() + 2 != save_sink->GetColumns().size()) {
+        throw std::invalid_argument("Log output sink must have two columns (time, value) besides the record prefix.");
+    }
+    m_save_in_memory = save_in_memory;
+    m_save_to_file = true;
+    m_save_sink = save_sink;
+    m_sink_record = sink_record_prefix;
+    m_sink_record.resize(sink_record_prefix.size() + 2);
+}
+
+/**
+ * Streaming mode: the finalized intervals are kept in memory until there are max_intervals_in_memory
+ * of them, after which they are spilled as a block to the spill file. Finalize() spills the
+ * remainder and returns an empty log; the intervals can be read back in order from the spill file.
+ *
+ * @param spill                     Interval log spill file (a stream is added for this log)
+ * @param max_intervals_in_memory   Maximum number of finalized intervals kept in memory (at least 1)
+ */
+template <class V>
+LogUpdateHelper<V>::LogUpdateHelper(ns3::Ptr<ns3::IntervalLogSpill> spill, int64_t max_intervals_in_memory)
+        : LogUpdateHelper(true, false, "", "") {
+    static_assert(std::is_integral<V>::value, "Only integer values can be spilled.");
+    if (max_intervals_in_memory < 1) {
+        throw std::invalid_argument("Maximum number of intervals in memory must be at least 1.");
+    }
+    m_spill = spill;
+    m_spill_stream_id = spill->AddStream();
+    m_max_intervals_in_memory = max_intervals_in_memory;
+    m_spill_block.reserve(max_intervals_in_memory);
+}
+
+template <class V>
+void LogUpdateHelper<V>::SaveToMemory(int64_t start_time, int64_t end_time, const V& value) {
+    if (m_spill != 0) {
+        m_spill_block.push_back(std::make_tuple(start_time, end_time, log_update_helper_sink_value(value, std::is_integral<V>())));
+        if ((int64_t) m_spill_block.size() >= m_max_intervals_in_memory) {
+            m_spill->Spill(m_spill_stream_id, m_spill_block);
+            m_spill_block.clear();
+        }
+    } else {
+        m_log_time_value.push_back(std::make_tuple(start_time, end_time, value));
+    }
+}
+
+template <class V>
+int64_t LogUpdateHelper<V>::GetSpillStreamId() {
+    return m_spill_stream_id;
+}
+
+template <class V>
+int64_t LogUpdateHelper<V>::GetNumIntervalsInMemory() {
+    return m_spill != 0 ? (int64_t) m_spill_block.size() : (int64_t) m_log_time_value.size();
+}
+
+template <class V>
+void LogUpdateHelper<V>::SaveToFile(int64_t time, const V& value) {
+    if (m_save_sink != 0) {
+        m_sink_record[m_sink_record.size() - 2] = time;
+        m_sink_record[m_sink_record.size() - 1] = log_update_helper_sink_value(value, std::is_integral<V>());
+        m_save_sink->WriteRecord(m_sink_record.data());
+    } else {
+        m_save_file_stream << m_file_line_prefix << time << "," << value << std::endl;
+    }
+}
+
 template <class V>
 void LogUpdateHelper<V>::Update(int64_t time, V value) {
 
@@ -116,10 +217,10 @@ void LogUpdateHelper<V>::Update(int64_t time, V value) {
 
                     // Save the alpha interval
                     if (m_save_in_memory) {
-                        m_log_time_value.push_back(std::make_tuple(m_interval_alpha_left_time, m_interval_beta_left_time, m_interval_alpha_value));
+                        SaveToMemory(m_interval_alpha_left_time, m_interval_beta_left_time, m_interval_alpha_value);
                     }
                     if (m_save_to_file) {
-                        m_save_file_stream << m_file_line_prefix << m_interval_alpha_left_time << "," << m_interval_alpha_value << std::endl;
+                        SaveToFile(m_interval_alpha_left_time, m_interval_alpha_value);
                     }
 
                     // And make beta interval become alpha
@@ -160,11 +261,11 @@ const std::vector<std::tuple<int64_t, int64_t, V>>& LogUpdateHelper<V>::Finalize
     if (m_interval_alpha_left_time != -1 && m_interval_beta_left_time == -1) {
         if (m_interval_alpha_left_time != time) {
             if (m_save_in_memory) {
-                m_log_time_value.push_back(std::make_tuple(m_interval_alpha_left_time, time, m_last_update_value));
+                SaveToMemory(m_interval_alpha_left_time, time, m_last_update_value);
             }
             if (m_save_to_file) {
-                m_save_file_stream << m_file_line_prefix << m_interval_alpha_left_time << "," << m_last_update_value << std::endl;
-                m_save_file_stream << m_file_line_prefix << time << "," << m_last_update_value << std::endl;
+                SaveToFile(m_interval_alpha_left_time, m_last_update_value);
+                SaveToFile(time, m_last_update_value);
             }
         }
 
@@ -174,44 +275,54 @@ const std::vector<std::tuple<int64_t, int64_t, V>>& LogUpdateHelper<V>::Finalize
         // If the last two intervals can be merged
         if (m_interval_alpha_value == m_last_update_value) {
             if (m_save_in_memory) {
-                m_log_time_value.push_back(std::make_tuple(m_interval_alpha_left_time, time, m_interval_alpha_value));
+                SaveToMemory(m_interval_alpha_left_time, time, m_interval_alpha_value);
             }
             if (m_save_to_file) {
-                m_save_file_stream << m_file_line_prefix << m_interval_alpha_left_time << "," << m_interval_alpha_value << std::endl;
-                m_save_file_stream << m_file_line_prefix << time << "," << m_interval_alpha_value << std::endl;
+                SaveToFile(m_interval_alpha_left_time, m_interval_alpha_value);
+                SaveToFile(time, m_interval_alpha_value);
             }
 
             // If the last two intervals have different values, save separately
         } else {
             if (m_save_in_memory) {
-                m_log_time_value.push_back(std::make_tuple(m_interval_alpha_left_time, m_interval_beta_left_time, m_interval_alpha_value));
+                SaveToMemory(m_interval_alpha_left_time, m_interval_beta_left_time, m_interval_alpha_value);
             }
             if (m_save_to_file) {
-                m_save_file_stream << m_file_line_prefix << m_interval_alpha_left_time << "," << m_interval_alpha_value << std::endl;
+                SaveToFile(m_interval_alpha_left_time, m_interval_alpha_value);
             }
             if (m_interval_beta_left_time != time) {
                 if (m_save_in_memory) {
-                    m_log_time_value.push_back(std::make_tuple(m_interval_beta_left_time, time, m_last_update_value));
+                    SaveToMemory(m_interval_beta_left_time, time, m_last_update_value);
                 }
                 if (m_save_to_file) {
-                    m_save_file_stream << m_file_line_prefix << m_interval_beta_left_time << "," << m_last_update_value << std::endl;
-                    m_save_file_stream << m_file_line_prefix << time << "," << m_last_update_value << std::endl;
+                    SaveToFile(m_interval_beta_left_time, m_last_update_value);
+                    SaveToFile(time, m_last_update_value);
                 }
             } else {
                 if (m_save_to_file) {
-                    m_save_file_stream << m_file_line_prefix << m_interval_beta_left_time << "," << m_interval_alpha_value << std::endl;
+                    SaveToFile(m_interval_beta_left_time, m_interval_alpha_value);
                 }
             }
         }
 
     }
 
-    // Close to save file stream if it was opened
+    // Close to save file stream or sink if it was opened
     if (m_save_to_file) {
-        m_save_file_stream.close();
+        if (m_save_sink != 0) {
+            m_save_sink->Close();
+        } else {
+            m_save_file_stream.close();
+        }
+    }
+
+    // Spill the remainder of the intervals
+    if (m_spill != 0) {
+        m_spill->Spill(m_spill_stream_id, m_spill_block);
+        m_spill_block.clear();
     }
 
-    // Return final resulting log, which will be empty if save in memory is not enabled
+    // Return final resulting log, which will be empty if save in memory is not enabled or in streaming mode
     return m_log_time_value;
 }
 
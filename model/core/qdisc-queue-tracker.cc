@@ -37,16 +37,32 @@ namespace ns3 {
         // Register this tracker into the tracing callbacks of the root queueing discipline
         m_qdisc = qdisc;
 
-        // Logging number of packets in the qdisc
+        // Logging number of packets and bytes in the qdisc
         m_log_update_helper_qdisc_pkt = LogUpdateHelper<int64_t>();
+        m_log_update_helper_qdisc_byte = LogUpdateHelper<int64_t>();
+        ConnectTraces();
+
+    }
+
+    QdiscQueueTracker::QdiscQueueTracker(Ptr<QueueDisc> qdisc, Ptr<IntervalLogSpill> spill, int64_t max_intervals_in_memory) {
+
+        // Register this tracker into the tracing callbacks of the root queueing discipline,
+        // streaming the finalized intervals to the spill file
+        m_qdisc = qdisc;
+        m_spill = spill;
+
+        // Logging number of packets and bytes in the qdisc
+        m_log_update_helper_qdisc_pkt = LogUpdateHelper<int64_t>(spill, max_intervals_in_memory);
+        m_log_update_helper_qdisc_byte = LogUpdateHelper<int64_t>(spill, max_intervals_in_memory);
+        ConnectTraces();
+
+    }
+
+    void QdiscQueueTracker::ConnectTraces() {
         m_log_update_helper_qdisc_pkt.Update(0, 0);
         m_qdisc->TraceConnectWithoutContext("PacketsInQueue", MakeCallback(&QdiscQueueTracker::QueueDiscPacketsInQueueCallback, this));
-        
-        // Logging bytes in the qdisc
-        m_log_update_helper_qdisc_byte = LogUpdateHelper<int64_t>();
         m_log_update_helper_qdisc_byte.Update(0, 0);
         m_qdisc->TraceConnectWithoutContext("BytesInQueue", MakeCallback(&QdiscQueueTracker::QueueDiscBytesInQueueCallback, this));
-
     }
 
     void QdiscQueueTracker::QueueDiscPacketsInQueueCallback(uint32_t, uint32_t num_packets) {
@@ -71,4 +87,29 @@ namespace ns3 {
         return m_log_update_helper_qdisc_byte.Finalize((int64_t) Simulator::Now().GetNanoSeconds());
     }
 
+    void QdiscQueueTracker::WriteIntervalsNumPackets(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        WriteIntervals(m_log_update_helper_qdisc_pkt, sink, record_prefix);
+    }
+
+    void QdiscQueueTracker::WriteIntervalsNumBytes(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        WriteIntervals(m_log_update_helper_qdisc_byte, sink, record_prefix);
+    }
+
+    // Finalize the log and write each interval as record <record prefix>,<start>,<end>,<value>
+    void QdiscQueueTracker::WriteIntervals(LogUpdateHelper<int64_t>& log_update_helper, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        const std::vector<std::tuple<int64_t, int64_t, int64_t>>& log_entries = log_update_helper.Finalize((int64_t) Simulator::Now().GetNanoSeconds());
+        if (m_spill != 0) {
+            m_spill->WriteStream(log_update_helper.GetSpillStreamId(), sink, record_prefix);
+        } else {
+            std::vector<int64_t> record = record_prefix;
+            record.resize(record_prefix.size() + 3);
+            for (const std::tuple<int64_t, int64_t, int64_t>& entry : log_entries) {
+                record[record_prefix.size()] = std::get<0>(entry);
+                record[record_prefix.size() + 1] = std::get<1>(entry);
+                record[record_prefix.size() + 2] = std::get<2>(entry);
+                sink->WriteRecord(record.data());
+            }
+        }
+    }
+
 }
@@ -29,6 +29,8 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/queue-disc.h"
 #include "ns3/log-update-helper.h"
+#include "ns3/interval-log-spill.h"
+#include "ns3/log-output-sink.h"
 
 
 namespace ns3 {
@@ -38,15 +40,21 @@ namespace ns3 {
     public:
         static TypeId GetTypeId (void);
         QdiscQueueTracker(Ptr<QueueDisc> qdisc);
+        QdiscQueueTracker(Ptr<QueueDisc> qdisc, Ptr<IntervalLogSpill> spill, int64_t max_intervals_in_memory);
         void QueueDiscPacketsInQueueCallback(uint32_t, uint32_t num_packets);
         void QueueDiscBytesInQueueCallback(uint32_t, uint32_t num_bytes);
         const std::vector<std::tuple<int64_t, int64_t, int64_t>>& GetIntervalsNumPackets();
         const std::vector<std::tuple<int64_t, int64_t, int64_t>>& GetIntervalsNumBytes();
+        void WriteIntervalsNumPackets(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
+        void WriteIntervalsNumBytes(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
 
     private:
+        void ConnectTraces();
+        void WriteIntervals(LogUpdateHelper<int64_t>& log_update_helper, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
 
         // Parameters
         Ptr<QueueDisc> m_qdisc;
+        Ptr<IntervalLogSpill> m_spill; // Only set if streaming (else: 0)
 
         // State
         LogUpdateHelper<int64_t> m_log_update_helper_qdisc_pkt;
@@ -38,16 +38,33 @@ namespace ns3 {
         // Save queue pointer
         m_queue = queue;
 
-        // Logging number of packets in the queue
+        // Logging number of packets and bytes in the queue
         m_log_update_helper_queue_pkt = LogUpdateHelper<int64_t>();
+        m_log_update_helper_queue_byte = LogUpdateHelper<int64_t>();
+        ConnectTraces();
+
+    }
+
+    // Register this tracker into the tracing callbacks of the queue, streaming the finalized
+    // intervals to the spill file such that at most max_intervals_in_memory per log are in memory
+    QueueTracker::QueueTracker(Ptr<Queue<Packet>> queue, Ptr<IntervalLogSpill> spill, int64_t max_intervals_in_memory) {
+
+        // Save queue and spill pointer
+        m_queue = queue;
+        m_spill = spill;
+
+        // Logging number of packets and bytes in the queue
+        m_log_update_helper_queue_pkt = LogUpdateHelper<int64_t>(spill, max_intervals_in_memory);
+        m_log_update_helper_queue_byte = LogUpdateHelper<int64_t>(spill, max_intervals_in_memory);
+        ConnectTraces();
+
+    }
+
+    void QueueTracker::ConnectTraces() {
         m_log_update_helper_queue_pkt.Update(0, 0);
         m_queue->TraceConnectWithoutContext("PacketsInQueue", MakeCallback(&QueueTracker::PacketsInQueueCallback, this));
-        
-        // Logging bytes in the queue
-        m_log_update_helper_queue_byte = LogUpdateHelper<int64_t>();
         m_log_update_helper_queue_byte.Update(0, 0);
         m_queue->TraceConnectWithoutContext("BytesInQueue", MakeCallback(&QueueTracker::BytesInQueueCallback, this));
-
     }
 
     void QueueTracker::PacketsInQueueCallback(uint32_t, uint32_t num_packets) {
@@ -72,4 +89,29 @@ namespace ns3 {
         return m_log_update_helper_queue_byte.Finalize((int64_t) Simulator::Now().GetNanoSeconds());
     }
 
+    void QueueTracker::WriteIntervalsNumPackets(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        WriteIntervals(m_log_update_helper_queue_pkt, sink, record_prefix);
+    }
+
+    void QueueTracker::WriteIntervalsNumBytes(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        WriteIntervals(m_log_update_helper_queue_byte, sink, record_prefix);
+    }
+
+    // Finalize the log and write each interval as record <record prefix>,<start>,<end>,<value>
+    void QueueTracker::WriteIntervals(LogUpdateHelper<int64_t>& log_update_helper, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix) {
+        const std::vector<std::tuple<int64_t, int64_t, int64_t>>& log_entries = log_update_helper.Finalize((int64_t) Simulator::Now().GetNanoSeconds());
+        if (m_spill != 0) {
+            m_spill->WriteStream(log_update_helper.GetSpillStreamId(), sink, record_prefix);
+        } else {
+            std::vector<int64_t> record = record_prefix;
+            record.resize(record_prefix.size() + 3);
+            for (const std::tuple<int64_t, int64_t, int64_t>& entry : log_entries) {
+                record[record_prefix.size()] = std::get<0>(entry);
+                record[record_prefix.size() + 1] = std::get<1>(entry);
+                record[record_prefix.size() + 2] = std::get<2>(entry);
+                sink->WriteRecord(record.data());
+            }
+        }
+    }
+
 }
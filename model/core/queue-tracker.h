@@ -26,6 +26,8 @@
 
 #include "ns3/network-module.h"
 #include "ns3/log-update-helper.h"
+#include "ns3/interval-log-spill.h"
+#include "ns3/log-output-sink.h"
 
 
 namespace ns3 {
@@ -35,15 +37,21 @@ namespace ns3 {
     public:
         static TypeId GetTypeId (void);
         QueueTracker(Ptr<Queue<Packet>> queue);
+        QueueTracker(Ptr<Queue<Packet>> queue, Ptr<IntervalLogSpill> spill, int64_t max_intervals_in_memory);
         void PacketsInQueueCallback(uint32_t, uint32_t num_packets);
         void BytesInQueueCallback(uint32_t, uint32_t num_bytes);
         const std::vector<std::tuple<int64_t, int64_t, int64_t>>& GetIntervalsNumPackets();
         const std::vector<std::tuple<int64_t, int64_t, int64_t>>& GetIntervalsNumBytes();
+        void WriteIntervalsNumPackets(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
+        void WriteIntervalsNumBytes(Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
 
     private:
+        void ConnectTraces();
+        void WriteIntervals(LogUpdateHelper<int64_t>& log_update_helper, Ptr<LogOutputSink> sink, const std::vector<int64_t>& record_prefix);
 
         // Parameters
         Ptr<Queue<Packet>> m_queue;
+        Ptr<IntervalLogSpill> m_spill; // Only set if streaming (else: 0)
 
         // State
         LogUpdateHelper<int64_t> m_log_update_helper_queue_pkt;
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#include "running-statistics.h"
+
+namespace ns3 {
+
+RunningStatistics::RunningStatistics() {
+    m_count = 0;
+    m_min = -1;
+    m_max = -1;
+    m_mean = 0.0;
+    m_sum_sq_diff = 0.0;
+}
+
+/**
+ * Add a value.
+ *
+ * @param value     Value
+ */
+void RunningStatistics::Add(int64_t value) {
+    if (m_count == 0) {
+        m_min = value;
+        m_max = value;
+    } else {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+    double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_sum_sq_diff += delta * (value - m_mean);
+}
+
+/**
+ * Merge the statistics of another stream into these, such that they are
+ * as if all the values of both streams had been added here.
+ *
+ * @param other     Statistics of the other stream
+ */
+void RunningStatistics::Merge(const RunningStatistics& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+    int64_t count = m_count + other.m_count;
+    double delta = other.m_mean - m_mean;
+    m_mean += delta * other.m_count / count;
+    m_sum_sq_diff += other.m_sum_sq_diff + delta * delta * m_count * other.m_count / count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_count = count;
+}
+
+/**
+ * Retrieve the number of values added.
+ *
+ * @return Count
+ */
+int64_t RunningStatistics::GetCount() const {
+    return m_count;
+}
+
+/**
+ * Retrieve the minimum value.
+ *
+ * @return Minimum (-1 if no values were added)
+ */
+int64_t RunningStatistics::GetMin() const {
+    return m_min;
+}
+
+/**
+ * Retrieve the maximum value.
+ *
+ * @return Maximum (-1 if no values were added)
+ */
+int64_t RunningStatistics::GetMax() const {
+    return m_max;
+}
+
+/**
+ * Retrieve the mean.
+ *
+ * @return Mean (-1 if no values were added)
+ */
+double RunningStatistics::GetMean() const {
+    return m_count == 0 ? -1 : m_mean;
+}
+
+/**
+ * Retrieve the sample standard deviation.
+ *
+ * @return Sample standard deviation (0 if one value was added, -1 if none)
+ */
+double RunningStatistics::GetSampleStd() const {
+    if (m_count == 0) {
+        return -1;
+    } else if (m_count == 1) {
+        return 0.0;
+    } else {
+        return std::sqrt(m_sum_sq_diff / (m_count - 1));
+    }
+}
+
+}
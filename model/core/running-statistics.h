@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon
+ */
+
+#ifndef RUNNING_STATISTICS_H
+#define RUNNING_STATISTICS_H
+
+#include <cinttypes>
+#include <cmath>
+#include <algorithm>
+
+namespace ns3 {
+
+/**
+ * Statistics of a stream of integer values (e.g., latencies in ns) which are
+ * updated for each value in constant time and space, without keeping the values:
+ * count, minimum, maximum, and mean and variance (Welford's online algorithm).
+ */
+class RunningStatistics
+{
+public:
+    RunningStatistics();
+    void Add(int64_t value);
+    void Merge(const RunningStatistics& other);
+    int64_t GetCount() const;
+    int64_t GetMin() const;
+    int64_t GetMax() const;
+    double GetMean() const;
+    double GetSampleStd() const;
+
+private:
+    int64_t m_count;
+    int64_t m_min;
+    int64_t m_max;
+    double m_mean;
+    double m_sum_sq_diff; // Sum of squared differences from the current mean
+};
+
+}
+
+#endif /* RUNNING_STATISTICS_H */
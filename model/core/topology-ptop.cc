@@ -84,6 +84,7 @@ TopologyPtop::TopologyPtop(
     ReadTopologyConfig();
     ParseTopologyGraph();
     ParseTopologyLinkProperties();
+    PartitionNodesToSystems();
     SetupNodes(ipv4RoutingHelper);
     SetupLinks();
 }
@@ -232,8 +233,8 @@ void TopologyPtop::ParseTopologyGraph() {
         m_has_zero_servers = true;
     }
 
-    // Check that each node has an assignment to a system id if it is distributed
-    if (m_basicSimulation->IsDistributedEnabled()) {
+    // Check that each node has an assignment to a system id if it is distributed (and not automatic)
+    if (m_basicSimulation->IsDistributedEnabled() && !m_basicSimulation->IsDistributedNodeSystemIdAssignmentAuto()) {
         size_t node_assignment_size = m_basicSimulation->GetDistributedNodeSystemIdAssignment().size();
         if (node_assignment_size != (size_t) m_num_nodes) {
             throw std::invalid_argument(
@@ -511,6 +512,67 @@ void TopologyPtop::ParseTopologyLinkProperties() {
     std::cout << std::endl;
 }
 
+/**
+ * Automatically partition the nodes to the systems if distributed and the node-to-system-id assignment is set to "auto".
+ *
+ * The partition maximizes the lookahead (the minimum delay of the links between systems), keeps the number
+ * of nodes per system balanced, and minimizes the weight of the links cut between systems. Because each
+ * system partitions the same topology deterministically, they all arrive at the same assignment.
+ */
+void TopologyPtop::PartitionNodesToSystems() {
+    if (!m_basicSimulation->IsDistributedEnabled() || !m_basicSimulation->IsDistributedNodeSystemIdAssignmentAuto()) {
+        return;
+    }
+    std::cout << "PARTITION NODES TO SYSTEMS" << std::endl;
+
+    // Edge weight
+    std::string edge_weight_type = m_basicSimulation->GetConfigParamOrDefault("distributed_partition_edge_weight", "data_rate");
+    if (edge_weight_type != "data_rate" && edge_weight_type != "unit") {
+        throw std::invalid_argument(format_string("Unknown partition edge weight: %s", edge_weight_type.c_str()));
+    }
+    printf("  > Edge weight............ %s\n", edge_weight_type.c_str());
+
+    // Maximum imbalance
+    double max_imbalance = parse_positive_double(m_basicSimulation->GetConfigParamOrDefault("distributed_partition_max_imbalance", "0.1"));
+    printf("  > Maximum imbalance...... %.2f\n", max_imbalance);
+
+    // Edge weights and delays
+    std::vector<double> edge_weights;
+    std::vector<int64_t> edge_delays_ns;
+    for (std::pair<int64_t, int64_t> undirected_edge : m_undirected_edges) {
+        if (edge_weight_type == "data_rate") {
+            edge_weights.push_back(
+                    m_link_net_device_data_rate_megabit_per_s_mapping.at(undirected_edge)
+                    + m_link_net_device_data_rate_megabit_per_s_mapping.at(std::make_pair(undirected_edge.second, undirected_edge.first))
+            );
+        } else {
+            edge_weights.push_back(1.0);
+        }
+        edge_delays_ns.push_back(m_link_channel_delay_ns_mapping.at(undirected_edge));
+    }
+
+    // Partition
+    std::vector<int64_t> assignment = partition_graph(
+            m_num_nodes,
+            m_undirected_edges,
+            edge_weights,
+            edge_delays_ns,
+            m_basicSimulation->GetSystemsCount(),
+            max_imbalance
+    );
+    int64_t lookahead_ns = calculate_partition_lookahead_ns(assignment, m_undirected_edges, edge_delays_ns);
+    if (lookahead_ns == -1) {
+        printf("  > Lookahead.............. none (no links between systems)\n");
+    } else {
+        printf("  > Lookahead.............. %" PRId64 " ns\n", lookahead_ns);
+    }
+    printf("  > Cut weight............. %.2f\n", calculate_partition_cut_weight(assignment, m_undirected_edges, edge_weights));
+    m_basicSimulation->SetDistributedNodeSystemIdAssignment(assignment);
+    std::cout << std::endl;
+    m_basicSimulation->RegisterTimestamp("Partition nodes to systems");
+
+}
+
 /**
  * Setup nodes by creating them if they are part of this system, and installing the internet stack including routing.
  *
@@ -553,6 +615,11 @@ void TopologyPtop::SetupLinks() {
     // Create Links
     std::cout << "  > Installing links" << std::endl;
     m_interface_idxs_for_undirected_edges.clear();
+    int64_t num_remote_channels = 0;
+    int64_t num_cross_system_links = 0;
+    int64_t num_cross_system_links_of_this_system = 0;
+    int64_t lookahead_ns = -1;
+    int64_t lookahead_of_this_system_ns = -1;
     for (std::pair<int64_t, int64_t> undirected_edge : m_undirected_edges) {
 
         // Retrieve all relevant details
@@ -611,10 +678,72 @@ void TopologyPtop::SetupLinks() {
         m_link_to_sending_net_device.insert(std::make_pair(link_a_to_b, netDeviceA));
         m_link_to_sending_net_device.insert(std::make_pair(link_b_to_a, netDeviceB));
 
+        // Links between systems determine the lookahead and carry the remote packets
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            num_remote_channels += p2p.GetNumRemoteChannelsInstalled();
+            const std::vector<int64_t>& assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
+            if (assignment.at(undirected_edge.first) != assignment.at(undirected_edge.second)) {
+                int64_t delay_ns = m_link_channel_delay_ns_mapping.at(undirected_edge);
+                num_cross_system_links++;
+                lookahead_ns = (lookahead_ns == -1 ? delay_ns : std::min(lookahead_ns, delay_ns));
+                bool a_is_local = m_basicSimulation->IsNodeAssignedToThisSystem(undirected_edge.first);
+                bool b_is_local = m_basicSimulation->IsNodeAssignedToThisSystem(undirected_edge.second);
+                if (a_is_local || b_is_local) {
+                    num_cross_system_links_of_this_system++;
+                    lookahead_of_this_system_ns = (lookahead_of_this_system_ns == -1 ? delay_ns : std::min(lookahead_of_this_system_ns, delay_ns));
+                    Ptr<PointToPointNetDevice> localNetDevice = a_is_local ? netDeviceA : netDeviceB;
+                    localNetDevice->TraceConnectWithoutContext("PhyTxBegin", MakeCallback(&TopologyPtop::RemotePacketSent, this));
+                    localNetDevice->TraceConnectWithoutContext("PhyRxEnd", MakeCallback(&TopologyPtop::RemotePacketReceived, this));
+                }
+            }
+        }
+
+    }
+
+    // Statistics to diagnose the partition
+    if (m_basicSimulation->IsDistributedEnabled()) {
+        int64_t num_nodes_of_this_system = 0;
+        for (int64_t node_id = 0; node_id < m_num_nodes; node_id++) {
+            num_nodes_of_this_system += m_basicSimulation->IsNodeAssignedToThisSystem(node_id) ? 1 : 0;
+        }
+        printf("  > Links between systems........... %" PRId64 " (of which %" PRId64 " of this system)\n", num_cross_system_links, num_cross_system_links_of_this_system);
+        printf("  > Remote channels created......... %" PRId64 "\n", num_remote_channels);
+        printf("  > Lookahead........................ %" PRId64 " ns (of this system: %" PRId64 " ns)\n", lookahead_ns, lookahead_of_this_system_ns);
+        m_basicSimulation->RegisterDistributedStatistic("Nodes of this system", num_nodes_of_this_system);
+        m_basicSimulation->RegisterDistributedStatistic("Links between systems", num_cross_system_links);
+        m_basicSimulation->RegisterDistributedStatistic("Links between systems of this system", num_cross_system_links_of_this_system);
+        m_basicSimulation->RegisterDistributedStatistic("Remote channels created", num_remote_channels);
+        m_basicSimulation->RegisterDistributedStatistic("Lookahead (ns)", lookahead_ns);
+        m_basicSimulation->RegisterDistributedStatistic("Lookahead of this system (ns)", lookahead_of_this_system_ns);
+        m_basicSimulation->RegisterDistributedStatistic("Remote packets sent", MakeCallback(&TopologyPtop::GetNumRemotePacketsSent, this));
+        m_basicSimulation->RegisterDistributedStatistic("Remote packets received", MakeCallback(&TopologyPtop::GetNumRemotePacketsReceived, this));
     }
 
-    std::cout << std::endl;
     m_basicSimulation->RegisterTimestamp("Create links and edge-to-interface-index mapping");
+
+    // IP address to node id index shared by all arbiters
+    std::cout << "  > Creating IP address to node id index" << std::endl;
+    m_ip_to_node_id_index = CreateObject<IpToNodeIdIndex>(m_nodes);
+    std::cout << "    >> Indexed IP addresses... " << m_ip_to_node_id_index->GetNumAddresses() << std::endl;
+
+    std::cout << std::endl;
+    m_basicSimulation->RegisterTimestamp("Create IP address to node id index");
+}
+
+void TopologyPtop::RemotePacketSent(Ptr<const Packet> packet) {
+    m_num_remote_packets_sent++;
+}
+
+void TopologyPtop::RemotePacketReceived(Ptr<const Packet> packet) {
+    m_num_remote_packets_received++;
+}
+
+int64_t TopologyPtop::GetNumRemotePacketsSent() {
+    return m_num_remote_packets_sent;
+}
+
+int64_t TopologyPtop::GetNumRemotePacketsReceived() {
+    return m_num_remote_packets_received;
 }
 
 const NodeContainer& TopologyPtop::GetNodes() {
@@ -720,4 +849,8 @@ Ptr<PointToPointNetDevice> TopologyPtop::GetSendingNetDeviceForLink(std::pair<in
     return m_link_to_sending_net_device.at(link);
 }
 
+Ptr<IpToNodeIdIndex> TopologyPtop::GetIpToNodeIdIndex() {
+    return m_ip_to_node_id_index;
+}
+
 }
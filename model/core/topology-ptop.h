@@ -32,6 +32,8 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/traffic-control-helper.h"
 #include "ns3/point-to-point-ab-helper.h"
+#include "ns3/ip-to-node-id-index.h"
+#include "ns3/graph-partitioner.h"
 
 namespace ns3 {
 
@@ -102,6 +104,7 @@ public:
     const std::vector<std::pair<uint32_t, uint32_t>>& GetInterfaceIdxsForUndirectedEdges();
     const std::vector<std::pair<Ptr<PointToPointNetDevice>, Ptr<PointToPointNetDevice>>>& GetNetDevicesForUndirectedEdges();
     Ptr<PointToPointNetDevice> GetSendingNetDeviceForLink(std::pair<int64_t, int64_t> link);
+    Ptr<IpToNodeIdIndex> GetIpToNodeIdIndex();
 
 private:
 
@@ -123,6 +126,9 @@ private:
     Ptr<TopologyPtopReceiveErrorModelSelector> m_receiveErrorModelSelector;
     Ptr<TopologyPtopTcQdiscSelector> m_tcQdiscSelector;
 
+    // Distributed
+    void PartitionNodesToSystems();
+
     // Ns-3 construction
     void SetupNodes(const Ipv4RoutingHelper& ipv4RoutingHelper);
     void SetupLinks();
@@ -151,6 +157,15 @@ private:
     std::vector<std::pair<uint32_t, uint32_t>> m_interface_idxs_for_undirected_edges;
     std::vector<std::pair<Ptr<PointToPointNetDevice>, Ptr<PointToPointNetDevice>>> m_net_devices_for_undirected_edges;
     std::map<std::pair<uint32_t, uint32_t>, Ptr<PointToPointNetDevice>> m_link_to_sending_net_device;
+    Ptr<IpToNodeIdIndex> m_ip_to_node_id_index;
+
+    // Packets on links between systems (only counted if distributed)
+    void RemotePacketSent(Ptr<const Packet> packet);
+    void RemotePacketReceived(Ptr<const Packet> packet);
+    int64_t GetNumRemotePacketsSent();
+    int64_t GetNumRemotePacketsReceived();
+    int64_t m_num_remote_packets_sent = 0;
+    int64_t m_num_remote_packets_received = 0;
 
 };
 
@@ -8,6 +8,7 @@ using namespace ns3;
 #include "test-case-with-log-validators.h"
 
 #include "apps/tcp-flow-schedule-reader-test.h"
+#include "apps/tcp-flow-result-store-test.h"
 #include "apps/tcp-flow-simple-test.h"
 #include "apps/tcp-flow-end-to-end-test.h"
 
@@ -18,6 +19,11 @@ public:
         // TCP flow schedule reader
         AddTestCase(new TcpFlowScheduleReaderNormalTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowScheduleReaderInvalidTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowScheduleReaderStreamTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowScheduleGeneratorTestCase, TestCase::QUICK);
+
+        // TCP flow result store
+        AddTestCase(new TcpFlowResultStoreTestCase, TestCase::QUICK);
 
         // TCP flow simple
         AddTestCase(new TcpFlowSimpleDoubleServerBindTestCase, TestCase::QUICK);
@@ -27,6 +33,9 @@ public:
         AddTestCase(new TcpFlowEndToEndOneToOneEqualStartTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndOneToOneSimpleStartTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndOneToOneApartStartTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowEndToEndStreamingTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowEndToEndRecyclingTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowEndToEndStartLookaheadTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndEcmpSimpleTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndEcmpRemainTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndLoggingSpecificTestCase, TestCase::QUICK);
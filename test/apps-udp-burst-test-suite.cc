@@ -21,6 +21,8 @@ public:
 
         // UDP burst simple
         AddTestCase(new UdpBurstSimpleHeaderTestCase, TestCase::QUICK);
+        AddTestCase(new UdpBurstSimpleHeaderSlotTestCase, TestCase::QUICK);
+        AddTestCase(new UdpBurstSimpleServerSlotsTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstSimpleDoubleServerBindTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstSimpleDoubleClientBindTestCase, TestCase::QUICK);
 
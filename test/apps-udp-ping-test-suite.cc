@@ -24,10 +24,13 @@ public:
         AddTestCase(new UdpPingSimpleHeaderTestCase, TestCase::QUICK);
         AddTestCase(new UdpPingSimpleDoubleServerBindTestCase, TestCase::QUICK);
         AddTestCase(new UdpPingSimpleDoubleClientBindTestCase, TestCase::QUICK);
+        AddTestCase(new UdpPingSimpleAgentAddPingTestCase, TestCase::QUICK);
 
         // UDP ping end-to-end
         AddTestCase(new UdpPingEndToEndOneToOneManyTestCase, TestCase::QUICK);
         AddTestCase(new UdpPingEndToEndMultiPathTestCase, TestCase::QUICK);
+        AddTestCase(new UdpPingEndToEndAggregateOnlyTestCase, TestCase::QUICK);
+        AddTestCase(new UdpPingEndToEndPerNodeAgentTestCase, TestCase::QUICK);
 
         // UDP ping pingmesh
         AddTestCase(new UdpPingPingmeshNineAllTestCase, TestCase::QUICK);
@@ -153,6 +153,11 @@ public:
         ASSERT_EQUAL(incoming_1_info.size(), 1);
         ASSERT_EQUAL(std::get<0>(incoming_1_info.at(0)), 0);
         ASSERT_EQUAL_APPROX((double) std::get<1>(incoming_1_info.at(0)), 0.7 * 15 * 1000 * 1000 / 8.0 / 1500.0, 100.0); // Not everything will arrive due to TCP competition
+        Ptr<UdpBurstServer> udpServer = udpServerApp.Get(0)->GetObject<UdpBurstServer>();
+        ASSERT_EQUAL(udpServer->GetReceivedCounterOf(0), std::get<1>(incoming_1_info.at(0)));
+        ASSERT_EQUAL(udpServer->GetReceivedBytesOf(0), std::get<1>(incoming_1_info.at(0)) * 1472);
+        ASSERT_EQUAL(udpServer->GetOutOfOrderCounterOf(0), 0); // Single path, so no reordering
+        ASSERT_EXCEPTION(udpServer->GetReceivedCounterOf(1));
 
         // Make sure these are removed
         remove_file_if_exists(test_run_dir + "/config_ns3.properties");
@@ -249,7 +254,10 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_0_progress.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_0_rtt.csv");
@@ -63,6 +63,7 @@ public:
         // Make sure these are removed
         remove_file_if_exists(test_run_dir + "/logs_ns3/finished.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
 
         // Write schedule file
@@ -109,6 +110,23 @@ public:
                 finished_list
         );
 
+        // Validate server connection counters (one server per endpoint, each on the default port)
+        std::vector<std::string> lines_servers_csv = read_file_direct(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
+        ASSERT_EQUAL(lines_servers_csv.size(), topology->GetEndpoints().size());
+        int64_t total_accepted = 0;
+        for (std::string line : lines_servers_csv) {
+            std::vector<std::string> line_spl = split_string(line, ",", 5);
+            ASSERT_TRUE(topology->IsValidEndpoint(parse_positive_int64(line_spl[0])));
+            ASSERT_EQUAL(parse_positive_int64(line_spl[1]), TcpFlowScheduler::DEFAULT_SERVER_PORT);
+            int64_t accepted = parse_positive_int64(line_spl[2]);
+            int64_t peak_open = parse_positive_int64(line_spl[3]);
+            int64_t open_at_end = parse_positive_int64(line_spl[4]);
+            ASSERT_TRUE(peak_open <= accepted);
+            ASSERT_TRUE(open_at_end <= peak_open);
+            total_accepted += accepted;
+        }
+        ASSERT_TRUE(total_accepted <= (int64_t) write_schedule.size());
+
         // Make sure these are removed
         remove_file_if_exists(test_run_dir + "/config_ns3.properties");
         remove_file_if_exists(test_run_dir + "/topology.properties");
@@ -118,6 +136,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (size_t i = 0; i < write_schedule.size(); i++) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -260,6 +279,194 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class TcpFlowEndToEndStreamingTestCase : public TcpFlowEndToEndTestCase
+{
+public:
+    TcpFlowEndToEndStreamingTestCase () : TcpFlowEndToEndTestCase ("tcp-flow-end-to-end streaming") {};
+
+    void run_schedule(int64_t streaming_window_ns, std::vector<int64_t>& end_time_ns_list, std::vector<int64_t>& sent_byte_list, std::vector<std::string>& finished_list) {
+        prepare_clean_run_dir(test_run_dir);
+
+        int64_t simulation_end_time_ns = 5000000000;
+
+        // One-to-one, 5s, 10.0 Mbit/s, 100 microseconds delay
+        write_basic_config(simulation_end_time_ns, 123456, 6);
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "tcp_flow_schedule_streaming_window_ns=" << streaming_window_ns << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+
+        // Flows spread over time, some starting at the same time
+        std::vector<TcpFlowScheduleEntry> schedule;
+        schedule.push_back(TcpFlowScheduleEntry(0, 0, 1, 100000, 0, "", "a"));
+        schedule.push_back(TcpFlowScheduleEntry(1, 1, 0, 200000, 0, "", "b"));
+        schedule.push_back(TcpFlowScheduleEntry(2, 0, 1, 300000, 1000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(3, 0, 1, 400000, 1000000000, "", "d"));
+        schedule.push_back(TcpFlowScheduleEntry(4, 1, 0, 500000, 1000000001, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(5, 0, 1, 600000, 3000000000, "", "f"));
+
+        // Perform the run
+        BeforeRunOperationNothing op;
+        test_run_and_validate_tcp_flow_logs(simulation_end_time_ns, test_run_dir, schedule, end_time_ns_list, sent_byte_list, finished_list, &op);
+
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-tcp-flow-end-to-end-streaming";
+
+        // Complete schedule read in
+        std::vector<int64_t> end_time_ns_list;
+        std::vector<int64_t> sent_byte_list;
+        std::vector<std::string> finished_list;
+        run_schedule(0, end_time_ns_list, sent_byte_list, finished_list);
+
+        // Streaming with different windows must have exactly the same outcome
+        for (int64_t streaming_window_ns : std::vector<int64_t>({1, 1000000, 10000000000})) {
+            std::vector<int64_t> streaming_end_time_ns_list;
+            std::vector<int64_t> streaming_sent_byte_list;
+            std::vector<std::string> streaming_finished_list;
+            run_schedule(streaming_window_ns, streaming_end_time_ns_list, streaming_sent_byte_list, streaming_finished_list);
+            ASSERT_EQUAL(streaming_end_time_ns_list.size(), 6);
+            for (size_t i = 0; i < 6; i++) {
+                ASSERT_EQUAL(streaming_end_time_ns_list[i], end_time_ns_list[i]);
+                ASSERT_EQUAL(streaming_sent_byte_list[i], sent_byte_list[i]);
+                ASSERT_EQUAL(streaming_finished_list[i], "YES");
+            }
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowEndToEndRecyclingTestCase : public TcpFlowEndToEndTestCase
+{
+public:
+    TcpFlowEndToEndRecyclingTestCase () : TcpFlowEndToEndTestCase ("tcp-flow-end-to-end recycling") {};
+
+    void run_schedule(bool enable_client_recycling, int64_t streaming_window_ns, std::vector<int64_t>& end_time_ns_list, std::vector<int64_t>& sent_byte_list, std::vector<std::string>& finished_list) {
+        prepare_clean_run_dir(test_run_dir);
+
+        int64_t simulation_end_time_ns = 5000000000;
+
+        // One-to-one, 5s, 10.0 Mbit/s, 100 microseconds delay
+        write_basic_config(simulation_end_time_ns, 123456, 8);
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "tcp_flow_enable_client_recycling=" << (enable_client_recycling ? "true" : "false") << std::endl;
+        config_file << "tcp_flow_schedule_streaming_window_ns=" << streaming_window_ns << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+
+        // Overlapping flows, and flows which start after earlier ones at the same node have finished
+        std::vector<TcpFlowScheduleEntry> schedule;
+        schedule.push_back(TcpFlowScheduleEntry(0, 0, 1, 100000, 0, "", "a"));
+        schedule.push_back(TcpFlowScheduleEntry(1, 0, 1, 200000, 0, "", "b"));
+        schedule.push_back(TcpFlowScheduleEntry(2, 1, 0, 300000, 1000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(3, 0, 1, 400000, 1000000000, "", "d"));
+        schedule.push_back(TcpFlowScheduleEntry(4, 0, 1, 500000, 1000000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(5, 1, 0, 600000, 2000000000, "", "f"));
+        schedule.push_back(TcpFlowScheduleEntry(6, 0, 1, 700000, 3000000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(7, 0, 1, 800000, 4000000000, "", "h"));
+
+        // Perform the run
+        BeforeRunOperationNothing op;
+        test_run_and_validate_tcp_flow_logs(simulation_end_time_ns, test_run_dir, schedule, end_time_ns_list, sent_byte_list, finished_list, &op);
+
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-tcp-flow-end-to-end-recycling";
+
+        // Without recycling
+        std::vector<int64_t> end_time_ns_list;
+        std::vector<int64_t> sent_byte_list;
+        std::vector<std::string> finished_list;
+        run_schedule(false, 0, end_time_ns_list, sent_byte_list, finished_list);
+
+        // Recycling (also in combination with streaming) must have exactly the same outcome
+        for (int64_t streaming_window_ns : std::vector<int64_t>({0, 1})) {
+            std::vector<int64_t> recycling_end_time_ns_list;
+            std::vector<int64_t> recycling_sent_byte_list;
+            std::vector<std::string> recycling_finished_list;
+            run_schedule(true, streaming_window_ns, recycling_end_time_ns_list, recycling_sent_byte_list, recycling_finished_list);
+            ASSERT_EQUAL(recycling_end_time_ns_list.size(), 8);
+            for (size_t i = 0; i < 8; i++) {
+                ASSERT_EQUAL(recycling_end_time_ns_list[i], end_time_ns_list[i]);
+                ASSERT_EQUAL(recycling_sent_byte_list[i], sent_byte_list[i]);
+                ASSERT_EQUAL(recycling_finished_list[i], "YES");
+            }
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowEndToEndStartLookaheadTestCase : public TcpFlowEndToEndTestCase
+{
+public:
+    TcpFlowEndToEndStartLookaheadTestCase () : TcpFlowEndToEndTestCase ("tcp-flow-end-to-end start-lookahead") {};
+
+    void run_schedule(int64_t start_lookahead_events, int64_t streaming_window_ns, std::vector<int64_t>& end_time_ns_list, std::vector<int64_t>& sent_byte_list, std::vector<std::string>& finished_list) {
+        prepare_clean_run_dir(test_run_dir);
+
+        int64_t simulation_end_time_ns = 5000000000;
+
+        // One-to-one, 5s, 10.0 Mbit/s, 100 microseconds delay
+        write_basic_config(simulation_end_time_ns, 123456, 7);
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "tcp_flow_start_lookahead_events=" << start_lookahead_events << std::endl;
+        config_file << "tcp_flow_schedule_streaming_window_ns=" << streaming_window_ns << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+
+        // Groups of flows with the same start time
+        std::vector<TcpFlowScheduleEntry> schedule;
+        schedule.push_back(TcpFlowScheduleEntry(0, 0, 1, 100000, 0, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(1, 1, 0, 200000, 0, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(2, 0, 1, 300000, 0, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(3, 0, 1, 400000, 1000000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(4, 1, 0, 500000, 2000000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(5, 0, 1, 600000, 2000000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(6, 1, 0, 700000, 3000000000, "", ""));
+
+        // Perform the run
+        BeforeRunOperationNothing op;
+        test_run_and_validate_tcp_flow_logs(simulation_end_time_ns, test_run_dir, schedule, end_time_ns_list, sent_byte_list, finished_list, &op);
+
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-tcp-flow-end-to-end-start-lookahead";
+
+        // One start event scheduled ahead at a time
+        std::vector<int64_t> end_time_ns_list;
+        std::vector<int64_t> sent_byte_list;
+        std::vector<std::string> finished_list;
+        run_schedule(1, 0, end_time_ns_list, sent_byte_list, finished_list);
+        for (size_t i = 0; i < 7; i++) {
+            ASSERT_EQUAL(finished_list[i], "YES");
+        }
+
+        // More start events scheduled ahead (also if streaming) must have exactly the same outcome
+        for (std::pair<int64_t, int64_t> p : std::vector<std::pair<int64_t, int64_t>>({{2, 0}, {100, 0}, {3, 1}, {3, 2000000000}})) {
+            std::vector<int64_t> lookahead_end_time_ns_list;
+            std::vector<int64_t> lookahead_sent_byte_list;
+            std::vector<std::string> lookahead_finished_list;
+            run_schedule(p.first, p.second, lookahead_end_time_ns_list, lookahead_sent_byte_list, lookahead_finished_list);
+            ASSERT_EQUAL(lookahead_end_time_ns_list.size(), 7);
+            for (size_t i = 0; i < 7; i++) {
+                ASSERT_EQUAL(lookahead_end_time_ns_list[i], end_time_ns_list[i]);
+                ASSERT_EQUAL(lookahead_sent_byte_list[i], sent_byte_list[i]);
+                ASSERT_EQUAL(lookahead_finished_list[i], "YES");
+            }
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class TcpFlowEndToEndEcmpSimpleTestCase : public TcpFlowEndToEndTestCase
 {
 public:
@@ -472,6 +679,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -598,6 +806,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -949,6 +1158,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (size_t i = 0; i < write_schedule.size(); i++) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -1269,6 +1479,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/link_net_device_utilization_summary.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -1455,6 +1666,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/link_interface_tc_qdisc_queue_pkt.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -1642,6 +1854,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/link_interface_tc_qdisc_queue_pkt.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowResultStoreTestCase : public TestCase
+{
+public:
+    TcpFlowResultStoreTestCase () : TestCase ("tcp-flow-result-store basic") {};
+
+    void DoRun () {
+        TcpFlowResultStore store;
+        ASSERT_EQUAL(store.GetSize(), 0);
+
+        // Added slots are ongoing
+        ASSERT_EQUAL(store.Add(), 0);
+        ASSERT_EQUAL(store.Add(), 1);
+        ASSERT_EQUAL(store.Add(), 2);
+        ASSERT_EQUAL(store.GetSize(), 3);
+        for (size_t i = 0; i < 3; i++) {
+            ASSERT_EQUAL(store.GetFinishedState(i), TcpFlowResultStore::ONGOING);
+            ASSERT_EQUAL(store.GetSentByte(i), 0);
+            ASSERT_EQUAL(store.GetCompletionTimeNs(i), -1);
+        }
+
+        // Record
+        store.Record(1, TcpFlowResultStore::COMPLETED, 100000, 5000);
+        store.Record(2, TcpFlowResultStore::ERR_CLOSE, 300, 7000);
+        ASSERT_EQUAL(store.GetFinishedState(0), TcpFlowResultStore::ONGOING);
+        ASSERT_EQUAL(store.GetFinishedState(1), TcpFlowResultStore::COMPLETED);
+        ASSERT_EQUAL(store.GetSentByte(1), 100000);
+        ASSERT_EQUAL(store.GetCompletionTimeNs(1), 5000);
+        ASSERT_EQUAL(store.GetFinishedState(2), TcpFlowResultStore::ERR_CLOSE);
+        ASSERT_EQUAL(store.GetSentByte(2), 300);
+        ASSERT_EQUAL(store.GetCompletionTimeNs(2), 7000);
+
+        // Out of range
+        ASSERT_EXCEPTION(store.GetSentByte(3));
+        ASSERT_EXCEPTION(store.Record(3, TcpFlowResultStore::COMPLETED, 1, 1));
+
+        // String representation
+        ASSERT_EQUAL(TcpFlowResultStore::FinishedStateToString(TcpFlowResultStore::ONGOING), "NO_ONGOING");
+        ASSERT_EQUAL(TcpFlowResultStore::FinishedStateToString(TcpFlowResultStore::COMPLETED), "YES");
+        ASSERT_EQUAL(TcpFlowResultStore::FinishedStateToString(TcpFlowResultStore::CONN_FAIL), "NO_CONN_FAIL");
+        ASSERT_EQUAL(TcpFlowResultStore::FinishedStateToString(TcpFlowResultStore::BAD_CLOSE), "NO_BAD_CLOSE");
+        ASSERT_EQUAL(TcpFlowResultStore::FinishedStateToString(TcpFlowResultStore::ERR_CLOSE), "NO_ERR_CLOSE");
+        ASSERT_EXCEPTION(TcpFlowResultStore::FinishedStateToString((TcpFlowResultStore::FinishedState) 5));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -225,3 +225,241 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowScheduleReaderStreamTestCase : public TcpFlowScheduleReaderTestCase
+{
+public:
+    TcpFlowScheduleReaderStreamTestCase () : TcpFlowScheduleReaderTestCase ("tcp-flow-schedule-reader stream") {};
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-tcp-flow-schedule-reader-stream";
+        prepare_clean_run_dir(test_run_dir);
+
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "tcp_flow_schedule_filename=\"tcp_flow_schedule.csv\"" << std::endl;
+        config_file.close();
+
+        std::ofstream topology_file;
+        topology_file.open (test_run_dir + "/topology.properties");
+        topology_file << "num_nodes=3" << std::endl;
+        topology_file << "num_undirected_edges=2" << std::endl;
+        topology_file << "switches=set(0,1,2)" << std::endl;
+        topology_file << "switches_which_are_tors=set(0,1,2)" << std::endl;
+        topology_file << "servers=set()" << std::endl;
+        topology_file << "undirected_edges=set(0-1,1-2)" << std::endl;
+        topology_file << "link_channel_delay_ns=10000" << std::endl;
+        topology_file << "link_net_device_data_rate_megabit_per_s=100" << std::endl;
+        topology_file << "link_net_device_queue=drop_tail(100p)" << std::endl;
+        topology_file << "link_net_device_receive_error_model=none" << std::endl;
+        topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+        topology_file.close();
+
+        std::ofstream schedule_file(test_run_dir + "/tcp_flow_schedule.csv");
+        schedule_file << "0,0,1,100,0,a=b,test" << std::endl;
+        schedule_file << "1,1,2,200,0,," << std::endl;
+        schedule_file << "2,2,0,300,500,,x" << std::endl;
+        schedule_file << "3,0,2,400,1000,c=d," << std::endl;
+        schedule_file << "4,0,2,500,7000,," << std::endl;
+        schedule_file.close();
+
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        std::vector<TcpFlowScheduleEntry> complete_schedule = read_tcp_flow_schedule(test_run_dir + "/tcp_flow_schedule.csv", topology, 10000000000);
+        ASSERT_EQUAL(validate_tcp_flow_schedule(test_run_dir + "/tcp_flow_schedule.csv", topology, 10000000000), 5);
+
+        // Read in windows
+        Ptr<TcpFlowScheduleStreamReader> reader = Create<TcpFlowScheduleStreamReader>(test_run_dir + "/tcp_flow_schedule.csv", topology, 10000000000);
+        std::vector<TcpFlowScheduleEntry> window;
+        ASSERT_TRUE(reader->HasNext());
+        ASSERT_EQUAL(reader->GetNextStartTimeNs(), 0);
+        reader->ReadUntil(0, window);
+        ASSERT_EQUAL(window.size(), 0);
+        reader->ReadUntil(1000, window);
+        ASSERT_EQUAL(window.size(), 3);
+        ASSERT_EQUAL(reader->GetNextStartTimeNs(), 1000);
+        reader->ReadUntil(1001, window);
+        ASSERT_EQUAL(window.size(), 4);
+        reader->ReadUntil(10000000000, window);
+        ASSERT_EQUAL(window.size(), 5);
+        ASSERT_FALSE(reader->HasNext());
+        ASSERT_EXCEPTION(reader->GetNextStartTimeNs());
+        ASSERT_EQUAL(reader->GetNumRead(), 5);
+
+        // Same as reading it completely
+        ASSERT_EQUAL(window.size(), complete_schedule.size());
+        for (size_t i = 0; i < window.size(); i++) {
+            ASSERT_EQUAL(window[i].GetTcpFlowId(), complete_schedule[i].GetTcpFlowId());
+            ASSERT_EQUAL(window[i].GetFromNodeId(), complete_schedule[i].GetFromNodeId());
+            ASSERT_EQUAL(window[i].GetToNodeId(), complete_schedule[i].GetToNodeId());
+            ASSERT_EQUAL(window[i].GetSizeByte(), complete_schedule[i].GetSizeByte());
+            ASSERT_EQUAL(window[i].GetStartTimeNs(), complete_schedule[i].GetStartTimeNs());
+            ASSERT_EQUAL(window[i].GetAdditionalParameters(), complete_schedule[i].GetAdditionalParameters());
+            ASSERT_EQUAL(window[i].GetMetadata(), complete_schedule[i].GetMetadata());
+        }
+
+        // Invalid lines are only detected once they are read
+        schedule_file = std::ofstream(test_run_dir + "/tcp_flow_schedule.csv");
+        schedule_file << "0,0,1,100,0,," << std::endl;
+        schedule_file << "1,0,1,100,1000,," << std::endl;
+        schedule_file << "2,0,1,100,500,," << std::endl;
+        schedule_file.close();
+        reader = Create<TcpFlowScheduleStreamReader>(test_run_dir + "/tcp_flow_schedule.csv", topology, 10000000000);
+        window.clear();
+        reader->ReadUntil(1, window);
+        ASSERT_EQUAL(window.size(), 1);
+        ASSERT_EXCEPTION(reader->ReadUntil(2000, window));
+
+        // ... unless the complete file is validated up front
+        ASSERT_EXCEPTION_MATCH_WHAT(
+                validate_tcp_flow_schedule(test_run_dir + "/tcp_flow_schedule.csv", topology, 10000000000),
+                "Start time is not weakly ascending (on line with TCP flow ID: 2, violation: 500)\n"
+        );
+        ASSERT_EXCEPTION(validate_tcp_flow_schedule("does-not-exist-temp.file", topology, 10000000));
+
+        // Non-existent file
+        ASSERT_EXCEPTION(Create<TcpFlowScheduleStreamReader>("does-not-exist-temp.file", topology, 10000000));
+
+        basicSimulation->Finalize();
+        cleanup_tcp_flow_schedule_reader_test();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowScheduleGeneratorTestCase : public TcpFlowScheduleReaderTestCase
+{
+public:
+    TcpFlowScheduleGeneratorTestCase () : TcpFlowScheduleReaderTestCase ("tcp-flow-schedule-reader generator") {};
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-tcp-flow-schedule-reader-generator";
+        prepare_clean_run_dir(test_run_dir);
+
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file.close();
+
+        std::ofstream topology_file;
+        topology_file.open (test_run_dir + "/topology.properties");
+        topology_file << "num_nodes=4" << std::endl;
+        topology_file << "num_undirected_edges=3" << std::endl;
+        topology_file << "switches=set(0,1,2,3)" << std::endl;
+        topology_file << "switches_which_are_tors=set(0,1,3)" << std::endl;
+        topology_file << "servers=set()" << std::endl;
+        topology_file << "undirected_edges=set(0-1,1-2,2-3)" << std::endl;
+        topology_file << "link_channel_delay_ns=10000" << std::endl;
+        topology_file << "link_net_device_data_rate_megabit_per_s=100" << std::endl;
+        topology_file << "link_net_device_queue=drop_tail(100p)" << std::endl;
+        topology_file << "link_net_device_receive_error_model=none" << std::endl;
+        topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+        topology_file.close();
+
+        // Flow size CDF
+        std::ofstream cdf_file(test_run_dir + "/flow_size_cdf.csv");
+        cdf_file << "100,0.0" << std::endl;
+        cdf_file << "1000,0.5" << std::endl;
+        cdf_file << "10000,0.9" << std::endl;
+        cdf_file << "100000,1.0" << std::endl;
+        cdf_file.close();
+        std::vector<std::pair<int64_t, double>> cdf = read_flow_size_cdf(test_run_dir + "/flow_size_cdf.csv");
+        ASSERT_EQUAL(cdf.size(), 4);
+        ASSERT_EQUAL(cdf[1].first, 1000);
+        ASSERT_EQUAL(cdf[1].second, 0.5);
+
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+
+        for (std::string pairing : std::vector<std::string>({"uniform", "permutation"})) {
+
+            // Generate in windows, and dump it
+            Ptr<TcpFlowScheduleGenerator> generator = Create<TcpFlowScheduleGenerator>(topology, 1000000000, 1000.0, cdf, pairing, 42, test_run_dir + "/tcp_flow_schedule_generated.csv");
+            std::vector<TcpFlowScheduleEntry> window;
+            int64_t t = 0;
+            while (generator->HasNext()) {
+                t += 10000000;
+                generator->ReadUntil(t, window);
+            }
+            ASSERT_EQUAL(generator->GetNumRead(), (int64_t) window.size());
+            generator = 0; // Closes the dump
+
+            // Roughly the arrival rate (1000 flows/s for 1s)
+            ASSERT_TRUE(window.size() >= 850 && window.size() <= 1150);
+
+            // Valid entries
+            std::map<int64_t, int64_t> partner;
+            for (size_t i = 0; i < window.size(); i++) {
+                ASSERT_EQUAL(window[i].GetTcpFlowId(), (int64_t) i);
+                ASSERT_TRUE(topology->IsValidEndpoint(window[i].GetFromNodeId()));
+                ASSERT_TRUE(topology->IsValidEndpoint(window[i].GetToNodeId()));
+                ASSERT_NOT_EQUAL(window[i].GetFromNodeId(), window[i].GetToNodeId());
+                ASSERT_TRUE(window[i].GetSizeByte() >= 100 && window[i].GetSizeByte() <= 100000);
+                ASSERT_TRUE(window[i].GetStartTimeNs() < 1000000000);
+                if (i > 0) {
+                    ASSERT_TRUE(window[i].GetStartTimeNs() >= window[i - 1].GetStartTimeNs());
+                }
+                if (pairing == "permutation") {
+                    if (partner.find(window[i].GetFromNodeId()) == partner.end()) {
+                        partner[window[i].GetFromNodeId()] = window[i].GetToNodeId();
+                    }
+                    ASSERT_EQUAL(partner[window[i].GetFromNodeId()], window[i].GetToNodeId());
+                }
+            }
+
+            // Same seed yields the same schedule, which is also the dumped schedule
+            std::vector<TcpFlowScheduleEntry> dumped = read_tcp_flow_schedule(test_run_dir + "/tcp_flow_schedule_generated.csv", topology, 1000000000);
+            Ptr<TcpFlowScheduleGenerator> generator_again = Create<TcpFlowScheduleGenerator>(topology, 1000000000, 1000.0, cdf, pairing, 42, "");
+            std::vector<TcpFlowScheduleEntry> window_again;
+            generator_again->ReadUntil(1000000000, window_again);
+            ASSERT_EQUAL(window_again.size(), window.size());
+            ASSERT_EQUAL(dumped.size(), window.size());
+            for (size_t i = 0; i < window.size(); i++) {
+                ASSERT_EQUAL(window_again[i].GetFromNodeId(), window[i].GetFromNodeId());
+                ASSERT_EQUAL(window_again[i].GetToNodeId(), window[i].GetToNodeId());
+                ASSERT_EQUAL(window_again[i].GetSizeByte(), window[i].GetSizeByte());
+                ASSERT_EQUAL(window_again[i].GetStartTimeNs(), window[i].GetStartTimeNs());
+                ASSERT_EQUAL(dumped[i].GetFromNodeId(), window[i].GetFromNodeId());
+                ASSERT_EQUAL(dumped[i].GetToNodeId(), window[i].GetToNodeId());
+                ASSERT_EQUAL(dumped[i].GetSizeByte(), window[i].GetSizeByte());
+                ASSERT_EQUAL(dumped[i].GetStartTimeNs(), window[i].GetStartTimeNs());
+            }
+
+        }
+
+        // Invalid generator parameters
+        ASSERT_EXCEPTION(Create<TcpFlowScheduleGenerator>(topology, 1000000000, 0.0, cdf, "uniform", 42, ""));
+        ASSERT_EXCEPTION(Create<TcpFlowScheduleGenerator>(topology, 1000000000, 1000.0, cdf, "does-not-exist", 42, ""));
+        ASSERT_EXCEPTION(Create<TcpFlowScheduleGenerator>(topology, 1000000000, 1000.0, std::vector<std::pair<int64_t, double>>(), "uniform", 42, ""));
+
+        // Invalid CDFs
+        std::vector<std::string> invalid_cdfs = {
+                "",                         // Empty
+                "100,0.5\n1000,0.9\n",      // Does not end at 1
+                "100,0.5\n100,1.0\n",       // Size not strictly ascending
+                "100,0.5\n1000,0.4\n",      // Probability not weakly ascending
+                "100,0.5\n1000,1.1\n",      // Probability above 1
+                "0,0.5\n1000,1.0\n",        // Size of zero
+                "100,0.5,3\n1000,1.0\n",    // Too many columns
+        };
+        for (std::string invalid_cdf : invalid_cdfs) {
+            cdf_file = std::ofstream(test_run_dir + "/flow_size_cdf.csv");
+            cdf_file << invalid_cdf;
+            cdf_file.close();
+            ASSERT_EXCEPTION(read_flow_size_cdf(test_run_dir + "/flow_size_cdf.csv"));
+        }
+        ASSERT_EXCEPTION(read_flow_size_cdf("does-not-exist-temp.file"));
+
+        basicSimulation->Finalize();
+        remove_file_if_exists(test_run_dir + "/flow_size_cdf.csv");
+        remove_file_if_exists(test_run_dir + "/tcp_flow_schedule_generated.csv");
+        cleanup_tcp_flow_schedule_reader_test();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -106,6 +106,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         for (UdpBurstInfo entry : write_schedule) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/udp_burst_" + std::to_string(entry.GetUdpBurstId()) + "_outgoing.csv");
@@ -571,6 +572,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         for (int64_t i : udp_burst_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/udp_burst_" + std::to_string(i) + "_outgoing.csv");
@@ -689,6 +691,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         for (int64_t i : udp_burst_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/udp_burst_" + std::to_string(i) + "_outgoing.csv");
@@ -874,6 +877,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         for (int64_t i : udp_burst_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/udp_burst_" + std::to_string(i) + "_outgoing.csv");
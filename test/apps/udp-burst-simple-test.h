@@ -22,6 +22,64 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class UdpBurstSimpleHeaderSlotTestCase : public TestCaseWithLogValidators
+{
+public:
+    UdpBurstSimpleHeaderSlotTestCase () : TestCaseWithLogValidators ("udp-burst-simple header-slot") {};
+
+    void DoRun () {
+        UdpBurstHeader header;
+        header.SetId(4000000000);
+        header.SetSeq(77);
+        header.SetSlot(123456);
+        ASSERT_EQUAL(header.GetSlot(), 123456);
+
+        // The slot is carried within the same 16 bytes
+        Ptr<Packet> packet = Create<Packet>(100);
+        packet->AddHeader(header);
+        ASSERT_EQUAL(packet->GetSize(), 116);
+        UdpBurstHeader received;
+        packet->RemoveHeader(received);
+        ASSERT_EQUAL(received.GetId(), 4000000000);
+        ASSERT_EQUAL(received.GetSeq(), 77);
+        ASSERT_EQUAL(received.GetSlot(), 123456);
+        ASSERT_EQUAL(packet->GetSize(), 100);
+
+        // The identifier is carried in 32 bits, so a larger one is rejected instead of truncated
+        header.SetId(UINT32_MAX);
+        ASSERT_EQUAL(header.GetId(), UINT32_MAX);
+        ASSERT_EXCEPTION(header.SetId(((uint64_t) UINT32_MAX) + 1));
+        ASSERT_EQUAL(header.GetId(), UINT32_MAX);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class UdpBurstSimpleServerSlotsTestCase : public TestCaseWithLogValidators
+{
+public:
+    UdpBurstSimpleServerSlotsTestCase () : TestCaseWithLogValidators ("udp-burst-simple server-slots") {};
+
+    void DoRun () {
+        Ptr<UdpBurstServer> server = CreateObject<UdpBurstServer>();
+        ASSERT_EQUAL(server->RegisterIncomingBurst(7, false), 0);
+        ASSERT_EQUAL(server->RegisterIncomingBurst(3, false), 1);
+        ASSERT_EQUAL(server->RegisterIncomingBurst(12, false), 2);
+        ASSERT_EXCEPTION(server->RegisterIncomingBurst(3, false));
+        ASSERT_EQUAL(server->GetReceivedCounterOf(3), 0);
+        ASSERT_EQUAL(server->GetReceivedBytesOf(12), 0);
+        ASSERT_EQUAL(server->GetOutOfOrderCounterOf(7), 0);
+        ASSERT_EXCEPTION(server->GetReceivedCounterOf(4));
+        std::vector<std::tuple<int64_t, uint64_t>> info = server->GetIncomingBurstsInformation();
+        ASSERT_EQUAL(info.size(), 3);
+        ASSERT_EQUAL(std::get<0>(info.at(0)), 7);
+        ASSERT_EQUAL(std::get<0>(info.at(1)), 3);
+        ASSERT_EQUAL(std::get<0>(info.at(2)), 12);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class UdpBurstSimpleDoubleServerBindTestCase : public TestCaseWithLogValidators
 {
 public:
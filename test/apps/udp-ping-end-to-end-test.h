@@ -94,6 +94,8 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
@@ -382,6 +384,271 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
+        remove_dir_if_exists(test_run_dir + "/logs_ns3");
+        remove_dir_if_exists(test_run_dir);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class UdpPingEndToEndAggregateOnlyTestCase : public UdpPingEndToEndTestCase
+{
+public:
+    UdpPingEndToEndAggregateOnlyTestCase () : UdpPingEndToEndTestCase ("udp-ping-end-to-end aggregate-only") {};
+
+    void run_and_read_logs(
+            int64_t simulation_end_time_ns,
+            std::vector<UdpPingInfo> write_schedule,
+            bool enable_per_ping_logging,
+            std::vector<std::string>& lines_summary_csv,
+            std::vector<std::string>& lines_txt
+    ) {
+
+        // Basic configuration, and whether to keep the timestamps of each ping
+        write_basic_config(simulation_end_time_ns, 123456);
+        std::ofstream config_file;
+        config_file.open (test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "udp_ping_enable_per_ping_logging=" << (enable_per_ping_logging ? "true" : "false") << std::endl;
+        config_file.close();
+
+        // Write schedule file
+        std::ofstream schedule_file;
+        schedule_file.open (test_run_dir + "/udp_ping_schedule.csv");
+        for (UdpPingInfo entry : write_schedule) {
+            schedule_file
+                    << entry.GetUdpPingId() << ","
+                    << entry.GetFromNodeId() << ","
+                    << entry.GetToNodeId() << ","
+                    << entry.GetIntervalNs() << ","
+                    << entry.GetStartTimeNs() << ","
+                    << entry.GetDurationNs() << ","
+                    << entry.GetWaitAfterwardsNs() << ","
+                    << entry.GetAdditionalParameters() << ","
+                    << entry.GetMetadata()
+                    << std::endl;
+        }
+        schedule_file.close();
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        UdpPingScheduler udpPingScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        udpPingScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // The per-ping log is only there if it is enabled
+        ASSERT_EQUAL(file_exists(test_run_dir + "/logs_ns3/udp_pings.csv"), enable_per_ping_logging);
+        lines_summary_csv = read_file_direct(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        lines_txt = read_file_direct(test_run_dir + "/logs_ns3/udp_pings.txt");
+
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-udp-ping-end-to-end-aggregate-only";
+        prepare_clean_run_dir(test_run_dir);
+
+        // One-to-one (single) topology, 2s, 10.0 Mbit/s, 1ms delay
+        int64_t simulation_end_time_ns = 2000000000;
+        write_single_topology(10.0, 1000000);
+
+        // Several UDP pings, of which the replies of the last one can partially not arrive before the end
+        std::vector<UdpPingInfo> schedule;
+        schedule.push_back(UdpPingInfo(0, 1, 0, 10000, 5000, 100000, 1950000, "", "abc"));
+        schedule.push_back(UdpPingInfo(1, 0, 1, 10000000, 500000, 1500000000, 0, "", ""));
+        schedule.push_back(UdpPingInfo(2, 1, 0, 100000, 1999000000, 1000000, 0, "", ""));
+
+        // Once with and once without the timestamps of each ping
+        std::vector<std::string> lines_summary_csv_per_ping;
+        std::vector<std::string> lines_txt_per_ping;
+        run_and_read_logs(simulation_end_time_ns, schedule, true, lines_summary_csv_per_ping, lines_txt_per_ping);
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        std::vector<std::string> lines_summary_csv_aggregate;
+        std::vector<std::string> lines_txt_aggregate;
+        run_and_read_logs(simulation_end_time_ns, schedule, false, lines_summary_csv_aggregate, lines_txt_aggregate);
+
+        // The statistics must be the same
+        ASSERT_EQUAL(lines_summary_csv_per_ping.size(), 3);
+        ASSERT_EQUAL(lines_txt_per_ping.size(), 4);
+        ASSERT_EQUAL(lines_summary_csv_aggregate.size(), 3);
+        ASSERT_EQUAL(lines_txt_aggregate.size(), 4);
+        for (size_t i = 0; i < 3; i++) {
+            ASSERT_EQUAL(lines_summary_csv_per_ping.at(i), lines_summary_csv_aggregate.at(i));
+        }
+        for (size_t i = 0; i < 4; i++) {
+            ASSERT_EQUAL(lines_txt_per_ping.at(i), lines_txt_aggregate.at(i));
+        }
+
+        // The last ping ran until the end, so not all of its replies arrived
+        std::vector<std::string> spl = split_string(lines_summary_csv_aggregate.at(2), ",", 19);
+        ASSERT_TRUE(parse_positive_int64(spl[16]) < parse_positive_int64(spl[17]));
+
+        // The ping which started in the last nanosecond sent exactly one, of which no reply arrived
+        spl = split_string(lines_summary_csv_agents.at(4), ",", 19);
+        ASSERT_EQUAL(parse_positive_int64(spl[17]), 1);
+        ASSERT_EQUAL(spl[16], "0");
+
+        // Make sure these are removed
+        remove_file_if_exists(test_run_dir + "/config_ns3.properties");
+        remove_file_if_exists(test_run_dir + "/topology.properties");
+        remove_file_if_exists(test_run_dir + "/udp_ping_schedule.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
+        remove_dir_if_exists(test_run_dir + "/logs_ns3");
+        remove_dir_if_exists(test_run_dir);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class UdpPingEndToEndPerNodeAgentTestCase : public UdpPingEndToEndTestCase
+{
+public:
+    UdpPingEndToEndPerNodeAgentTestCase () : UdpPingEndToEndTestCase ("udp-ping-end-to-end per-node-agent") {};
+
+    void run_and_read_logs(
+            int64_t simulation_end_time_ns,
+            std::vector<UdpPingInfo> write_schedule,
+            bool enable_per_node_agent,
+            std::vector<std::string>& lines_csv,
+            std::vector<std::string>& lines_summary_csv,
+            std::vector<std::string>& lines_txt,
+            std::vector<std::string>& lines_rtt_sketch_csv
+    ) {
+
+        // Basic configuration, and whether all UDP pings of a node are sent by a single agent
+        write_basic_config(simulation_end_time_ns, 123456);
+        std::ofstream config_file;
+        config_file.open (test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "udp_ping_enable_per_node_agent=" << (enable_per_node_agent ? "true" : "false") << std::endl;
+        config_file.close();
+
+        // Write schedule file
+        std::ofstream schedule_file;
+        schedule_file.open (test_run_dir + "/udp_ping_schedule.csv");
+        for (UdpPingInfo entry : write_schedule) {
+            schedule_file
+                    << entry.GetUdpPingId() << ","
+                    << entry.GetFromNodeId() << ","
+                    << entry.GetToNodeId() << ","
+                    << entry.GetIntervalNs() << ","
+                    << entry.GetStartTimeNs() << ","
+                    << entry.GetDurationNs() << ","
+                    << entry.GetWaitAfterwardsNs() << ","
+                    << entry.GetAdditionalParameters() << ","
+                    << entry.GetMetadata()
+                    << std::endl;
+        }
+        schedule_file.close();
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        UdpPingScheduler udpPingScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        udpPingScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // Validate UDP ping logs
+        std::vector<std::vector<int64_t>> list_latency_there_ns;
+        std::vector<std::vector<int64_t>> list_latency_back_ns;
+        std::vector<std::vector<int64_t>> list_rtt_ns;
+        validate_udp_ping_logs(
+                simulation_end_time_ns,
+                test_run_dir,
+                write_schedule,
+                list_latency_there_ns,
+                list_latency_back_ns,
+                list_rtt_ns
+        );
+
+        // Read the logs
+        lines_csv = read_file_direct(test_run_dir + "/logs_ns3/udp_pings.csv");
+        lines_summary_csv = read_file_direct(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        lines_txt = read_file_direct(test_run_dir + "/logs_ns3/udp_pings.txt");
+        lines_rtt_sketch_csv = read_file_direct(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
+
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-udp-ping-end-to-end-per-node-agent";
+        prepare_clean_run_dir(test_run_dir);
+
+        // One-to-one (single) topology, 2s, 10.0 Mbit/s, 1ms delay
+        int64_t simulation_end_time_ns = 2000000000;
+        write_single_topology(10.0, 1000000);
+
+        // Several UDP pings, of which two from node 1 overlap (their pings queue behind each other),
+        // and the replies of the last one can partially not arrive before the end
+        std::vector<UdpPingInfo> schedule;
+        schedule.push_back(UdpPingInfo(0, 1, 0, 10000, 5000, 100000, 1950000, "", "abc"));
+        schedule.push_back(UdpPingInfo(1, 1, 0, 30000, 50000, 300000, 0, "", ""));
+        schedule.push_back(UdpPingInfo(2, 0, 1, 10000000, 500000, 1500000000, 0, "", ""));
+        schedule.push_back(UdpPingInfo(3, 1, 0, 100000, 1999000000, 1000000, 0, "", ""));
+        schedule.push_back(UdpPingInfo(4, 0, 1, 100000, 1999999999, 1000000, 0, "", "")); // Starts in the last nanosecond
+
+        // Once with a client for each UDP ping, once with an agent for each node
+        std::vector<std::string> lines_csv_clients;
+        std::vector<std::string> lines_summary_csv_clients;
+        std::vector<std::string> lines_txt_clients;
+        std::vector<std::string> lines_rtt_sketch_csv_clients;
+        run_and_read_logs(simulation_end_time_ns, schedule, false, lines_csv_clients, lines_summary_csv_clients, lines_txt_clients, lines_rtt_sketch_csv_clients);
+        std::vector<std::string> lines_csv_agents;
+        std::vector<std::string> lines_summary_csv_agents;
+        std::vector<std::string> lines_txt_agents;
+        std::vector<std::string> lines_rtt_sketch_csv_agents;
+        run_and_read_logs(simulation_end_time_ns, schedule, true, lines_csv_agents, lines_summary_csv_agents, lines_txt_agents, lines_rtt_sketch_csv_agents);
+
+        // The logs must be the same (there is only one path, so the source port does not matter)
+        ASSERT_EQUAL(lines_csv_clients.size(), lines_csv_agents.size());
+        for (size_t i = 0; i < lines_csv_clients.size(); i++) {
+            ASSERT_EQUAL(lines_csv_clients.at(i), lines_csv_agents.at(i));
+        }
+        ASSERT_EQUAL(lines_summary_csv_clients.size(), 5);
+        ASSERT_EQUAL(lines_summary_csv_agents.size(), 5);
+        for (size_t i = 0; i < 5; i++) {
+            ASSERT_EQUAL(lines_summary_csv_clients.at(i), lines_summary_csv_agents.at(i));
+        }
+        ASSERT_EQUAL(lines_txt_clients.size(), 6);
+        ASSERT_EQUAL(lines_txt_agents.size(), 6);
+        for (size_t i = 0; i < 6; i++) {
+            ASSERT_EQUAL(lines_txt_clients.at(i), lines_txt_agents.at(i));
+        }
+        ASSERT_EQUAL(lines_rtt_sketch_csv_clients.size(), lines_rtt_sketch_csv_agents.size());
+        for (size_t i = 0; i < lines_rtt_sketch_csv_clients.size(); i++) {
+            ASSERT_EQUAL(lines_rtt_sketch_csv_clients.at(i), lines_rtt_sketch_csv_agents.at(i));
+        }
+
+        // The last ping ran until the end, so not all of its replies arrived
+        std::vector<std::string> spl = split_string(lines_summary_csv_agents.at(3), ",", 19);
+        ASSERT_TRUE(parse_positive_int64(spl[16]) < parse_positive_int64(spl[17]));
+
+        // The ping which started in the last nanosecond sent exactly one, of which no reply arrived
+        spl = split_string(lines_summary_csv_agents.at(4), ",", 19);
+        ASSERT_EQUAL(parse_positive_int64(spl[17]), 1);
+        ASSERT_EQUAL(spl[16], "0");
+
+        // Make sure these are removed
+        remove_file_if_exists(test_run_dir + "/config_ns3.properties");
+        remove_file_if_exists(test_run_dir + "/topology.properties");
+        remove_file_if_exists(test_run_dir + "/udp_ping_schedule.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
@@ -201,6 +201,8 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
@@ -301,6 +303,8 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
@@ -420,9 +424,12 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
 
@@ -503,6 +510,8 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_pings.txt");
         remove_dir_if_exists(test_run_dir + "/logs_ns3");
         remove_dir_if_exists(test_run_dir);
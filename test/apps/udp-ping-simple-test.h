@@ -115,3 +115,46 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
+
+class UdpPingSimpleAgentAddPingTestCase : public TestCaseWithLogValidators
+{
+public:
+    UdpPingSimpleAgentAddPingTestCase () : TestCaseWithLogValidators ("udp-ping-simple agent-add-ping") {};
+
+    void DoRun () {
+        Ptr<UdpPingAgent> agent = CreateObject<UdpPingAgent>();
+        ASSERT_EQUAL(agent->GetNumPings(), 0);
+
+        // Each UDP ping gets the next slot
+        InetSocketAddress remoteAddress(Ipv4Address("10.1.1.2"), 1026);
+        ASSERT_EQUAL(agent->AddPing(3, remoteAddress, 0, 1000, 100000, 0), 0);
+        ASSERT_EQUAL(agent->AddPing(7, remoteAddress, 500, 10000, 100000, 50000), 1);
+        ASSERT_EQUAL(agent->AddPing(8, remoteAddress, 500, 10, 20, 0), 2);
+        ASSERT_EQUAL(agent->GetNumPings(), 3);
+        ASSERT_EQUAL(agent->GetUdpPingIdOf(0), 3);
+        ASSERT_EQUAL(agent->GetUdpPingIdOf(1), 7);
+        ASSERT_EQUAL(agent->GetUdpPingIdOf(2), 8);
+        ASSERT_EQUAL(agent->GetSentOf(1), 0);
+        ASSERT_EQUAL(agent->GetRttStatisticsOf(1).GetCount(), 0);
+        ASSERT_EQUAL(agent->GetRttSketchOf(1).GetCount(), 0);
+        ASSERT_TRUE(agent->IsPerPingLoggingEnabled());
+        ASSERT_EQUAL(agent->GetSendRequestTimestampsOf(1).size(), 0);
+
+        // UDP ping IDs must be ascending
+        ASSERT_EXCEPTION(agent->AddPing(8, remoteAddress, 500, 10, 20, 0));
+        ASSERT_EXCEPTION(agent->AddPing(2, remoteAddress, 500, 10, 20, 0));
+
+        // Invalid timing
+        ASSERT_EXCEPTION(agent->AddPing(9, remoteAddress, -1, 10, 20, 0));
+        ASSERT_EXCEPTION(agent->AddPing(9, remoteAddress, 500, 0, 20, 0));
+        ASSERT_EXCEPTION(agent->AddPing(9, remoteAddress, 500, 10, 0, 0));
+        ASSERT_EXCEPTION(agent->AddPing(9, remoteAddress, 500, 10, 20, -1));
+        ASSERT_EQUAL(agent->GetNumPings(), 3);
+
+        // Out of range
+        ASSERT_EXCEPTION(agent->GetUdpPingIdOf(3));
+        ASSERT_EXCEPTION(agent->GetRttStatisticsOf(3));
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -22,8 +22,12 @@ public:
         AddTestCase(new ArbiterEcmpHashTestCase, TestCase::QUICK);
         AddTestCase(new ArbiterEcmpStringReprTestCase, TestCase::QUICK);
         AddTestCase(new ArbiterBadImplTestCase, TestCase::QUICK);
-        AddTestCase(new ArbiterEcmpTooManyNodesTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterEcmpForwardingTableTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterEcmpMultiThreadedTestCase, TestCase::QUICK);
         AddTestCase(new ArbiterEcmpSeparatedTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterEcmpFlowCacheTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterEcmpFlowTagTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterEcmpDistanceLabelsTestCase, TestCase::QUICK);
         AddTestCase(new Ipv4ArbiterRoutingNoRouteTestCase, TestCase::QUICK);
 
     }
@@ -0,0 +1,22 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-sim-module.h"
+
+using namespace ns3;
+
+#include "test-helpers.h"
+#include "test-case-with-log-validators.h"
+
+#include "core/async-log-writer-test.h"
+
+
+class BasicSimCoreAsyncLogWriterTestSuite : public TestSuite {
+public:
+    BasicSimCoreAsyncLogWriterTestSuite() : TestSuite("basic-sim-core-async-log-writer", UNIT) {
+
+        // Asynchronous log writer
+        AddTestCase(new AsyncLogWriterTestCase, TestCase::QUICK);
+
+    }
+};
+static BasicSimCoreAsyncLogWriterTestSuite basicSimCoreAsyncLogWriterTestSuite;
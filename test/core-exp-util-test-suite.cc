@@ -21,6 +21,7 @@ public:
         AddTestCase(new ExpUtilConfigurationReadingTestCase, TestCase::QUICK);
         AddTestCase(new ExpUtilUnitConversionTestCase, TestCase::QUICK);
         AddTestCase(new ExpUtilFileSystemTestCase, TestCase::QUICK);
+        AddTestCase(new ExpUtilInPlaceParsingTestCase, TestCase::QUICK);
 
     }
 };
@@ -0,0 +1,20 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-sim-module.h"
+
+using namespace ns3;
+
+#include "test-helpers.h"
+
+#include "core/graph-partitioner-test.h"
+
+
+class BasicSimCoreGraphPartitionerTestSuite : public TestSuite {
+public:
+    BasicSimCoreGraphPartitionerTestSuite() : TestSuite("basic-sim-core-graph-partitioner", UNIT) {
+        AddTestCase(new GraphPartitionerLookaheadTestCase, TestCase::QUICK);
+        AddTestCase(new GraphPartitionerBalanceTestCase, TestCase::QUICK);
+        AddTestCase(new GraphPartitionerInvalidTestCase, TestCase::QUICK);
+    }
+};
+static BasicSimCoreGraphPartitionerTestSuite basicSimCoreGraphPartitionerTestSuite;
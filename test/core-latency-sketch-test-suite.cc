@@ -0,0 +1,19 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-sim-module.h"
+
+using namespace ns3;
+
+#include "test-helpers.h"
+
+#include "core/latency-sketch-test.h"
+
+
+class BasicSimCoreLatencySketchTestSuite : public TestSuite {
+public:
+    BasicSimCoreLatencySketchTestSuite() : TestSuite("basic-sim-core-latency-sketch", UNIT) {
+        AddTestCase(new LatencySketchBasicTestCase, TestCase::QUICK);
+        AddTestCase(new LatencySketchMergeTestCase, TestCase::QUICK);
+    }
+};
+static BasicSimCoreLatencySketchTestSuite basicSimCoreLatencySketchTestSuite;
@@ -0,0 +1,23 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-sim-module.h"
+
+using namespace ns3;
+
+#include "test-helpers.h"
+#include "test-case-with-log-validators.h"
+
+#include "core/log-output-sink-test.h"
+
+
+class BasicSimCoreLogOutputSinkTestSuite : public TestSuite {
+public:
+    BasicSimCoreLogOutputSinkTestSuite() : TestSuite("basic-sim-core-log-output-sink", UNIT) {
+
+        // Log output sinks
+        AddTestCase(new LogOutputSinkFormatsTestCase, TestCase::QUICK);
+        AddTestCase(new LogOutputSinkLogUpdateHelperTestCase, TestCase::QUICK);
+
+    }
+};
+static BasicSimCoreLogOutputSinkTestSuite basicSimCoreLogOutputSinkTestSuite;
@@ -20,6 +20,7 @@ public:
         AddTestCase(new LogUpdateHelperInvalidTestCase, TestCase::QUICK);
         AddTestCase(new LogUpdateHelperValidStringTestCase, TestCase::QUICK);
         AddTestCase(new LogUpdateHelperValidStringWithFileTestCase, TestCase::QUICK);
+        AddTestCase(new LogUpdateHelperStreamingTestCase, TestCase::QUICK);
 
     }
 };
@@ -24,6 +24,7 @@ public:
         // Point-to-point link net-device queue tracking
         AddTestCase(new PtopTrackingLinkNetDeviceQueueSimpleTestCase, TestCase::QUICK);
         AddTestCase(new PtopTrackingLinkNetDeviceQueueSpecificLinksTestCase, TestCase::QUICK);
+        AddTestCase(new PtopTrackingLinkNetDeviceQueueStreamingTestCase, TestCase::QUICK);
         AddTestCase(new PtopTrackingLinkNetDeviceQueueNotEnabledTestCase, TestCase::QUICK);
 
         // Point-to-point link interface traffic-control qdisc queue tracking
@@ -0,0 +1,19 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-sim-module.h"
+
+using namespace ns3;
+
+#include "test-helpers.h"
+
+#include "core/running-statistics-test.h"
+
+
+class BasicSimCoreRunningStatisticsTestSuite : public TestSuite {
+public:
+    BasicSimCoreRunningStatisticsTestSuite() : TestSuite("basic-sim-core-running-statistics", UNIT) {
+        AddTestCase(new RunningStatisticsBasicTestCase, TestCase::QUICK);
+        AddTestCase(new RunningStatisticsMergeTestCase, TestCase::QUICK);
+    }
+};
+static BasicSimCoreRunningStatisticsTestSuite basicSimCoreRunningStatisticsTestSuite;
@@ -83,6 +83,22 @@ public:
         ASSERT_EXCEPTION(arbiter->ResolveNodeIdFromIp(Ipv4Address("10.0.0.0").Get()));
         ASSERT_EXCEPTION(arbiter->ResolveNodeIdFromIp(Ipv4Address("10.0.1.3").Get()));
         ASSERT_EXCEPTION(arbiter->ResolveNodeIdFromIp(Ipv4Address("10.0.4.1").Get()));
+        ASSERT_EXCEPTION_MATCH_WHAT(
+                arbiter->ResolveNodeIdFromIp(Ipv4Address("10.0.4.1").Get()),
+                "IP address 10.0.4.1 (167773185) is not mapped to a node id"
+        );
+
+        // The index is built once by the topology and shared by all arbiters
+        Ptr<IpToNodeIdIndex> index = topology->GetIpToNodeIdIndex();
+        ASSERT_EQUAL(index->GetNumAddresses(), 8);
+        ASSERT_EQUAL(index->GetCapacity(), 16);
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            Ptr<Arbiter> other = nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter();
+            ASSERT_EQUAL(other->ResolveNodeIdFromIp(Ipv4Address("10.0.3.2").Get()), 3);
+            for (uint32_t j = 1; j < nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces(); j++) {
+                ASSERT_EQUAL(index->ResolveNodeIdFromIp(nodes.Get(i)->GetObject<Ipv4>()->GetAddress(j, 0).GetLocal().Get()), i);
+            }
+        }
 
         basicSimulation->Finalize();
         cleanup_arbiter_test();
@@ -528,6 +544,13 @@ public:
         // Create nodes, setup links and create arbiter
         NodeContainer nodes = topology->GetNodes();
         std::vector<std::pair<uint32_t, uint32_t>> interface_idxs_for_edges = topology->GetInterfaceIdxsForUndirectedEdges();
+
+        // Without an arbiter (e.g., a node of another system), it is stated instead
+        std::ostringstream res_no_arbiter;
+        OutputStreamWrapper out_stream_no_arbiter = OutputStreamWrapper(&res_no_arbiter);
+        nodes.Get(0)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->PrintRoutingTable(&out_stream_no_arbiter);
+        ASSERT_EQUAL(res_no_arbiter.str(), "No arbiter at node 0 (it belongs to another system)\n");
+
         ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
 
         for (int i = 0; i < topology->GetNumNodes(); i++) {
@@ -673,35 +696,190 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
-class ArbiterEcmpTooManyNodesTestCase : public ArbiterTestCase
+class ArbiterEcmpForwardingTableTestCase : public TestCase
 {
 public:
-    ArbiterEcmpTooManyNodesTestCase () : ArbiterTestCase ("routing-arbiter-ecmp too-many-nodes") {};
+    ArbiterEcmpForwardingTableTestCase () : TestCase ("routing-arbiter-ecmp forwarding-table") {};
     void DoRun () {
-        test_run_dir = ".tmp-test-routing-arbiter-ecmp-too-many-nodes";
+
+        // Three nodes
+        Ptr<ArbiterEcmpForwardingTable> table = CreateObject<ArbiterEcmpForwardingTable>(3);
+        ASSERT_EQUAL(table->GetNumNodes(), 3);
+        ASSERT_TRUE(table->IsUsingCompactNextHops());
+
+        // Cannot set candidates before allocation
+        ASSERT_EXCEPTION_MATCH_WHAT(table->SetCandidate(0, 1, 0, 1), "Cannot set a candidate before the ECMP forwarding table has been allocated");
+
+        // Counts
+        table->SetNumCandidates(0, 1, 1);
+        table->SetNumCandidates(0, 2, 2);
+        table->SetNumCandidates(2, 0, 1);
+        table->Allocate();
+        ASSERT_EXCEPTION_MATCH_WHAT(table->Allocate(), "ECMP forwarding table has already been allocated");
+        ASSERT_EXCEPTION_MATCH_WHAT(table->SetNumCandidates(1, 0, 1), "Cannot set the number of candidates after the ECMP forwarding table has been allocated");
+        ASSERT_EQUAL(table->GetTotalNumCandidates(), 4);
+        ASSERT_EQUAL(table->GetNumCandidates(0, 0), 0);
+        ASSERT_EQUAL(table->GetNumCandidates(0, 1), 1);
+        ASSERT_EQUAL(table->GetNumCandidates(0, 2), 2);
+        ASSERT_EQUAL(table->GetNumCandidates(1, 0), 0);
+        ASSERT_EQUAL(table->GetNumCandidates(1, 2), 0);
+        ASSERT_EQUAL(table->GetNumCandidates(2, 0), 1);
+        ASSERT_EQUAL(table->GetNumCandidates(2, 1), 0);
+
+        // Candidates
+        table->SetCandidate(0, 1, 0, 1);
+        table->SetCandidate(0, 2, 0, 1);
+        table->SetCandidate(0, 2, 1, 2);
+        table->SetCandidate(2, 0, 0, 0);
+        ASSERT_EXCEPTION(table->SetCandidate(0, 1, 1, 2));
+        ASSERT_EXCEPTION(table->SetCandidate(1, 0, 0, 0));
+        ASSERT_EQUAL(table->GetCandidate(0, 1, 0), 1);
+        ASSERT_EQUAL(table->GetCandidate(0, 2, 0), 1);
+        ASSERT_EQUAL(table->GetCandidate(0, 2, 1), 2);
+        ASSERT_EQUAL(table->GetCandidate(2, 0, 0), 0);
+        ASSERT_EQUAL(table->GetNumStoredNodes(), 3);
+
+        // Only the rows of nodes 0 and 2 stored
+        Ptr<ArbiterEcmpForwardingTable> partial_table = CreateObject<ArbiterEcmpForwardingTable>(3, std::vector<bool>({true, false, true}));
+        ASSERT_EQUAL(partial_table->GetNumStoredNodes(), 2);
+        ASSERT_TRUE(partial_table->IsStored(0));
+        ASSERT_FALSE(partial_table->IsStored(1));
+        ASSERT_TRUE(partial_table->IsStored(2));
+        partial_table->SetNumCandidates(0, 2, 2);
+        partial_table->SetNumCandidates(2, 0, 1);
+        ASSERT_EXCEPTION(partial_table->SetNumCandidates(1, 0, 1));
+        partial_table->Allocate();
+        ASSERT_EQUAL(partial_table->GetTotalNumCandidates(), 3);
+        partial_table->SetCandidate(0, 2, 0, 1);
+        partial_table->SetCandidate(0, 2, 1, 2);
+        partial_table->SetCandidate(2, 0, 0, 0);
+        ASSERT_EXCEPTION(partial_table->SetCandidate(1, 0, 0, 0));
+        ASSERT_EQUAL(partial_table->GetNumCandidates(0, 1), 0);
+        ASSERT_EQUAL(partial_table->GetNumCandidates(0, 2), 2);
+        ASSERT_EQUAL(partial_table->GetCandidate(0, 2, 1), 2);
+        ASSERT_EQUAL(partial_table->GetNumCandidates(2, 0), 1);
+        ASSERT_EQUAL(partial_table->GetCandidate(2, 0, 0), 0);
+
+        // Save to and load from a cache file
+        std::string cache_filename = "temp.ecmp_forwarding_table.bin";
+        partial_table->SaveToFile(cache_filename, 1234);
+        Ptr<ArbiterEcmpForwardingTable> loaded_table = CreateObject<ArbiterEcmpForwardingTable>(cache_filename, 1234);
+        ASSERT_TRUE(loaded_table->IsLoadedFromFile());
+        ASSERT_FALSE(partial_table->IsLoadedFromFile());
+        ASSERT_EQUAL(loaded_table->GetNumNodes(), 3);
+        ASSERT_EQUAL(loaded_table->GetNumStoredNodes(), 2);
+        ASSERT_EQUAL(loaded_table->GetTotalNumCandidates(), 3);
+        ASSERT_TRUE(loaded_table->IsUsingCompactNextHops());
+        ASSERT_TRUE(loaded_table->IsStored(0));
+        ASSERT_FALSE(loaded_table->IsStored(1));
+        for (int64_t a : {0, 2}) {
+            for (int64_t t = 0; t < 3; t++) {
+                ASSERT_EQUAL(loaded_table->GetNumCandidates(a, t), partial_table->GetNumCandidates(a, t));
+                for (uint32_t i = 0; i < partial_table->GetNumCandidates(a, t); i++) {
+                    ASSERT_EQUAL(loaded_table->GetCandidate(a, t, i), partial_table->GetCandidate(a, t, i));
+                }
+            }
+        }
+        ASSERT_EXCEPTION(loaded_table->SetCandidate(0, 2, 0, 1));
+        ASSERT_EXCEPTION_MATCH_WHAT(
+                CreateObject<ArbiterEcmpForwardingTable>(cache_filename, 4321),
+                "ECMP forwarding table cache file temp.ecmp_forwarding_table.bin cannot be used: its key does not match the inputs."
+        );
+
+        // Truncated or corrupt cache files are rejected when loading
+        // (layout for 3 nodes: header at 0, row starts at 48, node bases at 72, offsets at 104, next hops at 136)
+        std::ifstream cache_file(cache_filename, std::ios::binary);
+        std::string cache_content((std::istreambuf_iterator<char>(cache_file)), std::istreambuf_iterator<char>());
+        cache_file.close();
+        ASSERT_EQUAL(cache_content.size(), 144);
+        std::string corrupt_filename = "temp.ecmp_forwarding_table.corrupt.bin";
+        std::vector<std::pair<std::string, std::string>> corrupt_cases;
+        corrupt_cases.push_back(std::make_pair(cache_content.substr(0, 100), "its size does not match its header"));
+        std::string corrupt_row_start = cache_content;
+        corrupt_row_start[56] = 0; // Row start of the non-stored node 1 no longer -1
+        corrupt_cases.push_back(std::make_pair(corrupt_row_start, "its row starts are invalid"));
+        std::string corrupt_node_base = cache_content;
+        corrupt_node_base[96] = 100; // Node base of the end beyond the total number of candidates
+        corrupt_cases.push_back(std::make_pair(corrupt_node_base, "its node bases are invalid"));
+        std::string corrupt_offsets = cache_content;
+        corrupt_offsets[116] = 100; // End offset of the row of node 0 beyond its candidates
+        corrupt_cases.push_back(std::make_pair(corrupt_offsets, "its offsets are invalid"));
+        std::string corrupt_next_hop = cache_content;
+        corrupt_next_hop[136] = 7; // Next hop which is not a node
+        corrupt_cases.push_back(std::make_pair(corrupt_next_hop, "its next hops are invalid"));
+        for (const std::pair<std::string, std::string>& corrupt_case : corrupt_cases) {
+            std::ofstream corrupt_file(corrupt_filename, std::ios::binary);
+            corrupt_file.write(corrupt_case.first.data(), corrupt_case.first.size());
+            corrupt_file.close();
+            ASSERT_EXCEPTION_MATCH_WHAT(
+                    CreateObject<ArbiterEcmpForwardingTable>(corrupt_filename, 1234),
+                    "ECMP forwarding table cache file temp.ecmp_forwarding_table.corrupt.bin cannot be used: " + corrupt_case.second + "."
+            );
+        }
+        remove_file_if_exists(corrupt_filename);
+
+        remove_file_if_exists(cache_filename);
+        ASSERT_EXCEPTION(CreateObject<ArbiterEcmpForwardingTable>(cache_filename, 1234));
+
+        // Invalid number of nodes
+        ASSERT_EXCEPTION(CreateObject<ArbiterEcmpForwardingTable>(-1));
+        ASSERT_EXCEPTION(CreateObject<ArbiterEcmpForwardingTable>(3, std::vector<bool>({true, false})));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterEcmpMultiThreadedTestCase : public ArbiterTestCase
+{
+public:
+    ArbiterEcmpMultiThreadedTestCase () : ArbiterTestCase ("routing-arbiter-ecmp multi-threaded") {};
+    void DoRun () {
+        test_run_dir = ".tmp-test-routing-arbiter-ecmp-multi-threaded";
         prepare_clean_run_dir(test_run_dir);
-        prepare_arbiter_test_config();
 
-        // String for the nodes
-        std::string nodes = "set(";
-        for (int i = 0; i < 40001; i++) {
-            if (i != 0) {
-                nodes += "," + std::to_string(i);
-            } else {
-                nodes += std::to_string(i);
+        // Config file with multiple threads for the routing state calculation
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "arbiter_ecmp_num_threads=3" << std::endl;
+        config_file.close();
+
+        // 5x5 grid (nodes 0-24) and a separate pair (nodes 25-26)
+        int64_t num_nodes = 27;
+        std::vector<std::pair<int64_t, int64_t>> edges;
+        for (int64_t r = 0; r < 5; r++) {
+            for (int64_t c = 0; c < 5; c++) {
+                if (c < 4) {
+                    edges.push_back(std::make_pair(r * 5 + c, r * 5 + c + 1));
+                }
+                if (r < 4) {
+                    edges.push_back(std::make_pair(r * 5 + c, (r + 1) * 5 + c));
+                }
             }
         }
-        nodes += ")";
+        edges.push_back(std::make_pair(25, 26));
+        std::string nodes_str = "set(";
+        for (int64_t i = 0; i < num_nodes; i++) {
+            nodes_str += (i == 0 ? "" : ",") + std::to_string(i);
+        }
+        nodes_str += ")";
+        std::string edges_str = "set(";
+        for (size_t i = 0; i < edges.size(); i++) {
+            edges_str += (i == 0 ? "" : ",") + std::to_string(edges[i].first) + "-" + std::to_string(edges[i].second);
+        }
+        edges_str += ")";
 
-        // Topology with > 40000 nodes
+        // Topology file
         std::ofstream topology_file;
         topology_file.open (test_run_dir + "/topology.properties");
-        topology_file << "num_nodes=40001" << std::endl;
-        topology_file << "num_undirected_edges=0" << std::endl;
-        topology_file << "switches=" << nodes << std::endl;
-        topology_file << "switches_which_are_tors=" << nodes << std::endl;
+        topology_file << "num_nodes=" << num_nodes << std::endl;
+        topology_file << "num_undirected_edges=" << edges.size() << std::endl;
+        topology_file << "switches=" << nodes_str << std::endl;
+        topology_file << "switches_which_are_tors=" << nodes_str << std::endl;
         topology_file << "servers=set()" << std::endl;
-        topology_file << "undirected_edges=set()" << std::endl;
+        topology_file << "undirected_edges=" << edges_str << std::endl;
         topology_file << "link_channel_delay_ns=10000" << std::endl;
         topology_file << "link_net_device_data_rate_megabit_per_s=100" << std::endl;
         topology_file << "link_net_device_queue=drop_tail(100p)" << std::endl;
@@ -709,10 +887,51 @@ public:
         topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
         topology_file.close();
 
-        // Create topology
+        // Create topology and install the arbiters
         Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
         Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
-        ASSERT_EXCEPTION(ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology));
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+
+        // Reference shortest path distances using Floyd-Warshall
+        std::vector<std::vector<int64_t>> dist(num_nodes, std::vector<int64_t>(num_nodes, 100000000));
+        for (int64_t i = 0; i < num_nodes; i++) {
+            dist[i][i] = 0;
+        }
+        for (std::pair<int64_t, int64_t> edge : edges) {
+            dist[edge.first][edge.second] = 1;
+            dist[edge.second][edge.first] = 1;
+        }
+        for (int64_t k = 0; k < num_nodes; k++) {
+            for (int64_t i = 0; i < num_nodes; i++) {
+                for (int64_t j = 0; j < num_nodes; j++) {
+                    dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+                }
+            }
+        }
+
+        // Every node must have exactly the reference candidate next hops in ascending order
+        for (int64_t i = 0; i < num_nodes; i++) {
+            std::ostringstream expected;
+            expected << "ECMP state of node " << i << std::endl;
+            for (int64_t j = 0; j < num_nodes; j++) {
+                expected << "  -> " << j << ": {";
+                bool first = true;
+                for (int64_t neighbor_id : topology->GetAdjacencyList(i)) {
+                    if (dist[i][j] - 1 == dist[neighbor_id][j]) {
+                        if (!first) {
+                            expected << ",";
+                        }
+                        expected << neighbor_id;
+                        first = false;
+                    }
+                }
+                expected << "}" << std::endl;
+            }
+            ASSERT_EQUAL(
+                    topology->GetNodes().Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->StringReprOfForwardingState(),
+                    expected.str()
+            );
+        }
 
         // Clean-up
         basicSimulation->Finalize();
@@ -798,6 +1017,321 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class ArbiterEcmpFlowCacheTestCase : public ArbiterTestCase
+{
+public:
+    ArbiterEcmpFlowCacheTestCase () : ArbiterTestCase ("routing-arbiter-ecmp flow-cache") {};
+
+    // Returns the (decided, expected) next hop of a TCP packet from node 0 to node 2
+    std::pair<int32_t, int32_t> decide_tcp(Ptr<ArbiterEcmp> arbiter, uint16_t src_port, uint16_t dst_port) {
+        Ipv4Header ipHeader;
+        ipHeader.SetSource(Ipv4Address("10.0.0.1")); // Interface of node 0
+        ipHeader.SetDestination(Ipv4Address("10.0.2.2")); // Interface of node 2
+        ipHeader.SetProtocol(6);
+        Ptr<Packet> p = Create<Packet>(100);
+        TcpHeader tcpHeader;
+        tcpHeader.SetSourcePort(src_port);
+        tcpHeader.SetDestinationPort(dst_port);
+        p->AddHeader(tcpHeader);
+
+        // Without cache, the next hop out of {1,3} is selected by the hash
+        int32_t expected = arbiter->ComputeFiveTupleHash(ipHeader, p, 0, false) % 2 == 0 ? 1 : 3;
+        return std::make_pair(arbiter->TopologyPtopDecide(0, 2, std::set<int64_t>(), p, ipHeader, false), expected);
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-routing-arbiter-ecmp-flow-cache";
+        prepare_clean_run_dir(test_run_dir);
+
+        // Config file with a flow cache of only one entry
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "arbiter_ecmp_flow_cache_size=1" << std::endl;
+        config_file.close();
+        prepare_arbiter_test_default_topology();
+
+        // Create topology
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        Ptr<ArbiterEcmp> arbiter = topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->GetObject<ArbiterEcmp>();
+        ASSERT_EQUAL(arbiter->GetFlowCacheSize(), 1);
+
+        // First packet of a flow is a miss, subsequent ones are hits until another flow evicts it
+        std::pair<int32_t, int32_t> first = decide_tcp(arbiter, 24245, 222);
+        ASSERT_EQUAL(first.first, first.second);
+        ASSERT_EQUAL(arbiter->GetFlowCacheHits(), 0);
+        ASSERT_EQUAL(arbiter->GetFlowCacheMisses(), 1);
+        ASSERT_EQUAL(decide_tcp(arbiter, 24245, 222).first, first.second);
+        ASSERT_EQUAL(decide_tcp(arbiter, 24245, 222).first, first.second);
+        ASSERT_EQUAL(arbiter->GetFlowCacheHits(), 2);
+        ASSERT_EQUAL(arbiter->GetFlowCacheMisses(), 1);
+        std::set<int32_t> next_hops;
+        for (uint16_t port = 1000; port < 1100; port++) {
+            std::pair<int32_t, int32_t> other = decide_tcp(arbiter, port, 222);
+            ASSERT_EQUAL(other.first, other.second);
+            next_hops.insert(other.first);
+        }
+        ASSERT_EQUAL(next_hops.size(), 2);
+        ASSERT_EQUAL(arbiter->GetFlowCacheHits(), 2);
+        ASSERT_EQUAL(arbiter->GetFlowCacheMisses(), 101);
+        ASSERT_EQUAL(decide_tcp(arbiter, 24245, 222).first, first.second);
+        ASSERT_EQUAL(arbiter->GetFlowCacheMisses(), 102);
+
+        // No candidates is still an error every time (the failed decision is not cached)
+        Ipv4Header ipHeader;
+        ipHeader.SetSource(Ipv4Address("10.0.0.1"));
+        ipHeader.SetDestination(Ipv4Address("10.0.0.1"));
+        ipHeader.SetProtocol(17);
+        Ptr<Packet> p = Create<Packet>(100);
+        UdpHeader udpHeader;
+        udpHeader.SetSourcePort(1234);
+        udpHeader.SetDestinationPort(5678);
+        p->AddHeader(udpHeader);
+        ASSERT_EXCEPTION(arbiter->TopologyPtopDecide(0, 0, std::set<int64_t>(), p, ipHeader, false));
+        ASSERT_EXCEPTION(arbiter->TopologyPtopDecide(0, 0, std::set<int64_t>(), p, ipHeader, false));
+
+        // Counters are written per node
+        ArbiterEcmpHelper::WriteFlowCacheResults(basicSimulation, topology);
+        std::vector<std::string> lines = read_file_direct(test_run_dir + "/logs_ns3/arbiter_ecmp_flow_cache.csv");
+        ASSERT_EQUAL(lines.size(), 4);
+        ASSERT_EQUAL(lines[0], "0,1,2,104");
+        ASSERT_EQUAL(lines[1], "1,1,0,0");
+        ASSERT_EQUAL(lines[2], "2,1,0,0");
+        ASSERT_EQUAL(lines[3], "3,1,0,0");
+
+        // Clean-up
+        basicSimulation->Finalize();
+        remove_file_if_exists(test_run_dir + "/logs_ns3/arbiter_ecmp_flow_cache.csv");
+        cleanup_arbiter_test();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterEcmpFlowTagTestCase : public ArbiterTestCase
+{
+public:
+    ArbiterEcmpFlowTagTestCase () : ArbiterTestCase ("routing-arbiter-ecmp flow-tag") {};
+
+    Ptr<Packet> create_tcp_packet(uint16_t src_port, uint16_t dst_port) {
+        Ptr<Packet> p = Create<Packet>(100);
+        TcpHeader tcpHeader;
+        tcpHeader.SetSourcePort(src_port);
+        tcpHeader.SetDestinationPort(dst_port);
+        p->AddHeader(tcpHeader);
+        return p;
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-routing-arbiter-ecmp-flow-tag";
+        prepare_clean_run_dir(test_run_dir);
+
+        // Config file with the flow tag enabled
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "arbiter_ecmp_enable_flow_tag=true" << std::endl;
+        config_file.close();
+        prepare_arbiter_test_default_topology();
+
+        // Create topology
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        std::vector<Ptr<ArbiterEcmp>> arbiters;
+        for (int i = 0; i < 4; i++) {
+            arbiters.push_back(topology->GetNodes().Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->GetObject<ArbiterEcmp>());
+            ASSERT_TRUE(arbiters[i]->IsFlowTagEnabled());
+        }
+
+        // IP header from node 0 to node 2
+        Ipv4Header ipHeader;
+        ipHeader.SetSource(Ipv4Address("10.0.0.1"));
+        ipHeader.SetDestination(Ipv4Address("10.0.2.2"));
+        ipHeader.SetProtocol(6);
+
+        // The tag is attached on the sender with the ports of the TCP header
+        Ptr<Packet> p = create_tcp_packet(24245, 222);
+        arbiters[0]->TagOutgoingPacket(p, ipHeader);
+        ArbiterEcmpFlowTag flowTag;
+        ASSERT_TRUE(p->PeekPacketTag(flowTag));
+        ASSERT_EQUAL(flowTag.GetSourcePort(), 24245);
+        ASSERT_EQUAL(flowTag.GetDestinationPort(), 222);
+
+        // Attaching it again (e.g., the same packet sent again) replaces it
+        arbiters[0]->TagOutgoingPacket(p, ipHeader);
+        ASSERT_TRUE(p->PeekPacketTag(flowTag));
+        ASSERT_EQUAL(flowTag.GetSourcePort(), 24245);
+
+        // The hashes (and as such decisions) at every node are the same as without tag
+        for (uint16_t port = 1000; port < 1050; port++) {
+            Ptr<Packet> untagged = create_tcp_packet(port, 80);
+            Ptr<Packet> tagged = create_tcp_packet(port, 80);
+            arbiters[0]->TagOutgoingPacket(tagged, ipHeader);
+            for (int i = 0; i < 4; i++) {
+                ASSERT_EQUAL(
+                        arbiters[i]->ComputeFiveTupleHash(ipHeader, tagged, i, false),
+                        arbiters[i]->ComputeFiveTupleHash(ipHeader, untagged, i, false)
+                );
+            }
+            ASSERT_EQUAL(
+                    arbiters[0]->TopologyPtopDecide(0, 2, std::set<int64_t>(), tagged, ipHeader, false),
+                    arbiters[0]->ComputeFiveTupleHash(ipHeader, untagged, 0, false) % 2 == 0 ? 1 : 3
+            );
+        }
+
+        // The next hops read the ports from the tag rather than from the header
+        Ptr<Packet> mismatch = create_tcp_packet(1, 2);
+        mismatch->AddPacketTag(flowTag);
+        ASSERT_EQUAL(
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, mismatch, 1, false),
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, p, 1, false)
+        );
+
+        // Enabling the flow cache after the tag keeps the tag enabled and in use
+        arbiters[1]->EnableFlowCache(16);
+        ASSERT_TRUE(arbiters[1]->IsFlowTagEnabled());
+        ASSERT_EQUAL(
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, mismatch, 1, false),
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, p, 1, false)
+        );
+        ASSERT_NOT_EQUAL(
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, mismatch, 1, false),
+                arbiters[1]->ComputeFiveTupleHash(ipHeader, create_tcp_packet(1, 2), 1, false)
+        );
+
+        // A request for the source IP has no other header, so no tag
+        Ipv4Header requestHeader;
+        requestHeader.SetSource(Ipv4Address("102.102.102.102"));
+        requestHeader.SetDestination(Ipv4Address("10.0.2.2"));
+        requestHeader.SetProtocol(6);
+        Ptr<Packet> request = Create<Packet>(0);
+        arbiters[0]->TagOutgoingPacket(request, requestHeader);
+        ASSERT_FALSE(request->PeekPacketTag(flowTag));
+
+        // Clean-up
+        basicSimulation->Finalize();
+        cleanup_arbiter_test();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterEcmpDistanceLabelsTestCase : public ArbiterTestCase
+{
+public:
+    ArbiterEcmpDistanceLabelsTestCase () : ArbiterTestCase ("routing-arbiter-ecmp distance-labels") {};
+    void DoRun () {
+        test_run_dir = ".tmp-test-routing-arbiter-ecmp-distance-labels";
+        prepare_clean_run_dir(test_run_dir);
+
+        // Config file with the distance labels mode
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=10000000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "arbiter_ecmp_mode=distance_labels" << std::endl;
+        config_file << "arbiter_ecmp_num_threads=2" << std::endl;
+        config_file.close();
+
+        // Leaf-spine with two spines (0, 1), two ToRs (2, 3),
+        // single-homed servers (4, 5 under ToR 2 and 6 under ToR 3) and a dual-homed server (7)
+        int64_t num_nodes = 8;
+        std::vector<std::pair<int64_t, int64_t>> edges = {{0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 4}, {2, 5}, {2, 7}, {3, 6}, {3, 7}};
+        std::ofstream topology_file;
+        topology_file.open (test_run_dir + "/topology.properties");
+        topology_file << "num_nodes=8" << std::endl;
+        topology_file << "num_undirected_edges=9" << std::endl;
+        topology_file << "switches=set(0,1,2,3)" << std::endl;
+        topology_file << "switches_which_are_tors=set(2,3)" << std::endl;
+        topology_file << "servers=set(4,5,6,7)" << std::endl;
+        topology_file << "undirected_edges=set(0-2,0-3,1-2,1-3,2-4,2-5,2-7,3-6,3-7)" << std::endl;
+        topology_file << "link_channel_delay_ns=10000" << std::endl;
+        topology_file << "link_net_device_data_rate_megabit_per_s=100" << std::endl;
+        topology_file << "link_net_device_queue=drop_tail(100p)" << std::endl;
+        topology_file << "link_net_device_receive_error_model=none" << std::endl;
+        topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+        topology_file.close();
+
+        // Create topology and install the arbiters
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(test_run_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+
+        // Reference shortest path distances using Floyd-Warshall
+        std::vector<std::vector<int64_t>> dist(num_nodes, std::vector<int64_t>(num_nodes, 100000000));
+        for (int64_t i = 0; i < num_nodes; i++) {
+            dist[i][i] = 0;
+        }
+        for (std::pair<int64_t, int64_t> edge : edges) {
+            dist[edge.first][edge.second] = 1;
+            dist[edge.second][edge.first] = 1;
+        }
+        for (int64_t k = 0; k < num_nodes; k++) {
+            for (int64_t i = 0; i < num_nodes; i++) {
+                for (int64_t j = 0; j < num_nodes; j++) {
+                    dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+                }
+            }
+        }
+
+        // The derived candidates towards each destination (only servers) must be the same as the reference
+        for (int64_t i = 0; i < num_nodes; i++) {
+            std::ostringstream expected;
+            expected << "ECMP state of node " << i << std::endl;
+            for (int64_t j = 4; j < num_nodes; j++) {
+                expected << "  -> " << j << ": {";
+                bool first = true;
+                for (int64_t neighbor_id : topology->GetAdjacencyList(i)) {
+                    if (dist[i][j] - 1 == dist[neighbor_id][j]) {
+                        if (!first) {
+                            expected << ",";
+                        }
+                        expected << neighbor_id;
+                        first = false;
+                    }
+                }
+                expected << "}" << std::endl;
+            }
+            ASSERT_EQUAL(
+                    topology->GetNodes().Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->StringReprOfForwardingState(),
+                    expected.str()
+            );
+        }
+
+        // Single-homed servers share the label of their ToR
+        Ptr<ArbiterEcmpDistanceLabels> labels = CreateObject<ArbiterEcmpDistanceLabels>(
+                num_nodes,
+                std::vector<int64_t>({0, 2, 4, 9, 13, 14, 15, 16, 18}),
+                std::vector<uint32_t>({2, 3, 2, 3, 0, 1, 4, 5, 7, 0, 1, 6, 7, 2, 2, 3, 2, 3}),
+                topology->GetEndpoints(),
+                topology->GetServers()
+        );
+        ASSERT_EQUAL(labels->GetNumLabels(), 3);
+        ASSERT_EQUAL(labels->GetLabelNodeId(0), 2);
+        ASSERT_EQUAL(labels->GetLabelNodeId(1), 3);
+        ASSERT_EQUAL(labels->GetLabelNodeId(2), 7);
+        ASSERT_TRUE(labels->IsDestination(4));
+        ASSERT_FALSE(labels->IsDestination(0));
+        ASSERT_EXCEPTION_MATCH_WHAT(labels->GetNumCandidates(4, 0), "Node 0 is not a destination in the ECMP distance labels");
+        ASSERT_EXCEPTION(labels->SetDistance(0, 0, 255));
+        ASSERT_EXCEPTION(labels->SetDistance(0, 0, -1));
+
+        // Clean-up
+        basicSimulation->Finalize();
+        cleanup_arbiter_test();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class Ipv4ArbiterRoutingNoRouteTestCase : public TestCaseWithLogValidators
 {
 public:
@@ -891,6 +1425,7 @@ public:
         remove_file_if_exists(run_test_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flow_servers.csv");
         remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flow_0_progress.csv");
         remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flow_0_rtt.csv");
         remove_file_if_exists(run_test_dir + "/logs_ns3/tcp_flow_0_rto.csv");
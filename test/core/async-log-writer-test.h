@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class AsyncLogWriterTestCase : public TestCaseWithLogValidators {
+public:
+    AsyncLogWriterTestCase() : TestCaseWithLogValidators("async-log-writer basic") {};
+    const std::string temp_dir = ".tmp-test-async-log-writer";
+
+    void DoRun() {
+        prepare_clean_run_dir(temp_dir);
+
+        // Small buffer such that many chunks are handed over to the background thread
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>(100);
+        ASSERT_EQUAL(writer->GetBufferSizeByte(), 100);
+        int64_t handle_a = writer->Open(temp_dir + "/a.csv", false);
+        int64_t handle_b = writer->Open(temp_dir + "/b.csv", false);
+        ASSERT_EQUAL(handle_a, 0);
+        ASSERT_EQUAL(handle_b, 1);
+        ASSERT_EQUAL(writer->GetNumFiles(), 2);
+
+        // Interleaved writing
+        char line[64];
+        for (int i = 0; i < 10000; i++) {
+            int length = snprintf(line, sizeof(line), "%d,%d\n", i, 2 * i);
+            writer->Write(i % 3 == 0 ? handle_a : handle_b, line, length);
+        }
+
+        // After flush everything is there and in order
+        writer->Flush();
+        std::vector<std::string> lines_a = read_file_direct(temp_dir + "/a.csv");
+        std::vector<std::string> lines_b = read_file_direct(temp_dir + "/b.csv");
+        ASSERT_EQUAL(lines_a.size(), 3334);
+        ASSERT_EQUAL(lines_b.size(), 6666);
+        for (int i = 0, j_a = 0, j_b = 0; i < 10000; i++) {
+            if (i % 3 == 0) {
+                ASSERT_EQUAL(lines_a[j_a++], std::to_string(i) + "," + std::to_string(2 * i));
+            } else {
+                ASSERT_EQUAL(lines_b[j_b++], std::to_string(i) + "," + std::to_string(2 * i));
+            }
+        }
+
+        // Can write again and close multiple times
+        writer->Write(handle_a, "x\n", 2);
+        writer->Close();
+        writer->Close();
+        lines_a = read_file_direct(temp_dir + "/a.csv");
+        ASSERT_EQUAL(lines_a.size(), 3335);
+        ASSERT_EQUAL(lines_a[3334], "x");
+        ASSERT_EXCEPTION(writer->Open(temp_dir + "/c.csv", false));
+
+        // Appending to an existing file, closed upon release
+        writer = CreateObject<AsyncLogWriter>();
+        writer->Write(writer->Open(temp_dir + "/a.csv", true), "y\n", 2);
+        writer = 0;
+        lines_a = read_file_direct(temp_dir + "/a.csv");
+        ASSERT_EQUAL(lines_a.size(), 3336);
+        ASSERT_EQUAL(lines_a[3335], "y");
+
+        // More files written to than can be open at a time, each closed individually
+        writer = CreateObject<AsyncLogWriter>(10, 2);
+        ASSERT_EQUAL(writer->GetMaxOpenFiles(), 2);
+        std::vector<int64_t> handles;
+        for (int f = 0; f < 5; f++) {
+            handles.push_back(writer->Open(temp_dir + "/many-" + std::to_string(f) + ".csv", false));
+        }
+        for (int i = 0; i < 1000; i++) {
+            int length = snprintf(line, sizeof(line), "%d\n", i);
+            writer->Write(handles[i % 5], line, length);
+        }
+        writer->CloseFile(handles[4]);
+        writer->CloseFile(handles[4]);
+        ASSERT_EXCEPTION(writer->Write(handles[4], "z\n", 2));
+        writer->Flush();
+        for (int f = 0; f < 5; f++) {
+            std::vector<std::string> lines = read_file_direct(temp_dir + "/many-" + std::to_string(f) + ".csv");
+            ASSERT_EQUAL(lines.size(), 200);
+            for (int j = 0; j < 200; j++) {
+                ASSERT_EQUAL(lines[j], std::to_string(j * 5 + f));
+            }
+        }
+        writer->Close();
+
+        // Invalid
+        ASSERT_EXCEPTION(CreateObject<AsyncLogWriter>(0));
+        ASSERT_EXCEPTION(CreateObject<AsyncLogWriter>(100, 0));
+        writer = CreateObject<AsyncLogWriter>();
+        ASSERT_EXCEPTION(writer->Open(temp_dir + "/does-not-exist/a.csv", false));
+
+        remove_file_if_exists(temp_dir + "/a.csv");
+        remove_file_if_exists(temp_dir + "/b.csv");
+        for (int f = 0; f < 5; f++) {
+            remove_file_if_exists(temp_dir + "/many-" + std::to_string(f) + ".csv");
+        }
+        remove_dir_if_exists(temp_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
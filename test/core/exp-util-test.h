@@ -403,4 +403,98 @@ public:
     }
 };
 
+class ExpUtilInPlaceParsingTestCase : public TestCase {
+public:
+    ExpUtilInPlaceParsingTestCase() : TestCase("exp-util in-place-parsing") {};
+
+    int64_t in_place_int64(const std::string& str) {
+        return parse_int64(str.data(), str.data() + str.size());
+    }
+
+    int64_t in_place_positive_int64(const std::string& str) {
+        return parse_positive_int64(str.data(), str.data() + str.size());
+    }
+
+    double in_place_positive_double(const std::string& str) {
+        return parse_positive_double(str.data(), str.data() + str.size());
+    }
+
+    void DoRun() {
+
+        // Split in place
+        std::string line = "a,,bc, d,";
+        std::vector<std::pair<const char*, const char*>> fields;
+        split_string_in_place(line.data(), line.data() + line.size(), ',', 5, fields);
+        ASSERT_EQUAL(fields.size(), 5);
+        ASSERT_EQUAL(std::string(fields[0].first, fields[0].second), "a");
+        ASSERT_EQUAL(std::string(fields[1].first, fields[1].second), "");
+        ASSERT_EQUAL(std::string(fields[2].first, fields[2].second), "bc");
+        ASSERT_EQUAL(std::string(fields[3].first, fields[3].second), " d");
+        ASSERT_EQUAL(std::string(fields[4].first, fields[4].second), "");
+        ASSERT_EXCEPTION(split_string_in_place(line.data(), line.data() + line.size(), ',', 4, fields));
+        ASSERT_EXCEPTION(split_string_in_place(line.data(), line.data() + line.size(), ',', 6, fields));
+        line = "";
+        split_string_in_place(line.data(), line.data(), ',', 1, fields);
+        ASSERT_EQUAL(fields.size(), 1);
+
+        // Same results as the string parsing
+        for (std::string str : std::vector<std::string>({"0", "1", "-1", "5848484", " -5848484 ", "+7", "\t12\n", "9223372036854775807", "-9223372036854775808"})) {
+            ASSERT_EQUAL(in_place_int64(str), parse_int64(str));
+        }
+        for (std::string str : std::vector<std::string>({"", " ", "-", "3.5", "5e-1", "1 2", "0x10", "a", "--1"})) {
+            ASSERT_EXCEPTION(in_place_int64(str));
+            ASSERT_EXCEPTION(parse_int64(str));
+        }
+        ASSERT_EXCEPTION(in_place_int64("9223372036854775808"));
+        ASSERT_EXCEPTION(in_place_int64("-9223372036854775809"));
+        ASSERT_EQUAL(in_place_positive_int64("4 "), 4);
+        ASSERT_EQUAL(in_place_positive_int64("-0"), 0);
+        ASSERT_EXCEPTION(in_place_positive_int64("-6"));
+        for (std::string str : std::vector<std::string>({"0.0", "-0.0", "6.89", "99", " 6.89", "5e-1", "100.000000000000000000000000000000000000000000000000000000000000000001"})) {
+            ASSERT_EQUAL(in_place_positive_double(str), parse_positive_double(str));
+        }
+        for (std::string str : std::vector<std::string>({"", "abc", "58.2abc", "-0.00001", "-8888", "1e999"})) {
+            ASSERT_EXCEPTION(in_place_positive_double(str));
+            ASSERT_EXCEPTION(parse_positive_double(str));
+        }
+
+        // Mapped file lines are the same as getline() would give
+        remove_file_if_exists("temp.file");
+        std::ofstream the_file;
+        the_file.open("temp.file");
+        the_file << "0,1,2" << std::endl;
+        the_file << std::endl;
+        the_file << " x ,y" << std::endl;
+        the_file << "last";
+        the_file.close();
+        std::vector<std::string> lines;
+        const char* line_begin;
+        const char* line_end;
+        {
+            MappedFileLineReader reader("temp.file");
+            while (reader.NextLine(line_begin, line_end)) {
+                lines.push_back(std::string(line_begin, line_end));
+            }
+        }
+        ASSERT_EQUAL(lines.size(), 4);
+        ASSERT_EQUAL(lines[0], "0,1,2");
+        ASSERT_EQUAL(lines[1], "");
+        ASSERT_EQUAL(lines[2], " x ,y");
+        ASSERT_EQUAL(lines[3], "last");
+
+        // Empty file has no lines
+        the_file.open("temp.file");
+        the_file.close();
+        {
+            MappedFileLineReader reader("temp.file");
+            ASSERT_FALSE(reader.NextLine(line_begin, line_end));
+        }
+        remove_file_if_exists("temp.file");
+
+        // File does not exist
+        ASSERT_EXCEPTION(MappedFileLineReader("temp.file"));
+
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GraphPartitionerLookaheadTestCase : public TestCase {
+public:
+    GraphPartitionerLookaheadTestCase() : TestCase("graph-partitioner lookahead") {};
+
+    void DoRun() {
+
+        // Two clusters of three nodes, with low delay within and high delay between:
+        //
+        // 0 - 1 - 2 ===== 3 - 4 - 5
+        //
+        std::vector<std::pair<int64_t, int64_t>> edges = {
+                std::make_pair(0, 1), std::make_pair(1, 2), std::make_pair(2, 3),
+                std::make_pair(3, 4), std::make_pair(4, 5)
+        };
+        std::vector<double> weights = {100.0, 100.0, 1.0, 100.0, 100.0};
+        std::vector<int64_t> delays_ns = {1000, 1000, 50000, 1000, 1000};
+        std::vector<int64_t> assignment = partition_graph(6, edges, weights, delays_ns, 2, 0.0);
+        ASSERT_EQUAL(assignment.size(), 6);
+        ASSERT_EQUAL(assignment[0], assignment[1]);
+        ASSERT_EQUAL(assignment[1], assignment[2]);
+        ASSERT_EQUAL(assignment[3], assignment[4]);
+        ASSERT_EQUAL(assignment[4], assignment[5]);
+        ASSERT_NOT_EQUAL(assignment[2], assignment[3]);
+        ASSERT_EQUAL(calculate_partition_lookahead_ns(assignment, edges, delays_ns), 50000);
+        ASSERT_EQUAL(calculate_partition_cut_weight(assignment, edges, weights), 1.0);
+
+        // Single part
+        assignment = partition_graph(6, edges, weights, delays_ns, 1, 0.0);
+        for (int64_t system_id : assignment) {
+            ASSERT_EQUAL(system_id, 0);
+        }
+        ASSERT_EQUAL(calculate_partition_lookahead_ns(assignment, edges, delays_ns), -1);
+        ASSERT_EQUAL(calculate_partition_cut_weight(assignment, edges, weights), 0.0);
+
+        // Three parts: a cluster cannot be kept whole, so the lookahead drops to the low delay
+        assignment = partition_graph(6, edges, weights, delays_ns, 3, 0.0);
+        std::vector<int64_t> part_size(3, 0);
+        for (int64_t system_id : assignment) {
+            ASSERT_TRUE(system_id >= 0 && system_id < 3);
+            part_size[system_id]++;
+        }
+        ASSERT_EQUAL(part_size[0], 2);
+        ASSERT_EQUAL(part_size[1], 2);
+        ASSERT_EQUAL(part_size[2], 2);
+        ASSERT_EQUAL(calculate_partition_lookahead_ns(assignment, edges, delays_ns), 1000);
+
+        // Three pairs with low delay within: each pair fits in a part, but three pairs cannot
+        // be packed into two parts of three, so the lookahead drops instead of the balance
+        //
+        // 0 - 1 ===== 2 - 3 ===== 4 - 5
+        //
+        std::vector<int64_t> pair_delays_ns = {1000, 50000, 1000, 50000, 1000};
+        assignment = partition_graph(6, edges, weights, pair_delays_ns, 2, 0.0);
+        part_size = std::vector<int64_t>(2, 0);
+        for (int64_t system_id : assignment) {
+            ASSERT_TRUE(system_id >= 0 && system_id < 2);
+            part_size[system_id]++;
+        }
+        ASSERT_EQUAL(part_size[0], 3);
+        ASSERT_EQUAL(part_size[1], 3);
+        ASSERT_EQUAL(calculate_partition_lookahead_ns(assignment, edges, pair_delays_ns), 1000);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GraphPartitionerBalanceTestCase : public TestCase {
+public:
+    GraphPartitionerBalanceTestCase() : TestCase("graph-partitioner balance") {};
+
+    void DoRun() {
+
+        // Ring of 20 nodes with equal delay and weight
+        std::vector<std::pair<int64_t, int64_t>> edges;
+        std::vector<double> weights;
+        std::vector<int64_t> delays_ns;
+        for (int64_t i = 0; i < 20; i++) {
+            edges.push_back(std::make_pair(std::min(i, (i + 1) % 20), std::max(i, (i + 1) % 20)));
+            weights.push_back(10.0);
+            delays_ns.push_back(10000);
+        }
+        for (int64_t k = 1; k <= 5; k++) {
+            std::vector<int64_t> assignment = partition_graph(20, edges, weights, delays_ns, k, 0.1);
+            std::vector<int64_t> part_size(k, 0);
+            for (int64_t system_id : assignment) {
+                ASSERT_TRUE(system_id >= 0 && system_id < k);
+                part_size[system_id]++;
+            }
+            for (int64_t size : part_size) {
+                ASSERT_TRUE(size >= 1);
+                ASSERT_TRUE(size <= (int64_t) std::floor(1.1 * 20.0 / k));
+            }
+
+            // Deterministic
+            ASSERT_TRUE(assignment == partition_graph(20, edges, weights, delays_ns, k, 0.1));
+
+        }
+
+        // Each node its own part
+        std::vector<int64_t> assignment = partition_graph(20, edges, weights, delays_ns, 20, 0.0);
+        std::set<int64_t> distinct(assignment.begin(), assignment.end());
+        ASSERT_EQUAL(distinct.size(), 20);
+
+        // Disconnected nodes
+        assignment = partition_graph(4, {}, {}, {}, 2, 0.0);
+        ASSERT_EQUAL(std::count(assignment.begin(), assignment.end(), 0), 2);
+        ASSERT_EQUAL(std::count(assignment.begin(), assignment.end(), 1), 2);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GraphPartitionerInvalidTestCase : public TestCase {
+public:
+    GraphPartitionerInvalidTestCase() : TestCase("graph-partitioner invalid") {};
+
+    void DoRun() {
+        std::vector<std::pair<int64_t, int64_t>> edges = {std::make_pair(0, 1)};
+        ASSERT_EXCEPTION(partition_graph(2, edges, {1.0}, {100}, 3, 0.1)); // More parts than nodes
+        ASSERT_EXCEPTION(partition_graph(2, edges, {1.0}, {100}, 0, 0.1)); // Zero parts
+        ASSERT_EXCEPTION(partition_graph(2, edges, {1.0}, {100}, 2, -0.1)); // Negative imbalance
+        ASSERT_EXCEPTION(partition_graph(2, edges, {1.0, 2.0}, {100}, 2, 0.1)); // Too many weights
+        ASSERT_EXCEPTION(partition_graph(2, edges, {1.0}, {}, 2, 0.1)); // Too few delays
+        ASSERT_EXCEPTION(partition_graph(2, {std::make_pair(0, 2)}, {1.0}, {100}, 2, 0.1)); // Non-existent node
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LatencySketchBasicTestCase : public TestCase {
+public:
+    LatencySketchBasicTestCase() : TestCase("latency-sketch basic") {};
+
+    void DoRun() {
+
+        // Nothing added
+        LatencySketch sketch;
+        ASSERT_EQUAL(sketch.GetRelativeAccuracy(), LatencySketch::DEFAULT_RELATIVE_ACCURACY);
+        ASSERT_EQUAL(sketch.GetCount(), 0);
+        ASSERT_EQUAL(sketch.GetQuantile(0.5), -1);
+        ASSERT_EQUAL(sketch.GetBuckets().size(), 0);
+
+        // One value
+        sketch.Add(12345);
+        ASSERT_EQUAL(sketch.GetCount(), 1);
+        ASSERT_EQUAL(sketch.GetQuantile(0.0), 12345);
+        ASSERT_EQUAL(sketch.GetQuantile(0.5), 12345);
+        ASSERT_EQUAL(sketch.GetQuantile(1.0), 12345);
+
+        // Compare against the exact quantiles of a wide range of values
+        std::vector<int64_t> values = {12345, 0, 0};
+        for (int64_t i = 0; i < 20000; i++) {
+            values.push_back((i * 7919) % 100003 + (i % 10 == 0 ? 5000000000 : 1000));
+        }
+        for (size_t i = 1; i < values.size(); i++) {
+            sketch.Add(values.at(i));
+        }
+        std::sort(values.begin(), values.end());
+        ASSERT_EQUAL(sketch.GetCount(), (int64_t) values.size());
+        std::vector<double> quantiles = {0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 1.0};
+        for (double q : quantiles) {
+            int64_t exact = values.at((size_t) (q * (values.size() - 1)));
+            int64_t estimate = sketch.GetQuantile(q);
+            ASSERT_TRUE(std::abs(estimate - exact) <= exact * LatencySketch::DEFAULT_RELATIVE_ACCURACY + 1);
+        }
+        ASSERT_EQUAL(sketch.GetQuantile(0.0), 0);
+        ASSERT_EQUAL(sketch.GetQuantile(1.0), values.back());
+
+        // Buckets are ascending and their counts add up
+        uint64_t total = 0;
+        int32_t prev_bucket = -2;
+        for (std::pair<int32_t, uint64_t> bucket : sketch.GetBuckets()) {
+            ASSERT_TRUE(bucket.first > prev_bucket);
+            ASSERT_TRUE(bucket.second > 0);
+            prev_bucket = bucket.first;
+            total += bucket.second;
+        }
+        ASSERT_EQUAL(total, values.size());
+        ASSERT_EQUAL(sketch.GetBucketValue(-1), 0);
+
+        // Invalid
+        ASSERT_EXCEPTION(sketch.Add(-1));
+        ASSERT_EXCEPTION(sketch.GetQuantile(-0.1));
+        ASSERT_EXCEPTION(sketch.GetQuantile(1.1));
+        ASSERT_EXCEPTION(LatencySketch(0.0));
+        ASSERT_EXCEPTION(LatencySketch(1.0));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LatencySketchMergeTestCase : public TestCase {
+public:
+    LatencySketchMergeTestCase() : TestCase("latency-sketch merge") {};
+
+    void DoRun() {
+
+        // Merging the sketches of parts is the same as adding all values to one
+        LatencySketch all;
+        LatencySketch part_a;
+        LatencySketch part_b;
+        LatencySketch part_empty;
+        for (int64_t i = 0; i < 5000; i++) {
+            int64_t value = (i * 7919) % 1000003;
+            all.Add(value);
+            if (i % 3 == 0) {
+                part_a.Add(value);
+            } else {
+                part_b.Add(value);
+            }
+        }
+        LatencySketch merged;
+        merged.Merge(part_empty);
+        merged.Merge(part_a);
+        merged.Merge(part_empty);
+        merged.Merge(part_b);
+        ASSERT_EQUAL(merged.GetCount(), all.GetCount());
+        ASSERT_TRUE(merged.GetBuckets() == all.GetBuckets());
+        std::vector<double> quantiles = {0.0, 0.5, 0.9, 0.99, 0.999, 1.0};
+        for (double q : quantiles) {
+            ASSERT_EQUAL(merged.GetQuantile(q), all.GetQuantile(q));
+        }
+
+        // Sketches with a different accuracy cannot be merged
+        LatencySketch coarse(0.05);
+        ASSERT_EXCEPTION(merged.Merge(coarse));
+
+        // Written to file as bucket, count and bucket value
+        mkdir_if_not_exists("test_latency_sketch");
+        merged.WriteToFile("test_latency_sketch/sketch.csv");
+        std::vector<std::string> lines = read_file_direct("test_latency_sketch/sketch.csv");
+        std::vector<std::pair<int32_t, uint64_t>> buckets = merged.GetBuckets();
+        ASSERT_EQUAL(lines.size(), buckets.size());
+        for (size_t i = 0; i < lines.size(); i++) {
+            std::vector<std::string> line_spl = split_string(lines.at(i), ",", 3);
+            ASSERT_EQUAL(parse_int64(line_spl[0]), buckets.at(i).first);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[1]), (int64_t) buckets.at(i).second);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[2]), merged.GetBucketValue(buckets.at(i).first));
+        }
+        remove_file_if_exists("test_latency_sketch/sketch.csv");
+        remove_dir_if_exists("test_latency_sketch");
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+std::string read_file_binary(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+int64_t decode_int64_little_endian(const std::string& data, size_t offset, size_t length) {
+    if (offset + length > data.size()) {
+        throw std::runtime_error("Unexpected end of data");
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; i++) {
+        value |= ((uint64_t) (unsigned char) data[offset + i]) << (8 * i);
+    }
+    return (int64_t) value;
+}
+
+/**
+ * Decode a binary or columnar log into its column names and rows.
+ */
+std::pair<std::vector<std::string>, std::vector<std::vector<int64_t>>> decode_binary_log(const std::string& data) {
+    std::string magic = data.substr(0, 4);
+    size_t offset = 4;
+    if (decode_int64_little_endian(data, offset, 4) != 1) {
+        throw std::runtime_error("Unexpected version");
+    }
+    size_t num_columns = decode_int64_little_endian(data, offset + 4, 4);
+    offset += 8;
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < num_columns; i++) {
+        size_t name_length = decode_int64_little_endian(data, offset, 4);
+        columns.push_back(data.substr(offset + 4, name_length));
+        offset += 4 + name_length;
+    }
+    std::vector<std::vector<int64_t>> rows;
+    while (offset < data.size()) {
+        if (magic == "BSLB") {
+            std::vector<int64_t> row;
+            for (size_t i = 0; i < num_columns; i++) {
+                row.push_back(decode_int64_little_endian(data, offset, 8));
+                offset += 8;
+            }
+            rows.push_back(row);
+        } else if (magic == "BSLC") {
+            size_t num_rows = decode_int64_little_endian(data, offset, 4);
+            offset += 4;
+            size_t first_row = rows.size();
+            rows.resize(first_row + num_rows, std::vector<int64_t>(num_columns));
+            for (size_t i = 0; i < num_columns; i++) {
+                for (size_t j = 0; j < num_rows; j++) {
+                    rows[first_row + j][i] = decode_int64_little_endian(data, offset, 8);
+                    offset += 8;
+                }
+            }
+        } else {
+            throw std::runtime_error("Unknown magic: " + magic);
+        }
+    }
+    return std::make_pair(columns, rows);
+}
+
+class LogOutputSinkFormatsTestCase : public TestCaseWithLogValidators {
+public:
+    LogOutputSinkFormatsTestCase() : TestCaseWithLogValidators("log-output-sink formats") {};
+    const std::string temp_dir = ".tmp-test-log-output-sink";
+
+    void DoRun() {
+        prepare_clean_run_dir(temp_dir);
+
+        // Parsing of the format and its filename
+        ASSERT_EQUAL(parse_log_output_format("csv"), LOG_OUTPUT_FORMAT_CSV);
+        ASSERT_EQUAL(parse_log_output_format("binary"), LOG_OUTPUT_FORMAT_BINARY);
+        ASSERT_EQUAL(parse_log_output_format("columnar"), LOG_OUTPUT_FORMAT_COLUMNAR);
+        ASSERT_EXCEPTION(parse_log_output_format("Binary"));
+        ASSERT_EXCEPTION(parse_log_output_format(""));
+        ASSERT_EQUAL(get_log_output_filename("a/b.csv", LOG_OUTPUT_FORMAT_CSV), "a/b.csv");
+        ASSERT_EQUAL(get_log_output_filename("a/b.csv", LOG_OUTPUT_FORMAT_BINARY), "a/b.bin");
+        ASSERT_EQUAL(get_log_output_filename("a/b.csv", LOG_OUTPUT_FORMAT_COLUMNAR), "a/b.col");
+        ASSERT_EQUAL(get_log_output_filename("a/b", LOG_OUTPUT_FORMAT_BINARY), "a/b.bin");
+
+        // Records to write, including the extremes
+        std::vector<std::vector<int64_t>> records;
+        for (int64_t i = 0; i < 10000; i++) {
+            records.push_back({i % 7, i * 1000000, -i});
+        }
+        records.push_back({INT64_MIN, INT64_MAX, 0});
+        std::vector<std::string> columns = {"from_node_id", "timestamp_ns", "value"};
+
+        // Write all formats with one shared writer, the columnar one with small chunks
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>(1000);
+        Ptr<LogOutputSink> sink_csv = CreateLogOutputSink(LOG_OUTPUT_FORMAT_CSV, writer, temp_dir + "/log.csv", columns);
+        Ptr<LogOutputSink> sink_binary = CreateLogOutputSink(LOG_OUTPUT_FORMAT_BINARY, writer, temp_dir + "/log.csv", columns);
+        Ptr<LogOutputSink> sink_columnar = CreateObject<LogOutputSinkColumnar>(writer, temp_dir + "/log.col", columns, 3000);
+        ASSERT_EQUAL(sink_binary->GetFilename(), temp_dir + "/log.bin");
+        ASSERT_EQUAL(sink_columnar->GetFilename(), temp_dir + "/log.col");
+        for (const std::vector<int64_t>& record : records) {
+            sink_csv->WriteRecord(record.data());
+            sink_binary->WriteRecord(record.data());
+            sink_columnar->WriteRecord(record.data());
+        }
+        ASSERT_EQUAL(sink_csv->GetNumRecords(), 10001);
+        ASSERT_EQUAL(sink_columnar->GetNumRecords(), 10001);
+        sink_csv->Close();
+        sink_binary->Close();
+        sink_columnar->Close();
+        sink_columnar->Close();
+        writer->Close();
+
+        // Cannot write after closing
+        ASSERT_EXCEPTION(sink_binary->WriteRecord(records.at(0).data()));
+
+        // CSV
+        std::vector<std::string> lines = read_file_direct(temp_dir + "/log.csv");
+        ASSERT_EQUAL(lines.size(), 10001);
+        for (size_t i = 0; i < records.size(); i++) {
+            ASSERT_EQUAL(lines.at(i), std::to_string(records[i][0]) + "," + std::to_string(records[i][1]) + "," + std::to_string(records[i][2]));
+        }
+
+        // Binary and columnar
+        std::string data_binary = read_file_binary(temp_dir + "/log.bin");
+        std::string data_columnar = read_file_binary(temp_dir + "/log.col");
+        size_t header_size = 4 + 4 + 4 + (4 + 12) + (4 + 12) + (4 + 5);
+        ASSERT_EQUAL(data_binary.size(), header_size + 10001 * 24);
+        ASSERT_EQUAL(data_columnar.size(), header_size + 4 * 4 + 10001 * 24);
+        std::pair<std::vector<std::string>, std::vector<std::vector<int64_t>>> decoded_binary = decode_binary_log(data_binary);
+        std::pair<std::vector<std::string>, std::vector<std::vector<int64_t>>> decoded_columnar = decode_binary_log(data_columnar);
+        ASSERT_TRUE(decoded_binary.first == columns);
+        ASSERT_TRUE(decoded_columnar.first == columns);
+        ASSERT_TRUE(decoded_binary.second == records);
+        ASSERT_TRUE(decoded_columnar.second == records);
+
+        // Invalid
+        ASSERT_EXCEPTION(CreateLogOutputSink(LOG_OUTPUT_FORMAT_CSV, writer, temp_dir + "/log.csv", columns)); // Writer closed
+        ASSERT_EXCEPTION(CreateLogOutputSink(LOG_OUTPUT_FORMAT_CSV, 0, temp_dir + "/log.csv", {}));
+        ASSERT_EXCEPTION(CreateObject<LogOutputSinkColumnar>(Ptr<AsyncLogWriter>(0), temp_dir + "/log.col", columns, 0));
+
+        remove_file_if_exists(temp_dir + "/log.csv");
+        remove_file_if_exists(temp_dir + "/log.bin");
+        remove_file_if_exists(temp_dir + "/log.col");
+        remove_dir_if_exists(temp_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LogOutputSinkLogUpdateHelperTestCase : public TestCaseWithLogValidators {
+public:
+    LogOutputSinkLogUpdateHelperTestCase() : TestCaseWithLogValidators("log-output-sink log-update-helper") {};
+    const std::string temp_dir = ".tmp-test-log-output-sink-log-update-helper";
+
+    void DoRun() {
+        prepare_clean_run_dir(temp_dir);
+
+        // Same updates to a file stream and to a sink with its own writer
+        LogUpdateHelper<int64_t> helper_stream(false, true, temp_dir + "/stream.csv", "7,");
+        LogUpdateHelper<int64_t> helper_sink(false, CreateLogOutputSink(LOG_OUTPUT_FORMAT_COLUMNAR, 0, temp_dir + "/sink.csv", {"id", "time_ns", "value"}), {7});
+        std::vector<int64_t> values = {1, 1, 2, 2, 2, 3, 1, 1};
+        for (size_t i = 0; i < values.size(); i++) {
+            helper_stream.Update(i * 10, values[i]);
+            helper_sink.Update(i * 10, values[i]);
+        }
+        helper_stream.Finalize(100);
+        helper_sink.Finalize(100);
+
+        // Both must be the same
+        std::vector<std::string> lines = read_file_direct(temp_dir + "/stream.csv");
+        std::vector<std::vector<int64_t>> rows = decode_binary_log(read_file_binary(temp_dir + "/sink.col")).second;
+        ASSERT_EQUAL(lines.size(), 5);
+        ASSERT_EQUAL(rows.size(), 5);
+        for (size_t i = 0; i < lines.size(); i++) {
+            ASSERT_EQUAL(lines.at(i), std::to_string(rows[i][0]) + "," + std::to_string(rows[i][1]) + "," + std::to_string(rows[i][2]));
+        }
+
+        // Sink must have the columns of the prefix, time and value
+        ASSERT_EXCEPTION(LogUpdateHelper<int64_t>(false, CreateLogOutputSink(LOG_OUTPUT_FORMAT_CSV, 0, temp_dir + "/invalid.csv", {"time_ns", "value"}), {7}));
+
+        remove_file_if_exists(temp_dir + "/stream.csv");
+        remove_file_if_exists(temp_dir + "/sink.col");
+        remove_file_if_exists(temp_dir + "/invalid.csv");
+        remove_dir_if_exists(temp_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -716,3 +716,76 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
+
+class LogUpdateHelperStreamingTestCase : public TestCaseWithLogValidators {
+public:
+    LogUpdateHelperStreamingTestCase() : TestCaseWithLogValidators("log-update-helper streaming") {};
+    const std::string temp_dir = ".tmp-test-log-update-helper-streaming";
+
+    void DoRun() {
+        prepare_clean_run_dir(temp_dir);
+
+        // Updates with a lot of value changes
+        std::vector<std::pair<int64_t, int64_t>> updates;
+        int64_t value = 0;
+        for (int64_t t = 0; t < 1000; t += 3) {
+            value = (value * 7 + t) % 5;
+            updates.push_back(std::make_pair(t, value));
+        }
+
+        // In-memory reference
+        LogUpdateHelper<int64_t> reference;
+        for (std::pair<int64_t, int64_t> u : updates) {
+            reference.Update(u.first, u.second);
+        }
+        std::vector<std::tuple<int64_t, int64_t, int64_t>> expected = reference.Finalize(2000);
+        ASSERT_TRUE(expected.size() > 100);
+
+        for (int64_t max_intervals_in_memory : std::vector<int64_t>({1, 2, 7, 100000})) {
+
+            // Two logs interleaved in the same spill file
+            Ptr<IntervalLogSpill> spill = CreateObject<IntervalLogSpill>(temp_dir + "/spill.bin");
+            LogUpdateHelper<int64_t> helper_a(spill, max_intervals_in_memory);
+            LogUpdateHelper<int64_t> helper_b(spill, max_intervals_in_memory);
+            ASSERT_EQUAL(helper_a.GetSpillStreamId(), 0);
+            ASSERT_EQUAL(helper_b.GetSpillStreamId(), 1);
+            for (std::pair<int64_t, int64_t> u : updates) {
+                helper_a.Update(u.first, u.second);
+                helper_b.Update(u.first, u.second + 10);
+                ASSERT_TRUE(helper_a.GetNumIntervalsInMemory() < max_intervals_in_memory);
+            }
+            ASSERT_EQUAL(helper_a.Finalize(2000).size(), 0);
+            ASSERT_EQUAL(helper_b.Finalize(2000).size(), 0);
+            ASSERT_EQUAL(spill->GetNumSpilledIntervals(), 2 * expected.size());
+
+            // Read back each stream in order
+            Ptr<LogOutputSink> sink = CreateLogOutputSink(LOG_OUTPUT_FORMAT_CSV, 0, temp_dir + "/out.csv", {"id", "interval_start_ns", "interval_end_ns", "value"});
+            spill->WriteStream(1, sink, {1});
+            spill->WriteStream(0, sink, {0});
+            sink->Close();
+            std::vector<std::string> lines = read_file_direct(temp_dir + "/out.csv");
+            ASSERT_EQUAL(lines.size(), 2 * expected.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                std::string interval = std::to_string(std::get<0>(expected[i])) + "," + std::to_string(std::get<1>(expected[i]));
+                ASSERT_EQUAL(lines[i], "1," + interval + "," + std::to_string(std::get<2>(expected[i]) + 10));
+                ASSERT_EQUAL(lines[expected.size() + i], "0," + interval + "," + std::to_string(std::get<2>(expected[i])));
+            }
+
+            // Spill file is removed afterwards
+            spill->Remove();
+            ASSERT_FALSE(file_exists(temp_dir + "/spill.bin"));
+            ASSERT_EXCEPTION(spill->WriteStream(0, sink, {0}));
+            remove_file_if_exists(temp_dir + "/out.csv");
+
+        }
+
+        // At least one interval must be kept in memory
+        Ptr<IntervalLogSpill> spill = CreateObject<IntervalLogSpill>(temp_dir + "/spill.bin");
+        ASSERT_EXCEPTION(LogUpdateHelper<int64_t>(spill, 0));
+        spill->Remove();
+
+        remove_dir_if_exists(temp_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -581,6 +581,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
@@ -836,6 +837,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/timing_results.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/udp_bursts_outgoing.txt");
@@ -1012,6 +1014,7 @@ public:
         remove_file_if_exists(test_run_dir + "/logs_ns3/link_interface_tc_qdisc_queue_pkt.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.csv");
         remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_servers.csv");
         for (int64_t i : tcp_flow_ids_with_logging) {
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv");
             remove_file_if_exists(test_run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_rtt.csv");
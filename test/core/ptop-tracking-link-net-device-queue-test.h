@@ -228,6 +228,69 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class PtopTrackingLinkNetDeviceQueueStreamingTestCase : public PtopTrackingLinkNetDeviceQueueBaseTestCase
+{
+public:
+    PtopTrackingLinkNetDeviceQueueStreamingTestCase () : PtopTrackingLinkNetDeviceQueueBaseTestCase ("ptop-tracking-link-net-device-queue streaming") {};
+
+    void write_configuration(int64_t max_intervals_in_memory) {
+        write_basic_config("all");
+        std::ofstream config_file(test_run_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "link_net_device_queue_tracking_max_intervals_in_memory=" << max_intervals_in_memory << std::endl;
+        config_file.close();
+        write_four_side_topology();
+        std::ofstream udp_burst_schedule_file;
+        udp_burst_schedule_file.open(test_run_dir + "/udp_burst_schedule.csv");
+        udp_burst_schedule_file << "0,0,1,50,0,500000000,," << std::endl;
+        udp_burst_schedule_file << "1,2,3,90,250000000,500000000,," << std::endl;
+        udp_burst_schedule_file << "2,3,1,120,250000000,5000000000,," << std::endl;
+        udp_burst_schedule_file.close();
+    }
+
+    void DoRun () {
+        test_run_dir = ".tmp-test-ptop-tracking-link-net-device-queue-streaming";
+
+        // In memory
+        prepare_clean_run_dir(test_run_dir);
+        write_configuration(0);
+        run_default();
+        std::vector<std::string> in_memory_pkt = read_file_direct(test_run_dir + "/logs_ns3/link_net_device_queue_pkt.csv");
+        std::vector<std::string> in_memory_byte = read_file_direct(test_run_dir + "/logs_ns3/link_net_device_queue_byte.csv");
+        cleanup();
+
+        // Streaming with only a few intervals in memory at a time
+        prepare_clean_run_dir(test_run_dir);
+        write_configuration(2);
+        run_default();
+
+        // Validate logs
+        std::vector <std::pair<int64_t, int64_t>> dir_a_b_list;
+        dir_a_b_list.push_back(std::make_pair(0, 1));
+        dir_a_b_list.push_back(std::make_pair(1, 0));
+        dir_a_b_list.push_back(std::make_pair(0, 2));
+        dir_a_b_list.push_back(std::make_pair(2, 0));
+        dir_a_b_list.push_back(std::make_pair(1, 3));
+        dir_a_b_list.push_back(std::make_pair(3, 1));
+        dir_a_b_list.push_back(std::make_pair(3, 2));
+        dir_a_b_list.push_back(std::make_pair(2, 3));
+        std::map<std::pair<int64_t, int64_t>, std::vector<std::tuple<int64_t, int64_t, int64_t>>> link_net_device_queue_pkt;
+        std::map<std::pair<int64_t, int64_t>, std::vector<std::tuple<int64_t, int64_t, int64_t>>> link_net_device_queue_byte;
+        validate_link_net_device_queue_logs(test_run_dir, dir_a_b_list, link_net_device_queue_pkt, link_net_device_queue_byte);
+
+        // Streaming must yield exactly the same log files, and the spill file must be gone
+        ASSERT_TRUE(in_memory_pkt.size() > 2 * dir_a_b_list.size());
+        ASSERT_TRUE(in_memory_pkt == read_file_direct(test_run_dir + "/logs_ns3/link_net_device_queue_pkt.csv"));
+        ASSERT_TRUE(in_memory_byte == read_file_direct(test_run_dir + "/logs_ns3/link_net_device_queue_byte.csv"));
+        ASSERT_FALSE(file_exists(test_run_dir + "/logs_ns3/link_net_device_queue_spill.bin"));
+
+        // Clean up
+        cleanup();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class PtopTrackingLinkNetDeviceQueueNotEnabledTestCase : public TestCaseWithLogValidators
 {
 public:
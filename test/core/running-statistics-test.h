@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class RunningStatisticsBasicTestCase : public TestCase {
+public:
+    RunningStatisticsBasicTestCase() : TestCase("running-statistics basic") {};
+
+    void DoRun() {
+
+        // Nothing added
+        RunningStatistics statistics;
+        ASSERT_EQUAL(statistics.GetCount(), 0);
+        ASSERT_EQUAL(statistics.GetMin(), -1);
+        ASSERT_EQUAL(statistics.GetMax(), -1);
+        ASSERT_EQUAL(statistics.GetMean(), -1);
+        ASSERT_EQUAL(statistics.GetSampleStd(), -1);
+
+        // One value
+        statistics.Add(500);
+        ASSERT_EQUAL(statistics.GetCount(), 1);
+        ASSERT_EQUAL(statistics.GetMin(), 500);
+        ASSERT_EQUAL(statistics.GetMax(), 500);
+        ASSERT_EQUAL(statistics.GetMean(), 500);
+        ASSERT_EQUAL(statistics.GetSampleStd(), 0);
+
+        // Compare against the two-pass calculation
+        std::vector<int64_t> values = {500, 1000, 250, 3000000, 42, 42, 999999, 0, 7};
+        for (size_t i = 1; i < values.size(); i++) {
+            statistics.Add(values.at(i));
+        }
+        double sum = 0.0;
+        for (int64_t value : values) {
+            sum += value;
+        }
+        double mean = sum / values.size();
+        double sum_sq = 0.0;
+        for (int64_t value : values) {
+            sum_sq += std::pow(value - mean, 2);
+        }
+        ASSERT_EQUAL(statistics.GetCount(), 9);
+        ASSERT_EQUAL(statistics.GetMin(), 0);
+        ASSERT_EQUAL(statistics.GetMax(), 3000000);
+        ASSERT_EQUAL_APPROX(statistics.GetMean(), mean, 0.000001);
+        ASSERT_EQUAL_APPROX(statistics.GetSampleStd(), std::sqrt(sum_sq / (values.size() - 1)), 0.000001);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class RunningStatisticsMergeTestCase : public TestCase {
+public:
+    RunningStatisticsMergeTestCase() : TestCase("running-statistics merge") {};
+
+    void DoRun() {
+
+        // Merging the statistics of parts is the same as adding all values to one
+        RunningStatistics all;
+        RunningStatistics part_a;
+        RunningStatistics part_b;
+        RunningStatistics part_empty;
+        for (int64_t i = 0; i < 1000; i++) {
+            int64_t value = (i * 7919) % 1013;
+            all.Add(value);
+            if (i < 300) {
+                part_a.Add(value);
+            } else {
+                part_b.Add(value);
+            }
+        }
+        RunningStatistics merged;
+        merged.Merge(part_empty);
+        merged.Merge(part_a);
+        merged.Merge(part_empty);
+        merged.Merge(part_b);
+        ASSERT_EQUAL(merged.GetCount(), all.GetCount());
+        ASSERT_EQUAL(merged.GetMin(), all.GetMin());
+        ASSERT_EQUAL(merged.GetMax(), all.GetMax());
+        ASSERT_EQUAL_APPROX(merged.GetMean(), all.GetMean(), 0.000001);
+        ASSERT_EQUAL_APPROX(merged.GetSampleStd(), all.GetSampleStd(), 0.000001);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@ void TestCaseWithLogValidators::prepare_clean_run_dir(std::string run_dir) {
 
         // TCP flow remnants
         remove_file_if_exists(run_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(run_dir + "/logs_ns3/tcp_flow_servers.csv");
         remove_file_if_exists(run_dir + "/logs_ns3/tcp_flows.csv");
         for (size_t i = 0; i < 1000; i++) {
             if (!file_exists(run_dir + "/logs_ns3/tcp_flow_" + std::to_string(i) + "_progress.csv")) {
@@ -57,6 +58,7 @@ void TestCaseWithLogValidators::prepare_clean_run_dir(std::string run_dir) {
         remove_file_if_exists(run_dir + "/logs_ns3/udp_bursts_outgoing.csv");
         remove_file_if_exists(run_dir + "/logs_ns3/udp_bursts_incoming.txt");
         remove_file_if_exists(run_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(run_dir + "/logs_ns3/udp_bursts_one_way_latency_sketch.csv");
         for (size_t i = 0; i < 1000; i++) {
             if (!file_exists(run_dir + "/logs_ns3/udp_burst_" + std::to_string(i) + "_outgoing.csv")) {
                 break; // We stop this long loop once there is one not present
@@ -68,6 +70,8 @@ void TestCaseWithLogValidators::prepare_clean_run_dir(std::string run_dir) {
         // UDP ping remnants
         remove_file_if_exists(run_dir + "/logs_ns3/udp_pings.txt");
         remove_file_if_exists(run_dir + "/logs_ns3/udp_pings.csv");
+        remove_file_if_exists(run_dir + "/logs_ns3/udp_pings_summary.csv");
+        remove_file_if_exists(run_dir + "/logs_ns3/udp_pings_rtt_sketch.csv");
 
         // Topology link interface traffic control queueing discipline queue
         remove_file_if_exists(run_dir + "/logs_ns3/link_interface_tc_qdisc_queue_pkt.csv");
@@ -917,10 +921,12 @@ void TestCaseWithLogValidators::validate_udp_burst_logs(
     // Check udp_bursts_incoming.csv
     std::vector<std::string> lines_incoming_csv = read_file_direct(run_dir + "/logs_ns3/udp_bursts_incoming.csv");
     ASSERT_EQUAL(lines_incoming_csv.size(), udp_burst_schedule.size());
+    std::vector<double> one_way_latency_quantiles = {0.5, 0.9, 0.99, 0.999};
+    std::vector<std::vector<int64_t>> udp_burst_one_way_latency_percentiles;
     i = 0;
     for (std::string line : lines_incoming_csv) {
         std::vector<std::string> line_spl = split_string(line, ",");
-        ASSERT_EQUAL(line_spl.size(), 12);
+        ASSERT_EQUAL(line_spl.size(), 16);
         ASSERT_EQUAL(parse_positive_int64(line_spl[0]), i);
         ASSERT_EQUAL(parse_positive_int64(line_spl[1]), udp_burst_schedule[i].GetFromNodeId());
         ASSERT_EQUAL(parse_positive_int64(line_spl[2]), udp_burst_schedule[i].GetToNodeId());
@@ -937,7 +943,18 @@ void TestCaseWithLogValidators::validate_udp_burst_logs(
         ASSERT_EQUAL(incoming_received_incl_headers_byte, received_packets * 1500);
         ASSERT_TRUE(incoming_rate_payload_megabit_per_s >= incoming_rate_incl_headers_megabit_per_s * 0.9);
         ASSERT_TRUE(incoming_rate_incl_headers_megabit_per_s >= incoming_rate_payload_megabit_per_s);
-        ASSERT_EQUAL(line_spl[11], udp_burst_schedule[i].GetMetadata());
+        std::vector<int64_t> percentiles;
+        for (size_t q = 0; q < one_way_latency_quantiles.size(); q++) {
+            percentiles.push_back(parse_int64(line_spl[11 + q]));
+            if (received_packets == 0) {
+                ASSERT_EQUAL(percentiles.at(q), -1);
+            } else {
+                ASSERT_TRUE(percentiles.at(q) >= 0);
+                ASSERT_TRUE(q == 0 || percentiles.at(q) >= percentiles.at(q - 1));
+            }
+        }
+        udp_burst_one_way_latency_percentiles.push_back(percentiles);
+        ASSERT_EQUAL(line_spl[15], udp_burst_schedule[i].GetMetadata());
         list_incoming_rate_megabit_per_s.push_back(incoming_rate_incl_headers_megabit_per_s);
         i++;
     }
@@ -1055,6 +1072,7 @@ void TestCaseWithLogValidators::validate_udp_burst_logs(
             std::vector<std::string> lines_precise_incoming_csv = read_file_direct(run_dir + "/logs_ns3/udp_burst_" + std::to_string(entry.GetUdpBurstId()) + "_incoming.csv");
             ASSERT_EQUAL(lines_precise_incoming_csv.size(), (size_t) udp_burst_received_amount.at(entry.GetUdpBurstId()));
             std::set<int64_t> already_seen_seqs;
+            std::vector<int64_t> one_way_latencies_ns;
             int prev_timestamp_ns = 0;
             for (std::string line : lines_precise_incoming_csv) {
                 std::vector <std::string> line_spl = split_string(line, ",");
@@ -1072,6 +1090,17 @@ void TestCaseWithLogValidators::validate_udp_burst_logs(
                 int64_t timestamp = parse_positive_int64(line_spl[2]);
                 ASSERT_TRUE(timestamp >= prev_timestamp_ns);
                 prev_timestamp_ns = timestamp;
+
+                // One-way latency of the packet
+                one_way_latencies_ns.push_back(timestamp - (int64_t) (entry.GetStartTimeNs() + seq * std::ceil(1500.0 / (entry.GetTargetRateMegabitPerSec() / 8000.0))));
+            }
+
+            // The one-way latency percentiles must be within the accuracy of the sketch
+            std::sort(one_way_latencies_ns.begin(), one_way_latencies_ns.end());
+            for (size_t q = 0; q < one_way_latency_quantiles.size() && one_way_latencies_ns.size() > 0; q++) {
+                int64_t exact_ns = one_way_latencies_ns.at((size_t) (one_way_latency_quantiles.at(q) * (one_way_latencies_ns.size() - 1)));
+                int64_t percentile_ns = udp_burst_one_way_latency_percentiles.at(entry.GetUdpBurstId()).at(q);
+                ASSERT_TRUE(std::abs(percentile_ns - exact_ns) <= exact_ns * LatencySketch::DEFAULT_RELATIVE_ACCURACY + 1);
             }
 
         }
@@ -1168,6 +1197,10 @@ void TestCaseWithLogValidators::validate_udp_ping_logs(
     }
     ASSERT_EQUAL(i, udp_ping_schedule.size());
 
+    // Check udp_pings_summary.csv
+    std::vector<std::string> lines_summary_csv = read_file_direct(run_dir + "/logs_ns3/udp_pings_summary.csv");
+    ASSERT_EQUAL(lines_summary_csv.size(), udp_ping_schedule.size());
+
     // Check udp_pings.txt
     std::vector<std::string> lines_txt = read_file_direct(run_dir + "/logs_ns3/udp_pings.txt");
     ASSERT_EQUAL(
@@ -1272,6 +1305,36 @@ void TestCaseWithLogValidators::validate_udp_ping_logs(
         ASSERT_EQUAL(line_spl[18], std::to_string(list_rtt_ns_valid.at(j).size()) + "/" + std::to_string(list_rtt_ns.at(j).size()));
         ASSERT_EQUAL(line_spl[19], "(" + std::to_string((int) std::round(((double) list_rtt_ns_valid.at(j).size() / (double) list_rtt_ns.at(j).size()) * 100.0)) + "%)");
 
+        // Match the summary with the above calculated statistics
+        std::vector<std::string> summary_spl = split_string(lines_summary_csv.at(j), ",", 19);
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[0]), udp_ping_schedule.at(j).GetUdpPingId());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[1]), udp_ping_schedule.at(j).GetFromNodeId());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[2]), udp_ping_schedule.at(j).GetToNodeId());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[3]), udp_ping_schedule.at(j).GetStartTimeNs());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[4]), udp_ping_schedule.at(j).GetDurationNs());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[5]), udp_ping_schedule.at(j).GetIntervalNs());
+        ASSERT_EQUAL_APPROX(parse_double(summary_spl[6]), expected_mean_latency_there, 1.0);
+        ASSERT_EQUAL_APPROX(parse_double(summary_spl[7]), expected_mean_latency_back, 1.0);
+        ASSERT_EQUAL(parse_int64(summary_spl[8]), min_rtt_ns);
+        ASSERT_EQUAL_APPROX(parse_double(summary_spl[9]), mean_rtt_ns, 1.0);
+        ASSERT_EQUAL(parse_int64(summary_spl[10]), max_rtt_ns);
+        ASSERT_EQUAL_APPROX(parse_double(summary_spl[11]), sample_std_rtt_ns, 1.0);
+        std::vector<int64_t> sorted_rtts_ns = list_rtt_ns_valid.at(j);
+        std::sort(sorted_rtts_ns.begin(), sorted_rtts_ns.end());
+        std::vector<double> quantiles = {0.5, 0.9, 0.99, 0.999};
+        for (size_t q = 0; q < quantiles.size(); q++) {
+            int64_t percentile_rtt_ns = parse_int64(summary_spl[12 + q]);
+            if (any_valid) {
+                int64_t exact_rtt_ns = sorted_rtts_ns.at((size_t) (quantiles.at(q) * (sorted_rtts_ns.size() - 1)));
+                ASSERT_TRUE(std::abs(percentile_rtt_ns - exact_rtt_ns) <= exact_rtt_ns * LatencySketch::DEFAULT_RELATIVE_ACCURACY + 1);
+            } else {
+                ASSERT_EQUAL(percentile_rtt_ns, -1);
+            }
+        }
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[16]), (int64_t) list_rtt_ns_valid.at(j).size());
+        ASSERT_EQUAL(parse_positive_int64(summary_spl[17]), (int64_t) list_rtt_ns.at(j).size());
+        ASSERT_EQUAL(summary_spl[18], udp_ping_schedule.at(j).GetMetadata());
+
     }
     ASSERT_EQUAL(i - 1, udp_ping_schedule.size());
 
@@ -0,0 +1,88 @@
+import sys
+import struct
+
+
+def read_uint32(f):
+    data = f.read(4)
+    if len(data) == 0:
+        return None
+    if len(data) != 4:
+        raise ValueError("Unexpected end of file")
+    return struct.unpack("<I", data)[0]
+
+
+def read_int64s(f, count):
+    data = f.read(8 * count)
+    if len(data) != 8 * count:
+        raise ValueError("Unexpected end of file")
+    return struct.unpack("<%dq" % count, data)
+
+
+def read_header(f):
+    magic = f.read(4)
+    if magic not in (b"BSLB", b"BSLC"):
+        raise ValueError("Not a binary or columnar log (unknown magic: %s)" % str(magic))
+    version = read_uint32(f)
+    if version != 1:
+        raise ValueError("Unsupported log version: %s" % str(version))
+    num_columns = read_uint32(f)
+    columns = []
+    for i in range(num_columns):
+        name_length = read_uint32(f)
+        columns.append(f.read(name_length).decode("utf-8"))
+    return magic, columns
+
+
+def convert_log_to_csv(in_filename, out_filename):
+    with open(in_filename, "rb") as f_in, open(out_filename, "w+") as f_out:
+        magic, columns = read_header(f_in)
+        num_columns = len(columns)
+        num_records = 0
+
+        # Binary: one fixed-width record after the other
+        if magic == b"BSLB":
+            while True:
+                data = f_in.read(8 * num_columns)
+                if len(data) == 0:
+                    break
+                if len(data) != 8 * num_columns:
+                    raise ValueError("Unexpected end of file")
+                f_out.write(",".join(map(str, struct.unpack("<%dq" % num_columns, data))) + "\n")
+                num_records += 1
+
+        # Columnar: chunks of rows, stored column after column
+        else:
+            while True:
+                num_rows = read_uint32(f_in)
+                if num_rows is None:
+                    break
+                chunk_columns = []
+                for i in range(num_columns):
+                    chunk_columns.append(read_int64s(f_in, num_rows))
+                for row in zip(*chunk_columns):
+                    f_out.write(",".join(map(str, row)) + "\n")
+                num_records += num_rows
+
+    print("Converted %d records with columns (%s) to: %s" % (num_records, ",".join(columns), out_filename))
+
+
+def main():
+    args = sys.argv[1:]
+    if len(args) != 1 and len(args) != 2:
+        print("Must supply one or two arguments")
+        print("Usage: python3 convert_log_to_csv.py [in_filename (.bin or .col)] [out_filename (optional, "
+              "default: in_filename with .csv extension)]")
+        exit(1)
+    else:
+        in_filename = args[0]
+        if len(args) == 2:
+            out_filename = args[1]
+        elif in_filename.endswith(".bin") or in_filename.endswith(".col"):
+            out_filename = in_filename[:-4] + ".csv"
+        else:
+            out_filename = in_filename + ".csv"
+        convert_log_to_csv(in_filename, out_filename)
+
+
+if __name__ == "__main__":
+    main()
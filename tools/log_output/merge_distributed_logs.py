@@ -0,0 +1,174 @@
+import sys
+import os
+import re
+import heapq
+
+
+# Logs which are written per system in a distributed run, with for each:
+# (number of leading key fields by which each line is ordered, number of header lines)
+# Each key identifies an entity (flow, burst, ping, link) which is logged by exactly one system,
+# as such merging by it and keeping lines with equal keys in order yields the single-system log.
+# The UDP burst logs are keyed by burst ID alone: although the incoming bursts are registered
+# grouped by receiving endpoint, UdpBurstScheduler::WriteResults() sorts them by burst ID before
+# writing, in each system the same as in a single-system run.
+MERGEABLE_LOGS = {
+    "tcp_flows.csv": (1, 0),
+    "tcp_flows.txt": (1, 1),
+    "tcp_flow_servers.csv": (1, 0),
+    "udp_bursts_outgoing.csv": (1, 0),
+    "udp_bursts_outgoing.txt": (1, 1),
+    "udp_bursts_incoming.csv": (1, 0),
+    "udp_bursts_incoming.txt": (1, 1),
+    "udp_pings.csv": (1, 0),
+    "udp_pings.txt": (1, 1),
+    "udp_pings_summary.csv": (1, 0),
+    "link_net_device_utilization.csv": (2, 0),
+    "link_net_device_utilization_compressed.csv": (2, 0),
+    "link_net_device_utilization_compressed.txt": (2, 1),
+    "link_net_device_utilization_summary.txt": (2, 1),
+    "link_net_device_queue_pkt.csv": (2, 0),
+    "link_net_device_queue_byte.csv": (2, 0),
+    "link_interface_tc_qdisc_queue_pkt.csv": (2, 0),
+    "link_interface_tc_qdisc_queue_byte.csv": (2, 0),
+    "arbiter_ecmp_flow_cache.csv": (1, 0),
+}
+
+# Latency sketches which are written per system in a distributed run. Each line is a bucket:
+# [bucket],[count],[bucket value], and the single-system sketch is the sum of the counts per bucket.
+SUMMABLE_LOGS = {
+    "udp_pings_rtt_sketch.csv",
+    "udp_bursts_one_way_latency_sketch.csv",
+}
+
+
+def read_keyed_lines(filename, num_key_fields, num_header_lines, header_out):
+    """
+    Stream the lines of a per-system log, each paired with its key.
+    The header lines are not yielded, but placed in header_out.
+    """
+    is_csv = filename.endswith(".csv")
+    previous_key = None
+    with open(filename, "r") as f:
+        for i in range(num_header_lines):
+            header_out.append(f.readline())
+        for line in f:
+            fields = line.split(",", num_key_fields) if is_csv else line.split(None, num_key_fields)
+            if len(fields) < num_key_fields:
+                raise ValueError("Line has fewer than %d key fields in %s: %s" % (num_key_fields, filename, line))
+            key = tuple(int(x) for x in fields[:num_key_fields])
+            if previous_key is not None and key < previous_key:
+                raise ValueError("Lines are not ordered by their key in %s (%s after %s)" % (filename, key, previous_key))
+            previous_key = key
+            yield key, line
+
+
+def merge_log(in_filenames, out_filename, num_key_fields, num_header_lines):
+    """
+    K-way merge of the per-system logs (in order of system id) into a single log.
+    Only one line per input is kept in memory at a time.
+    """
+    headers = [[] for _ in in_filenames]
+    streams = [
+        read_keyed_lines(in_filename, num_key_fields, num_header_lines, headers[i])
+        for i, in_filename in enumerate(in_filenames)
+    ]
+    num_lines = 0
+    with open(out_filename, "w+") as f_out:
+        header_written = num_header_lines == 0
+        # Ties are resolved in order of the inputs, as such equal keys keep their relative order
+        for key, line in heapq.merge(*streams, key=lambda x: x[0]):
+            if not header_written:
+                f_out.writelines(headers[0])
+                header_written = True
+            f_out.write(line)
+            num_lines += 1
+        if not header_written:  # No lines at all, but the header must still be there
+            for i in range(len(in_filenames)):
+                if len(headers[i]) > 0:
+                    f_out.writelines(headers[i])
+                    break
+    return num_lines
+
+
+def sum_sketch(in_filenames, out_filename):
+    """
+    Merge of the per-system sketches into a single sketch by adding up the counts of equal buckets.
+    Only one line per input is kept in memory at a time.
+    """
+    streams = [read_keyed_lines(in_filename, 1, 0, []) for in_filename in in_filenames]
+    num_lines = 0
+    with open(out_filename, "w+") as f_out:
+        current_key = None
+        current_count = 0
+        current_value = None
+        for key, line in heapq.merge(*streams, key=lambda x: x[0]):
+            fields = line.strip().split(",")
+            if len(fields) != 3:
+                raise ValueError("Sketch line does not have three fields: %s" % line)
+            if key != current_key:
+                if current_key is not None:
+                    f_out.write("%d,%d,%s\n" % (current_key[0], current_count, current_value))
+                    num_lines += 1
+                current_key = key
+                current_count = 0
+                current_value = fields[2]
+            current_count += int(fields[1])
+        if current_key is not None:
+            f_out.write("%d,%d,%s\n" % (current_key[0], current_count, current_value))
+            num_lines += 1
+    return num_lines
+
+
+def merge_distributed_logs(logs_dir, remove_after_merge):
+    pattern = re.compile(r"^system_(\d+)_(.+)$")
+
+    # Find all per-system logs
+    per_log = {}
+    for filename in os.listdir(logs_dir):
+        match = pattern.match(filename)
+        if match is not None:
+            per_log.setdefault(match.group(2), []).append((int(match.group(1)), os.path.join(logs_dir, filename)))
+    if len(per_log) == 0:
+        print("No per-system logs found in: %s" % logs_dir)
+        return
+
+    # Merge each of them
+    for log_name in sorted(per_log.keys()):
+        in_filenames = [filename for system_id, filename in sorted(per_log[log_name])]
+        out_filename = os.path.join(logs_dir, log_name)
+        if log_name in SUMMABLE_LOGS:
+            num_lines = sum_sketch(in_filenames, out_filename)
+            print("Summed %d buckets of %d system(s) into: %s" % (num_lines, len(in_filenames), out_filename))
+            if remove_after_merge:
+                for in_filename in in_filenames:
+                    os.remove(in_filename)
+            continue
+        if log_name not in MERGEABLE_LOGS:
+            if log_name.endswith(".bin") or log_name.endswith(".col"):
+                print("Skipped %s (convert it to .csv first using convert_log_to_csv.py)" % log_name)
+            else:
+                print("Skipped %s (it is specific to each system)" % log_name)
+            continue
+        num_key_fields, num_header_lines = MERGEABLE_LOGS[log_name]
+        num_lines = merge_log(in_filenames, out_filename, num_key_fields, num_header_lines)
+        print("Merged %d lines of %d system(s) into: %s" % (num_lines, len(in_filenames), out_filename))
+        if remove_after_merge:
+            for in_filename in in_filenames:
+                os.remove(in_filename)
+
+
+def main():
+    args = sys.argv[1:]
+    remove_after_merge = "--remove" in args
+    args = [a for a in args if a != "--remove"]
+    if len(args) != 1:
+        print("Must supply exactly one argument")
+        print("Usage: python3 merge_distributed_logs.py [logs_ns3 directory] [--remove (optional, removes the "
+              "per-system logs after they have been merged)]")
+        exit(1)
+    else:
+        merge_distributed_logs(args[0], remove_after_merge)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+from merge_distributed_logs import merge_distributed_logs
+
+
+def write_file(filename, lines):
+    with open(filename, "w+") as f:
+        f.writelines(lines)
+
+
+def read_file(filename):
+    with open(filename, "r") as f:
+        return f.readlines()
+
+
+def incoming_csv_line(burst_id, to_node_id):
+    return "%d,0,%d,10.000000,0,1000000000,9.000000,8.000000,100,150000,140000,1000,2000,3000,4000,\n" \
+           % (burst_id, to_node_id)
+
+
+def incoming_txt_line(burst_id, to_node_id):
+    return "%-16d%-10d%-10d%s\n" % (burst_id, 0, to_node_id, "10.00 Mbit/s")
+
+
+class TestMergeDistributedLogs(unittest.TestCase):
+
+    def setUp(self):
+        self.logs_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.logs_dir)
+
+    def test_incoming_bursts_interleaved_endpoints(self):
+        # Each system has two receiving endpoints whose burst IDs interleave,
+        # and writes its incoming bursts in order of burst ID (as in a single-system run)
+        to_node_ids = {0: 4, 1: 6, 2: 5, 3: 7, 4: 4, 5: 6, 6: 5, 7: 7}
+        system_burst_ids = {0: [0, 2, 4, 6], 1: [1, 3, 5, 7]}  # System 0 has nodes 4 and 5, system 1 has 6 and 7
+        txt_header = "Burst ID        From      To        Target rate\n"
+        for system_id, burst_ids in system_burst_ids.items():
+            write_file(
+                os.path.join(self.logs_dir, "system_%d_udp_bursts_incoming.csv" % system_id),
+                [incoming_csv_line(i, to_node_ids[i]) for i in burst_ids]
+            )
+            write_file(
+                os.path.join(self.logs_dir, "system_%d_udp_bursts_incoming.txt" % system_id),
+                [txt_header] + [incoming_txt_line(i, to_node_ids[i]) for i in burst_ids]
+            )
+
+        merge_distributed_logs(self.logs_dir, True)
+
+        # Same as the single-system logs
+        self.assertEqual(
+            read_file(os.path.join(self.logs_dir, "udp_bursts_incoming.csv")),
+            [incoming_csv_line(i, to_node_ids[i]) for i in range(8)]
+        )
+        self.assertEqual(
+            read_file(os.path.join(self.logs_dir, "udp_bursts_incoming.txt")),
+            [txt_header] + [incoming_txt_line(i, to_node_ids[i]) for i in range(8)]
+        )
+        self.assertEqual(
+            sorted(os.listdir(self.logs_dir)),
+            ["udp_bursts_incoming.csv", "udp_bursts_incoming.txt"]
+        )
+
+    def test_unordered_input(self):
+        write_file(
+            os.path.join(self.logs_dir, "system_0_udp_bursts_incoming.csv"),
+            [incoming_csv_line(2, 5), incoming_csv_line(1, 4)]
+        )
+        with self.assertRaises(ValueError):
+            merge_distributed_logs(self.logs_dir, False)
+
+
+if __name__ == "__main__":
+    unittest.main()